@@ -167,6 +167,9 @@ endif()
 if(GT_ENABLE_PERFORMANCE_METERS)
     target_compile_definitions(GridToolsTest INTERFACE GT_ENABLE_METERS)
 endif(GT_ENABLE_PERFORMANCE_METERS)
+if(GT_ENABLE_PERF_COUNTERS)
+    target_compile_definitions(GridToolsTest INTERFACE GT_ENABLE_PERF_COUNTERS)
+endif(GT_ENABLE_PERF_COUNTERS)
 
 ## precision ##
 if(GT_SINGLE_PRECISION)
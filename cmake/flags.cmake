@@ -20,6 +20,9 @@ CMAKE_DEPENDENT_OPTION(
 CMAKE_DEPENDENT_OPTION(
     GT_ENABLE_PERFORMANCE_METERS "If on, meters will be reported for each stencil"
     OFF "BUILD_TESTING" OFF)
+CMAKE_DEPENDENT_OPTION(
+    GT_ENABLE_PERF_COUNTERS "If on, the meters of the CPU backends also report hardware counters (Linux perf_event_open)"
+    OFF "GT_ENABLE_PERFORMANCE_METERS" OFF)
 CMAKE_DEPENDENT_OPTION(
     GT_SINGLE_PRECISION "Option determining number of bytes used to represent the floating poit types (see defs.hpp for configuration)"
     OFF "BUILD_TESTING" OFF)
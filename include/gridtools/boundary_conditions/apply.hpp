@@ -9,13 +9,16 @@
  */
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
+
+#include "../common/array.hpp"
 #include "../common/defs.hpp"
 #include "../common/halo_descriptor.hpp"
+#include "../meta/type_traits.hpp"
+#include "../meta/utility.hpp"
 #include "direction.hpp"
 #include "predicate.hpp"
-#include <boost/preprocessor/arithmetic/inc.hpp>
-#include <boost/preprocessor/repetition/enum_params.hpp>
-#include <boost/preprocessor/repetition/repeat.hpp>
 
 /**
 @file
@@ -28,6 +31,49 @@ namespace gridtools {
      * @{
      */
 
+    namespace _impl {
+        /** \internal The direction with index Dir = (i + 1) * 9 + (j + 1) * 3 + k + 1 */
+        template <int Dir>
+        using direction_of = direction<static_cast<sign>(Dir / 9 - 1),
+            static_cast<sign>(Dir / 3 % 3 - 1),
+            static_cast<sign>(Dir % 3 - 1)>;
+
+        /** \internal A non-empty region of the halo where the boundary function is applied in direction dir */
+        struct boundary_region {
+            int dir;
+            array<int_t, 3> first;
+            array<int_t, 3> size;
+            std::ptrdiff_t points;
+        };
+
+        /** \internal The dimensions of the data fields from the one with stride 1 to the one with the largest
+            stride, i innermost when the layout is not known */
+        template <typename View, typename = void>
+        struct boundary_loop_order {
+            static array<int, 3> get() { return {0, 2, 1}; }
+        };
+
+        template <typename View>
+        struct boundary_loop_order<View, void_t<typename View::storage_info_t::layout_t>> {
+            static array<int, 3> get() {
+                using layout_t = typename View::storage_info_t::layout_t;
+                array<int, 3> res{0, 1, 2};
+                auto rank = [](int d) { return d < (int)layout_t::masked_length ? layout_t::at(d) : -1; };
+                std::stable_sort(res.begin(), res.end(), [&](int a, int b) { return rank(a) > rank(b); });
+                return res;
+            }
+        };
+    } // namespace _impl
+
+    /**
+       @brief Applies a boundary function to the halo regions of data fields in the directions selected by a
+       predicate.
+
+       The non-empty regions of all the directions are collected first, then they are all processed in a single
+       parallel region, the points being split evenly among the threads, so that the time scales with the volume of
+       the halos and not with the number of regions. Rows are traversed along the dimension with stride 1 of the
+       first data field.
+    */
     template <typename BoundaryFunction,
         typename Predicate = default_predicate,
         typename HaloDescriptors = array<halo_descriptor, 3u>>
@@ -37,24 +83,98 @@ namespace gridtools {
         BoundaryFunction const boundary_function;
         Predicate predicate;
 
-        /** @brief loops on the halo region defined by the HaloDescriptor member parameter, and evaluates the
-           boundary_function in the specified direction, in the specified halo node.
-            this macro expands to n definitions of the function loop, taking a number of arguments ranging from 0 to n
-           (DataField0, Datafield1, DataField2, ...)*/
+        template <int Dir>
+        void add_region(array<_impl::boundary_region, 26> &regions, int &n_regions, std::ptrdiff_t &points) const {
+            using direction_t = _impl::direction_of<Dir>;
+            if (!predicate(direction_t()))
+                return;
+            const sign signs[3] = {direction_t::i, direction_t::j, direction_t::k};
+            _impl::boundary_region region{Dir, {}, {}, 1};
+            for (int d = 0; d < 3; ++d) {
+                region.first[d] = halo_descriptors[d].loop_low_bound_outside(signs[d]);
+                region.size[d] =
+                    std::max<int_t>(0, halo_descriptors[d].loop_high_bound_outside(signs[d]) - region.first[d] + 1);
+                region.points *= region.size[d];
+            }
+            if (region.points == 0)
+                return;
+            regions[n_regions++] = region;
+            points += region.points;
+        }
+
+        template <std::size_t... Dirs>
+        int make_regions(array<_impl::boundary_region, 26> &regions,
+            std::ptrdiff_t &points,
+            meta::index_sequence<Dirs...>) const {
+            int n_regions = 0;
+            using execute_in_order = int[];
+            // 13 is the direction <zero_, zero_, zero_>, which is not a boundary
+            (void)execute_in_order{(Dirs == 13 ? 0 : (add_region<Dirs>(regions, n_regions, points), 0))...};
+            return n_regions;
+        }
+
+        /** @brief evaluates the boundary_function in the specified direction on length points starting from first
+            along dimension dim */
         template <typename Direction, typename... DataField>
-        void loop(DataField &... data_field) const {
-            const int_t i_low = halo_descriptors[0].loop_low_bound_outside(Direction::i);
-            const int_t i_high = halo_descriptors[0].loop_high_bound_outside(Direction::i);
-            const int_t j_low = halo_descriptors[1].loop_low_bound_outside(Direction::j);
-            const int_t j_high = halo_descriptors[1].loop_high_bound_outside(Direction::j);
-            const int_t k_low = halo_descriptors[2].loop_low_bound_outside(Direction::k);
-            const int_t k_high = halo_descriptors[2].loop_high_bound_outside(Direction::k);
-
-#pragma omp parallel for simd collapse(3)
-            for (int_t j = j_low; j <= j_high; ++j)
-                for (int_t k = k_low; k <= k_high; ++k)
-                    for (int_t i = i_low; i <= i_high; ++i)
-                        boundary_function(Direction(), data_field..., i, j, k);
+        void row(array<int_t, 3> const &first, int dim, int_t length, DataField const &... data_field) const {
+            const int_t i = first[0];
+            const int_t j = first[1];
+            const int_t k = first[2];
+            if (dim == 0) {
+#pragma omp simd
+                for (int_t l = 0; l < length; ++l)
+                    boundary_function(Direction(), data_field..., i + l, j, k);
+            } else if (dim == 1) {
+#pragma omp simd
+                for (int_t l = 0; l < length; ++l)
+                    boundary_function(Direction(), data_field..., i, j + l, k);
+            } else {
+#pragma omp simd
+                for (int_t l = 0; l < length; ++l)
+                    boundary_function(Direction(), data_field..., i, j, k + l);
+            }
+        }
+
+        template <std::size_t... Dirs, typename... DataField>
+        void row(int dir,
+            array<int_t, 3> const &first,
+            int dim,
+            int_t length,
+            meta::index_sequence<Dirs...>,
+            DataField const &... data_field) const {
+            using row_t = void (boundary_apply::*)(array<int_t, 3> const &, int, int_t, DataField const &...) const;
+            // the entry of the direction <zero_, zero_, zero_> is never used
+            static const row_t rows[] = {
+                &boundary_apply::template row<_impl::direction_of<Dirs == 13 ? 0 : Dirs>, DataField...>...};
+            (this->*rows[dir])(first, dim, length, data_field...);
+        }
+
+        /** @brief processes the points from begin to end of the concatenation of the regions */
+        template <typename... DataField>
+        void loop(array<_impl::boundary_region, 26> const &regions,
+            int n_regions,
+            array<int, 3> const &order,
+            std::ptrdiff_t begin,
+            std::ptrdiff_t end,
+            DataField const &... data_field) const {
+            std::ptrdiff_t offset = 0;
+            for (int r = 0; r < n_regions && offset < end; offset += regions[r].points, ++r) {
+                _impl::boundary_region const &region = regions[r];
+                if (offset + region.points <= begin)
+                    continue;
+                const int_t n0 = region.size[order[0]];
+                const int_t n1 = region.size[order[1]];
+                const std::ptrdiff_t last = std::min(end, offset + region.points) - offset;
+                for (std::ptrdiff_t p = std::max(begin, offset) - offset; p < last;) {
+                    const int_t length = std::min<std::ptrdiff_t>(n0 - p % n0, last - p);
+                    array<int_t, 3> first;
+                    first[order[0]] = region.first[order[0]] + p % n0;
+                    first[order[1]] = region.first[order[1]] + p / n0 % n1;
+                    first[order[2]] = region.first[order[2]] + p / n0 / n1;
+                    row(region.dir, first, order[0], length, meta::make_index_sequence<27>(), data_field...);
+                    p += length;
+                }
+            }
         }
 
       public:
@@ -66,76 +186,29 @@ namespace gridtools {
 
         /**
            @brief applies the boundary conditions looping on the halo region defined by the member parameter, in all
-        possible directions.
-        this macro expands to n definitions of the function apply, taking a number of arguments ranging from 0 to n
-        (DataField0, Datafield1, DataField2, ...)
-
+           the directions for which the predicate is true.
         */
-        template <typename... DataFieldViews>
-        void apply(DataFieldViews const &... data_field_views) const {
-
-            if (predicate(direction<minus_, minus_, minus_>()))
-                this->loop<direction<minus_, minus_, minus_>>(data_field_views...);
-            if (predicate(direction<minus_, minus_, zero_>()))
-                this->loop<direction<minus_, minus_, zero_>>(data_field_views...);
-            if (predicate(direction<minus_, minus_, plus_>()))
-                this->loop<direction<minus_, minus_, plus_>>(data_field_views...);
-
-            if (predicate(direction<minus_, zero_, minus_>()))
-                this->loop<direction<minus_, zero_, minus_>>(data_field_views...);
-            if (predicate(direction<minus_, zero_, zero_>()))
-                this->loop<direction<minus_, zero_, zero_>>(data_field_views...);
-            if (predicate(direction<minus_, zero_, plus_>()))
-                this->loop<direction<minus_, zero_, plus_>>(data_field_views...);
-
-            if (predicate(direction<minus_, plus_, minus_>()))
-                this->loop<direction<minus_, plus_, minus_>>(data_field_views...);
-            if (predicate(direction<minus_, plus_, zero_>()))
-                this->loop<direction<minus_, plus_, zero_>>(data_field_views...);
-            if (predicate(direction<minus_, plus_, plus_>()))
-                this->loop<direction<minus_, plus_, plus_>>(data_field_views...);
-
-            if (predicate(direction<zero_, minus_, minus_>()))
-                this->loop<direction<zero_, minus_, minus_>>(data_field_views...);
-            if (predicate(direction<zero_, minus_, zero_>()))
-                this->loop<direction<zero_, minus_, zero_>>(data_field_views...);
-            if (predicate(direction<zero_, minus_, plus_>()))
-                this->loop<direction<zero_, minus_, plus_>>(data_field_views...);
-
-            if (predicate(direction<zero_, zero_, minus_>()))
-                this->loop<direction<zero_, zero_, minus_>>(data_field_views...);
-            if (predicate(direction<zero_, zero_, plus_>()))
-                this->loop<direction<zero_, zero_, plus_>>(data_field_views...);
-
-            if (predicate(direction<zero_, plus_, minus_>()))
-                this->loop<direction<zero_, plus_, minus_>>(data_field_views...);
-            if (predicate(direction<zero_, plus_, zero_>()))
-                this->loop<direction<zero_, plus_, zero_>>(data_field_views...);
-            if (predicate(direction<zero_, plus_, plus_>()))
-                this->loop<direction<zero_, plus_, plus_>>(data_field_views...);
-
-            if (predicate(direction<plus_, minus_, minus_>()))
-                this->loop<direction<plus_, minus_, minus_>>(data_field_views...);
-            if (predicate(direction<plus_, minus_, zero_>()))
-                this->loop<direction<plus_, minus_, zero_>>(data_field_views...);
-            if (predicate(direction<plus_, minus_, plus_>()))
-                this->loop<direction<plus_, minus_, plus_>>(data_field_views...);
-
-            if (predicate(direction<plus_, zero_, minus_>()))
-                this->loop<direction<plus_, zero_, minus_>>(data_field_views...);
-            if (predicate(direction<plus_, zero_, zero_>()))
-                this->loop<direction<plus_, zero_, zero_>>(data_field_views...);
-            if (predicate(direction<plus_, zero_, plus_>()))
-                this->loop<direction<plus_, zero_, plus_>>(data_field_views...);
-
-            if (predicate(direction<plus_, plus_, minus_>()))
-                this->loop<direction<plus_, plus_, minus_>>(data_field_views...);
-            if (predicate(direction<plus_, plus_, zero_>()))
-                this->loop<direction<plus_, plus_, zero_>>(data_field_views...);
-            if (predicate(direction<plus_, plus_, plus_>()))
-                this->loop<direction<plus_, plus_, plus_>>(data_field_views...);
-
-            // apply(data_field_views ...);
+        template <typename DataFieldView, typename... DataFieldViews>
+        void apply(DataFieldView const &data_field_view, DataFieldViews const &... data_field_views) const {
+            array<_impl::boundary_region, 26> regions;
+            std::ptrdiff_t points = 0;
+            const int n_regions = make_regions(regions, points, meta::make_index_sequence<27>());
+            if (points == 0)
+                return;
+            const array<int, 3> order = _impl::boundary_loop_order<DataFieldView>::get();
+
+#pragma omp parallel
+            {
+                const std::ptrdiff_t threads = omp_get_num_threads();
+                const std::ptrdiff_t thread = omp_get_thread_num();
+                loop(regions,
+                    n_regions,
+                    order,
+                    points * thread / threads,
+                    points * (thread + 1) / threads,
+                    data_field_view,
+                    data_field_views...);
+            }
         }
 
       private:
@@ -94,6 +94,8 @@ namespace gridtools {
     typedef int omp_int_t;
     inline omp_int_t omp_get_thread_num() { return 0; }
     inline omp_int_t omp_get_max_threads() { return 1; }
+    inline omp_int_t omp_get_num_threads() { return 1; }
+    inline omp_int_t omp_in_parallel() { return 0; }
     inline double omp_get_wtime() { return 0; }
 } // namespace gridtools
 #endif
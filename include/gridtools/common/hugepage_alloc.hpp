@@ -11,29 +11,122 @@
 #pragma once
 
 #include <atomic>
+#include <cstdint>
 #include <cstdlib>
+#include <map>
+#include <mutex>
 #include <new>
 
+#include <sys/mman.h>
+
 namespace gridtools {
+    namespace hugepage_alloc_impl_ {
+        constexpr std::size_t hugepage_size = 2 * 1024 * 1024;
+
+        /**
+         * @brief Returns the shift of the next allocation, cycling through 64, 128, ..., 4096 bytes, such that
+         * consecutive allocations get different last 12 bits.
+         */
+        inline std::size_t next_offset() {
+            static std::atomic<std::size_t> s_offset(64);
+            auto offset = s_offset.load(std::memory_order_relaxed);
+            while (!s_offset.compare_exchange_weak(
+                offset, 2 * offset <= 4096 ? 2 * offset : 64, std::memory_order_relaxed)) {
+            }
+            return offset;
+        }
+
+        struct mapping {
+            void *ptr;
+            std::size_t size;
+            bool hugetlbfs; // mapped from hugetlbfs instead of being allocated with transparent huge pages
+        };
+
+        /**
+         * @brief The memory mapped by map, by address, for hugepage_usage_report. Mappings are only recorded once the
+         * report is enabled, such that mapping and unmapping memory doesn't synchronize otherwise. It is never
+         * destroyed, such that memory can be unmapped during static destruction.
+         */
+        struct registry {
+            std::atomic<bool> enabled{false};
+            std::mutex mutex;
+            std::map<std::uintptr_t, mapping> mappings;
+
+            static registry &get() {
+                static registry *instance = new registry();
+                return *instance;
+            }
+        };
+
+        /**
+         * @brief Maps at least size bytes aligned to 2MB pages.
+         *
+         * If GT_HUGETLBFS is defined, the memory is mapped from the hugetlbfs pool (MAP_HUGETLB), falling back to the
+         * following if no pages are left there. Otherwise, the memory is advised to be backed by transparent huge
+         * pages (MADV_HUGEPAGE), which is required when they are enabled in madvise mode only. Neither is done if
+         * GT_NO_HUGETLB is defined.
+         */
+        inline mapping map(std::size_t size) {
+            void *ptr = nullptr;
+            bool hugetlbfs = false;
+#if defined(GT_HUGETLBFS) && !defined(GT_NO_HUGETLB) && defined(MAP_HUGETLB)
+            int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB;
+#ifdef MAP_HUGE_2MB
+            flags |= MAP_HUGE_2MB;
+#endif
+            std::size_t mapped_size = (size + hugepage_size - 1) / hugepage_size * hugepage_size;
+            ptr = mmap(nullptr, mapped_size, PROT_READ | PROT_WRITE, flags, -1, 0);
+            if (ptr == MAP_FAILED) {
+                ptr = nullptr;
+            } else {
+                size = mapped_size;
+                hugetlbfs = true;
+            }
+#endif
+            if (!ptr) {
+                if (posix_memalign(&ptr, hugepage_size, size))
+                    throw std::bad_alloc();
+#if !defined(GT_NO_HUGETLB) && defined(MADV_HUGEPAGE)
+                // a failure only means that the memory is backed by normal pages
+                madvise(ptr, size, MADV_HUGEPAGE);
+#endif
+            }
+            mapping res = {ptr, size, hugetlbfs};
+            auto &r = registry::get();
+            if (r.enabled.load(std::memory_order_relaxed)) {
+                std::lock_guard<std::mutex> lock(r.mutex);
+                r.mappings[reinterpret_cast<std::uintptr_t>(ptr)] = res;
+            }
+            return res;
+        }
+
+        /**
+         * @brief Unmaps memory mapped by map.
+         */
+        inline void unmap(mapping const &m) {
+            auto &r = registry::get();
+            if (r.enabled.load(std::memory_order_relaxed)) {
+                std::lock_guard<std::mutex> lock(r.mutex);
+                r.mappings.erase(reinterpret_cast<std::uintptr_t>(m.ptr));
+            }
+            if (m.hugetlbfs)
+                munmap(m.ptr, m.size);
+            else
+                free(m.ptr);
+        }
+    } // namespace hugepage_alloc_impl_
 
     /**
-     * @brief Allocates huge page memory (if GT_NO_HUGETLB is not defined) and shifts allocations by some bytes to
-     * reduce cache set conflicts.
+     * @brief Allocates huge page memory (see hugepage_alloc_impl_::map) and shifts allocations by some bytes to
+     * reduce cache set conflicts. The mapping is kept in front of the returned pointer.
      */
     inline void *hugepage_alloc(std::size_t size) {
-        static std::atomic<std::size_t> s_offset(64);
-        auto offset = s_offset.load(std::memory_order_relaxed);
-        auto next_offset = offset;
-        while (!s_offset.compare_exchange_weak(
-            next_offset, 2 * next_offset <= 4096 ? 2 * next_offset : 64, std::memory_order_relaxed)) {
-        }
+        auto offset = hugepage_alloc_impl_::next_offset();
 
-        void *ptr;
-        if (posix_memalign(&ptr, 2 * 1024 * 1024, size + offset))
-            throw std::bad_alloc();
+        auto mapping = hugepage_alloc_impl_::map(size + offset);
 
-        ptr = static_cast<char *>(ptr) + offset;
-        static_cast<std::size_t *>(ptr)[-1] = offset;
+        void *ptr = static_cast<char *>(mapping.ptr) + offset;
+        static_cast<hugepage_alloc_impl_::mapping *>(ptr)[-1] = mapping;
         return ptr;
     }
 
@@ -41,11 +134,8 @@ namespace gridtools {
      * @brief Frees memory allocated by hugepage_alloc.
      */
     inline void hugepage_free(void *ptr) {
-        if (!ptr)
-            return;
-        std::size_t offset = static_cast<std::size_t *>(ptr)[-1];
-        ptr = static_cast<char *>(ptr) - offset;
-        free(ptr);
+        if (ptr)
+            hugepage_alloc_impl_::unmap(static_cast<hugepage_alloc_impl_::mapping *>(ptr)[-1]);
     }
 
 } // namespace gridtools
@@ -0,0 +1,220 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <new>
+#include <vector>
+
+#include "hugepage_alloc.hpp"
+
+namespace gridtools {
+
+    /**
+     * @brief Memory statistics of a hugepage_arena.
+     */
+    struct hugepage_arena_stats {
+        std::size_t requested;      // bytes requested by the live allocations
+        std::size_t reserved;       // bytes of the slabs held by the arena
+        std::size_t hugepage_bytes; // bytes of the slabs that lie within whole, aligned huge pages
+        std::size_t slabs;          // number of slabs held by the arena
+
+        /**
+         * @brief Fraction of the reserved memory that can be backed by huge pages.
+         */
+        double hugepage_coverage() const { return reserved ? double(hugepage_bytes) / reserved : 1.; }
+    };
+
+    /**
+     * @brief Arena that carves many allocations out of shared slabs, aligned to 2MB pages and backed by huge pages if
+     * possible (see hugepage_alloc_impl_::map).
+     *
+     * Like hugepage_alloc, every allocation is shifted by an offset cycling through 64, 128, ..., 4096 bytes to
+     * reduce cache set conflicts, but the allocations share the huge pages of a slab instead of each starting on its
+     * own. Every slab keeps a list of its free ranges, merged with their neighbors on free, from which new
+     * allocations are taken first fit, such that space freed by short-lived allocations is reused while long-lived
+     * ones remain. Allocations larger than half a slab get a dedicated mapping of their own size. A slab is released
+     * as soon as all allocations carved from it are freed. Space reused within a slab keeps its pages, which are thus
+     * placed on the NUMA node that touched them first; mc_storage therefore uses the arena for small storages only.
+     * The arena must outlive its allocations. Allocating and freeing is thread safe.
+     */
+    class hugepage_arena {
+      public:
+        static constexpr std::size_t hugepage_size = hugepage_alloc_impl_::hugepage_size;
+
+      private:
+        // header at the beginning of every slab
+        struct slab {
+            hugepage_arena *arena;
+            hugepage_alloc_impl_::mapping mapping;   // the memory of the slab
+            std::size_t size;                        // bytes of the slab, including this header
+            std::size_t live;                        // number of live allocations carved from the slab
+            bool shared;                             // false for the slabs dedicated to a single allocation
+            std::map<std::size_t, std::size_t> free; // free ranges [first, last) of a shared slab, by first
+        };
+
+        // header in front of every allocation
+        struct allocation_header {
+            slab *owner;
+            std::size_t first; // beginning of the range of the slab taken by the allocation
+            std::size_t size;
+        };
+
+        std::size_t m_slab_size;
+        std::vector<slab *> m_slabs; // the shared slabs
+        hugepage_arena_stats m_stats = {};
+        mutable std::mutex m_mutex;
+
+        /**
+         * @brief Position of an allocation in a free range starting at `first`, such that the position is
+         * `offset` modulo 4096 and leaves space for the allocation header.
+         */
+        static std::size_t place(std::size_t first, std::size_t offset) {
+            constexpr std::size_t page = 4096;
+            first += sizeof(allocation_header);
+            return first <= offset ? offset : offset + (first - offset + page - 1) / page * page;
+        }
+
+        slab *new_slab(std::size_t size, bool shared) {
+            auto mapping = hugepage_alloc_impl_::map(size);
+            m_stats.reserved += size;
+            m_stats.hugepage_bytes += size / hugepage_size * hugepage_size;
+            ++m_stats.slabs;
+            slab *s = new (mapping.ptr) slab{this, mapping, size, 0, shared, {}};
+            if (shared) {
+                s->free.emplace(sizeof(slab), size);
+                m_slabs.push_back(s);
+            }
+            return s;
+        }
+
+        void release_slab(slab *s) {
+            m_stats.reserved -= s->size;
+            m_stats.hugepage_bytes -= s->size / hugepage_size * hugepage_size;
+            --m_stats.slabs;
+            if (s->shared)
+                m_slabs.erase(std::find(m_slabs.begin(), m_slabs.end(), s));
+            auto mapping = s->mapping;
+            s->~slab();
+            hugepage_alloc_impl_::unmap(mapping);
+        }
+
+        // takes [first, position + size) from the free range starting at first, if any
+        void *carve(slab *s, std::size_t first, std::size_t position, std::size_t size) {
+            auto range = s->free.find(first);
+            if (range != s->free.end()) {
+                std::size_t last = range->second;
+                s->free.erase(range);
+                if (position + size < last)
+                    s->free.emplace(position + size, last);
+            }
+            char *ptr = reinterpret_cast<char *>(s) + position;
+            reinterpret_cast<allocation_header *>(ptr)[-1] = {s, first, size};
+            ++s->live;
+            m_stats.requested += size;
+            return ptr;
+        }
+
+        void deallocate(void *ptr) {
+            auto const &header = static_cast<allocation_header *>(ptr)[-1];
+            slab *s = header.owner;
+            std::size_t first = header.first;
+            std::size_t last = static_cast<char *>(ptr) - reinterpret_cast<char *>(s) + header.size;
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stats.requested -= header.size;
+            if (!--s->live) {
+                release_slab(s);
+                return;
+            }
+            // give the range back, merged with the adjacent free ranges
+            auto next = s->free.lower_bound(first);
+            if (next != s->free.end() && next->first == last) {
+                last = next->second;
+                next = s->free.erase(next);
+            }
+            if (next != s->free.begin() && std::prev(next)->second == first) {
+                std::prev(next)->second = last;
+                return;
+            }
+            s->free.emplace_hint(next, first, last);
+        }
+
+      public:
+        /**
+         * @param slab_size Size of the shared slabs in bytes, rounded up to a multiple of the huge page size.
+         */
+        explicit hugepage_arena(std::size_t slab_size = 16 * hugepage_size)
+            : m_slab_size((slab_size + hugepage_size - 1) / hugepage_size * hugepage_size) {}
+
+        hugepage_arena(hugepage_arena const &) = delete;
+        hugepage_arena &operator=(hugepage_arena const &) = delete;
+
+        ~hugepage_arena() { assert(m_stats.slabs == 0); }
+
+        /**
+         * @brief Allocates size bytes, aligned to 64 bytes.
+         */
+        void *allocate(std::size_t size) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto offset = hugepage_alloc_impl_::next_offset();
+            if (size > m_slab_size / 2) {
+                auto position = place(sizeof(slab), offset);
+                return carve(new_slab(position + size, false), sizeof(slab), position, size);
+            }
+            for (slab *s : m_slabs)
+                for (auto const &range : s->free) {
+                    auto position = place(range.first, offset);
+                    if (position + size <= range.second)
+                        return carve(s, range.first, position, size);
+                }
+            return carve(new_slab(m_slab_size, true), sizeof(slab), place(sizeof(slab), offset), size);
+        }
+
+        /**
+         * @brief Frees memory allocated by any hugepage_arena.
+         */
+        static void free(void *ptr) {
+            if (ptr)
+                static_cast<allocation_header *>(ptr)[-1].owner->arena->deallocate(ptr);
+        }
+
+        hugepage_arena_stats stats() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_stats;
+        }
+    };
+
+    /**
+     * @brief The arena shared by the host storages. It is never destroyed, such that storages with static lifetime
+     * can be freed at any time.
+     */
+    inline hugepage_arena &default_hugepage_arena() {
+        static hugepage_arena *arena = new hugepage_arena();
+        return *arena;
+    }
+
+    /**
+     * @brief Allocates memory from the default_hugepage_arena.
+     */
+    inline void *hugepage_arena_alloc(std::size_t size) { return default_hugepage_arena().allocate(size); }
+
+    /**
+     * @brief Frees memory allocated by hugepage_arena_alloc.
+     */
+    inline void hugepage_arena_free(void *ptr) { hugepage_arena::free(ptr); }
+
+} // namespace gridtools
@@ -0,0 +1,146 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include "hugepage_alloc.hpp"
+
+namespace gridtools {
+
+    /**
+     * @brief Huge page usage of a memory range mapped by hugepage_alloc or a hugepage_arena slab.
+     */
+    struct hugepage_usage {
+        std::uintptr_t address;
+        std::size_t size;
+        bool hugetlbfs;         // mapped from the hugetlbfs pool, see GT_HUGETLBFS
+        std::size_t huge_bytes; // bytes backed by huge pages, transparent or from hugetlbfs
+        bool estimated;         // huge_bytes is estimated, see hugepage_usage_report
+
+        double coverage() const { return size ? double(huge_bytes) / size : 1.; }
+    };
+
+    namespace hugepage_report_impl_ {
+        struct vma {
+            std::uintptr_t begin;
+            std::uintptr_t end;
+            std::size_t huge_bytes;
+        };
+
+        /**
+         * @brief The virtual memory areas of the process with the bytes backed by huge pages, from /proc/self/smaps.
+         */
+        inline std::vector<vma> read_smaps() {
+            std::vector<vma> vmas;
+            std::ifstream smaps("/proc/self/smaps");
+            std::string line;
+            while (std::getline(smaps, line)) {
+                unsigned long begin, end, kb;
+                char key[64];
+                if (std::sscanf(line.c_str(), "%lx-%lx", &begin, &end) == 2)
+                    vmas.push_back({begin, end, 0});
+                else if (!vmas.empty() && std::sscanf(line.c_str(), "%63s %lu kB", key, &kb) == 2) {
+                    std::string k = key;
+                    if (k == "AnonHugePages:" || k == "Private_Hugetlb:" || k == "Shared_Hugetlb:")
+                        vmas.back().huge_bytes += kb * 1024;
+                }
+            }
+            return vmas;
+        }
+
+        /**
+         * @brief The end of the range rounded up to the page size, as the kernel rounds the areas split by madvise.
+         */
+        inline std::uintptr_t page_end(hugepage_usage const &usage) {
+            static const std::uintptr_t page_size = sysconf(_SC_PAGESIZE);
+            return (usage.address + usage.size + page_size - 1) / page_size * page_size;
+        }
+    } // namespace hugepage_report_impl_
+
+    /**
+     * @brief Starts recording the memory mapped by gridtools for hugepage_usage_report. Memory mapped before is not
+     * reported; enable the report at the beginning of the program to see all of it.
+     */
+    inline void enable_hugepage_report() {
+        hugepage_alloc_impl_::registry::get().enabled.store(true, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Reports how much of every memory range mapped by gridtools since enable_hugepage_report (see
+     * hugepage_alloc_impl_::map) is backed by huge pages, according to /proc/self/smaps.
+     *
+     * The kernel reports the usage per virtual memory area only. The huge pages of an area lying within a single
+     * range, rounded up to whole pages like the areas split by madvise, are attributed to it exactly. Neighboring
+     * mappings with the same attributes are merged into one area by the kernel though; the huge pages of such an area
+     * are attributed proportionally to the overlap with every range, which is only an estimate, and the ranges are
+     * marked as estimated. The usage is zero where /proc/self/smaps is not available.
+     */
+    inline std::vector<hugepage_usage> hugepage_usage_report() {
+        std::vector<hugepage_usage> res;
+        {
+            auto &r = hugepage_alloc_impl_::registry::get();
+            std::lock_guard<std::mutex> lock(r.mutex);
+            for (auto const &m : r.mappings)
+                res.push_back({m.first, m.second.size, m.second.hugetlbfs, 0, false});
+        }
+        for (auto const &area : hugepage_report_impl_::read_smaps()) {
+            if (!area.huge_bytes)
+                continue;
+            for (auto &usage : res) {
+                auto begin = std::max(usage.address, area.begin);
+                auto end = std::min(hugepage_report_impl_::page_end(usage), area.end);
+                if (begin >= end)
+                    continue;
+                if (begin == area.begin && end == area.end) {
+                    usage.huge_bytes += area.huge_bytes;
+                } else {
+                    usage.huge_bytes +=
+                        static_cast<std::size_t>(double(area.huge_bytes) * (end - begin) / (area.end - area.begin));
+                    usage.estimated = true;
+                }
+            }
+        }
+        for (auto &usage : res)
+            usage.huge_bytes = std::min(usage.huge_bytes, usage.size);
+        return res;
+    }
+
+    /**
+     * @brief Prints the huge page usage of the memory mapped by gridtools (see hugepage_usage_report), to verify
+     * that a deployment gets huge pages. Estimated usages are marked with a "~".
+     */
+    inline void print_hugepage_report(std::ostream &out) {
+        constexpr double mb = 1024 * 1024;
+        auto report = hugepage_usage_report();
+        std::size_t size = 0, huge_bytes = 0;
+        for (auto const &usage : report) {
+            size += usage.size;
+            huge_bytes += usage.huge_bytes;
+        }
+        out << "gridtools huge pages: " << report.size() << " mappings, " << size / mb << " MB, " << huge_bytes / mb
+            << " MB backed by huge pages (" << (size ? 100. * huge_bytes / size : 100.) << "%)\n";
+        for (auto const &usage : report)
+            out << "  0x" << std::hex << usage.address << std::dec << ": " << usage.size / mb << " MB, "
+                << (usage.estimated ? "~" : "") << 100 * usage.coverage() << "% "
+                << (usage.hugetlbfs ? "hugetlbfs" : "transparent huge pages") << "\n";
+    }
+
+} // namespace gridtools
@@ -0,0 +1,259 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "../defs.hpp"
+#include "timer.hpp"
+
+namespace gridtools {
+    namespace timer_perf_impl_ {
+        enum counter { cycles, instructions, llc_misses, num_counters };
+
+        /// bytes transferred from memory per last level cache miss
+        constexpr std::uint64_t cache_line_size = 64;
+
+        class counter_group;
+
+        /**
+         * The counter groups alive, such that the groups of threads that exited are not read anymore. It is never
+         * destroyed, as thread local groups may be destroyed after the static objects.
+         */
+        struct live_groups {
+            std::mutex mutex;
+            std::set<counter_group const *> groups;
+
+            static live_groups &get() {
+                static live_groups *instance = new live_groups();
+                return *instance;
+            }
+        };
+
+        /**
+         * Hardware counters of the calling thread, read as one group.
+         */
+        class counter_group {
+            int m_fds[num_counters];
+            bool m_available = false;
+
+#ifdef __linux__
+            static int open_counter(std::uint64_t config, int group_fd) {
+                perf_event_attr attr;
+                std::memset(&attr, 0, sizeof(attr));
+                attr.type = PERF_TYPE_HARDWARE;
+                attr.size = sizeof(attr);
+                attr.config = config;
+                attr.disabled = group_fd == -1;
+                attr.exclude_kernel = 1;
+                attr.exclude_hv = 1;
+                attr.read_format = PERF_FORMAT_GROUP;
+                return syscall(__NR_perf_event_open, &attr, 0, -1, group_fd, 0);
+            }
+#endif
+
+          public:
+            counter_group() {
+                for (auto &fd : m_fds)
+                    fd = -1;
+                {
+                    auto &live = live_groups::get();
+                    std::lock_guard<std::mutex> lock(live.mutex);
+                    live.groups.insert(this);
+                }
+#ifdef __linux__
+                static constexpr std::uint64_t configs[num_counters] = {
+                    PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES};
+                for (int i = 0; i != num_counters; ++i) {
+                    m_fds[i] = open_counter(configs[i], m_fds[0]);
+                    if (m_fds[i] == -1)
+                        return;
+                }
+                m_available = ioctl(m_fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP) == 0;
+#endif
+            }
+
+            counter_group(counter_group const &) = delete;
+            counter_group &operator=(counter_group const &) = delete;
+
+            ~counter_group() {
+                {
+                    auto &live = live_groups::get();
+                    std::lock_guard<std::mutex> lock(live.mutex);
+                    live.groups.erase(this);
+                }
+#ifdef __linux__
+                for (auto fd : m_fds)
+                    if (fd != -1)
+                        close(fd);
+#endif
+            }
+
+            bool available() const { return m_available; }
+
+            /// adds the current counter values multiplied by sign to dst
+            void accumulate(std::int64_t sign, std::int64_t *dst) const {
+#ifdef __linux__
+                if (!m_available)
+                    return;
+                std::uint64_t values[num_counters + 1];
+                if (read(m_fds[0], values, sizeof(values)) != sizeof(values))
+                    return;
+                for (int i = 0; i != num_counters; ++i)
+                    dst[i] += sign * static_cast<std::int64_t>(values[i + 1]);
+#endif
+            }
+        };
+
+        /// the counters of the calling thread, opened on first use and shared by all timers
+        inline counter_group &thread_group() {
+            static thread_local counter_group res;
+            return res;
+        }
+
+        /**
+         * The counters of the threads of the OpenMP team of the calling thread, indexed by thread number. Every
+         * calling thread keeps the groups of its own team. The first call (and the first one after the number of
+         * threads has grown or a thread of the team has exited) opens them with a parallel region, thus it must not
+         * be made from within one.
+         */
+        inline std::vector<counter_group const *> const &team_groups() {
+            static thread_local std::vector<counter_group const *> res;
+            bool stale = res.size() < static_cast<std::size_t>(omp_get_max_threads());
+            if (!stale) {
+                auto &live = live_groups::get();
+                std::lock_guard<std::mutex> lock(live.mutex);
+                for (counter_group const *group : res)
+                    stale = stale || !live.groups.count(group);
+            }
+            if (stale) {
+                // the team threads must not refer to their own thread local vector
+                auto &groups = res;
+                groups.assign(omp_get_max_threads(), nullptr);
+#pragma omp parallel
+                groups[omp_get_thread_num()] = &thread_group();
+            }
+            return res;
+        }
+
+        /**
+         * Adds the counters of the team of the calling thread multiplied by sign to dst.
+         * @return false if the counters of a thread are not available
+         */
+        inline bool accumulate_team(std::int64_t sign, std::int64_t *dst) {
+            auto const &groups = team_groups();
+            auto &live = live_groups::get();
+            std::lock_guard<std::mutex> lock(live.mutex);
+            bool res = true;
+            for (counter_group const *group : groups) {
+                if (!live.groups.count(group) || !group->available()) {
+                    res = false;
+                    continue;
+                }
+                group->accumulate(sign, dst);
+            }
+            return res;
+        }
+    } // namespace timer_perf_impl_
+
+    /**
+     * @class timer_perf
+     * Measures the wall time and the hardware counters (cycles, instructions, last level cache misses) between start
+     * and pause calls, using the Linux perf_event_open interface. Called from sequential code, it measures all threads
+     * of the OpenMP team of the calling thread; called from within a parallel region (e.g. by per thread meters), it measures the calling
+     * thread only. Every thread opens its counters once, the first time it is measured, and start and pause only read
+     * them, without entering a parallel region.
+     *
+     * If the counters are not available (e.g. non-Linux systems or containers without the required permissions, see
+     * /proc/sys/kernel/perf_event_paranoid), only the wall time is measured.
+     */
+    class timer_perf : public timer<timer_perf> // CRTP
+    {
+        using counter_group = timer_perf_impl_::counter_group;
+
+        std::int64_t m_counters[timer_perf_impl_::num_counters] = {};
+        double m_start_time = 0;
+        bool m_available = true;
+
+        void accumulate(std::int64_t sign) {
+            if (omp_in_parallel()) {
+                counter_group const &group = timer_perf_impl_::thread_group();
+                if (!group.available())
+                    m_available = false;
+                group.accumulate(sign, m_counters);
+                return;
+            }
+            if (!timer_perf_impl_::accumulate_team(sign, m_counters))
+                m_available = false;
+        }
+
+      public:
+        timer_perf(std::string name) : timer<timer_perf>(name) {
+            // opens the counters of the team up front, unless the timer is created by a thread of it
+            if (!omp_in_parallel())
+                timer_perf_impl_::team_groups();
+        }
+
+        void set_impl(double const &time) { m_start_time = time; }
+
+        void start_impl() {
+            accumulate(-1);
+            m_start_time = omp_get_wtime();
+        }
+
+        double pause_impl() {
+            double time = omp_get_wtime() - m_start_time;
+            accumulate(1);
+            return time;
+        }
+
+        void reset() {
+            timer<timer_perf>::reset();
+            for (auto &counter : m_counters)
+                counter = 0;
+        }
+
+        /**
+         * @return true if the hardware counters could be read on all threads in all measurements
+         */
+        bool counters_available() const { return m_available; }
+
+        std::int64_t cycles() const { return m_counters[timer_perf_impl_::cycles]; }
+        std::int64_t instructions() const { return m_counters[timer_perf_impl_::instructions]; }
+        std::int64_t llc_misses() const { return m_counters[timer_perf_impl_::llc_misses]; }
+
+        /**
+         * @return estimated bytes transferred from memory: one cache line per last level cache miss
+         */
+        std::int64_t memory_bytes() const { return llc_misses() * timer_perf_impl_::cache_line_size; }
+
+        std::string to_string() const {
+            std::ostringstream out;
+            out << timer<timer_perf>::to_string();
+            if (m_available && count() != 0)
+                out << "\tcycles: " << cycles() << "\tinstructions: " << instructions()
+                    << "\tLLC misses: " << llc_misses() << "\tmemory [GB]: " << 1e-9 * memory_bytes();
+            return out.str();
+        }
+    };
+} // namespace gridtools
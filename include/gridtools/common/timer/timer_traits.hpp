@@ -11,14 +11,22 @@
 
 #include "../defs.hpp"
 
-#ifndef GT_ENABLE_METERS
+// the stage meters (see stage_meters.hpp) are useless with dummy timers
+#if defined(GT_ENABLE_STAGE_METERS) && !defined(GT_ENABLE_METERS)
+#define GT_ENABLE_METERS
+#endif
+
 #include "timer_dummy.hpp"
-#else
+#ifdef GT_ENABLE_METERS
 #ifdef GT_USE_GPU
 #include "timer_cuda.hpp"
 #endif
+#ifdef GT_ENABLE_PERF_COUNTERS
+#include "timer_perf.hpp"
+#else
 #include "timer_omp.hpp"
 #endif
+#endif
 
 namespace gridtools {
     template <typename T>
@@ -28,25 +36,45 @@ namespace gridtools {
     template <typename T>
     struct timer_traits {
         using timer_type = timer_dummy;
+        using stage_timer_type = timer_dummy;
     };
 #else
 #ifdef GT_USE_GPU
     template <>
     struct timer_traits<backend::cuda> {
         using timer_type = timer_cuda;
+#ifdef GT_ENABLE_STAGE_METERS
+        using stage_timer_type = timer_cuda;
+#else
+        using stage_timer_type = timer_dummy;
+#endif
     };
+#endif
+#ifdef GT_ENABLE_PERF_COUNTERS
+    using timer_host = timer_perf;
+#else
+    using timer_host = timer_omp;
+#endif
+    // timer of the stage meters, see stage_meters.hpp
+#ifdef GT_ENABLE_STAGE_METERS
+    using stage_timer_host = timer_host;
+#else
+    using stage_timer_host = timer_dummy;
 #endif
     template <>
     struct timer_traits<backend::x86> {
-        using timer_type = timer_omp;
+        using timer_type = timer_host;
+        using stage_timer_type = stage_timer_host;
     };
     template <>
     struct timer_traits<backend::naive> {
-        using timer_type = timer_omp;
+        using timer_type = timer_host;
+        using stage_timer_type = stage_timer_host;
     };
     template <>
     struct timer_traits<backend::mc> {
-        using timer_type = timer_omp;
+        using timer_type = timer_host;
+        using stage_timer_type = stage_timer_host;
     };
 #endif
 } // namespace gridtools
@@ -382,6 +382,30 @@ namespace gridtools {
 #endif
         }
 
+        /**
+           Function to pack data to be sent, each field with its own halos, so that fields needing narrower halos
+           than the ones of the pattern are not exchanged at full width. Each halo must have the same begin, end and
+           total length as the one added with add_halo for the same dimension, and widths not larger than it. On the
+           host the messages to each neighbor contain the halos of all the fields, each as wide as given, while the
+           GPU version exchanges the halos of the pattern for all of them.
+
+           \param[in] fields vector with data fields pointers to be packed from
+           \param[in] halos vector with the halos of each field, with the dimensions in the ordering of add_halo
+        */
+        void pack(std::vector<DataType *> const &fields, std::vector<array<halo_descriptor, DIMS>> const &halos) {
+            hd.pack(fields, layout_halos(halos));
+        }
+
+        /**
+           Function to unpack received data, each field with its own halos, see pack.
+
+           \param[in] fields vector with data fields pointers to be unpacked into
+           \param[in] halos vector with the halos of each field, the same passed to pack
+        */
+        void unpack(std::vector<DataType *> const &fields, std::vector<array<halo_descriptor, DIMS>> const &halos) {
+            hd.unpack(fields, layout_halos(halos));
+        }
+
         /**
            function to trigger data exchange
 
@@ -459,7 +483,56 @@ namespace gridtools {
 #endif
         }
 
+        /**
+           function to switch between new non-blocking requests at every exchange (the default) and persistent requests
+           that are created once and restarted by every exchange. The buffers registered by setup() do not change, so
+           persistent requests save the per-exchange setup of the MPI library.
+        */
+        void set_persistent_requests(bool value) { hd.set_persistent_requests(value); }
+
+        bool persistent_requests() const { return hd.persistent_requests(); }
+
+        /**
+           function to switch between packing the halos into contiguous buffers (the default) and zero-copy exchanges,
+           in which MPI sends from and receives into the data fields through derived datatypes. Only available on the
+           host, see hndlr_dynamic_ut::set_zero_copy.
+        */
+        void set_zero_copy(bool value) { hd.set_zero_copy(value); }
+
+        bool zero_copy() const { return hd.zero_copy(); }
+
+        /**
+           function to switch between exchanging the halos with the 26 neighbors at once (the default) and in three
+           phases with the 6 face neighbors only, which fills edges and corners transitively. See
+           hndlr_dynamic_ut::set_face_exchange.
+        */
+        void set_face_exchange(bool value) { hd.set_face_exchange(value); }
+
+        bool face_exchange() const { return hd.face_exchange(); }
+
+        /**
+           function to make setup() allocate the send buffers in shared memory among the ranks on the same node, which
+           then exchange their halos without MPI messages. Must be called before setup(), see
+           hndlr_dynamic_ut::set_shared_memory.
+        */
+        void set_shared_memory(bool value) { hd.set_shared_memory(value); }
+
+        bool shared_memory() const { return hd.shared_memory(); }
+
         grid_type const &comm() const { return hd.comm(); }
+
+      private:
+        // puts the halos of each field in the ordering of hd.halo, as add_halo does
+        static std::vector<array<halo_descriptor, DIMS>> layout_halos(
+            std::vector<array<halo_descriptor, DIMS>> const &halos) {
+            std::vector<array<halo_descriptor, DIMS>> res(halos.size());
+            for (size_t i = 0; i < halos.size(); ++i) {
+                res[i][layout_map::template at<0>()] = halos[i][0];
+                res[i][layout_map::template at<1>()] = halos[i][1];
+                res[i][layout_map::template at<2>()] = halos[i][2];
+            }
+            return res;
+        }
     };
 
     /**
@@ -619,6 +692,14 @@ namespace gridtools {
            vice versa.
         */
         void wait() { hd.wait(); }
+
+        /**
+           function to switch between new non-blocking requests at every exchange (the default) and persistent requests
+           that are created once and restarted by every exchange, see halo_exchange_dynamic_ut::set_persistent_requests.
+        */
+        void set_persistent_requests(bool value) { hd.set_persistent_requests(value); }
+
+        bool persistent_requests() const { return hd.persistent_requests(); }
     };
 
     template <typename layout2proc_map, typename Gcl_Arch = gcl_cpu>
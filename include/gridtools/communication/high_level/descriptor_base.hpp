@@ -67,6 +67,14 @@ namespace gridtools {
         */
         void wait() { m_haloexch.wait(); }
 
+        /**
+           function to switch to persistent MPI requests, which are created once and reused by all the exchanges, see
+           Halo_Exchange_3D::set_persistent_requests.
+        */
+        void set_persistent_requests(bool value) { m_haloexch.set_persistent_requests(value); }
+
+        bool persistent_requests() const { return m_haloexch.persistent_requests(); }
+
         /**
            Retrieve the pattern from which the computing grid and other information
            can be retrieved. The function is available only if the underlying
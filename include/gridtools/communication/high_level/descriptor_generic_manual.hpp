@@ -55,6 +55,7 @@
 #include "../../common/make_array.hpp"
 #include "./helpers_impl.hpp"
 
+#include <initializer_list>
 #include <vector>
 
 namespace gridtools {
@@ -223,48 +224,36 @@ namespace gridtools {
             }
         }
 
+        /**
+           Function to pack data to be sent. The fields are packed in parallel over the pairs of fields and neighbors,
+           large halo regions are packed in parallel themselves.
+
+           \param[in] _fields data fields to be packed
+        */
         template <typename... FIELDS>
         void pack(const FIELDS &... _fields) const {
-            for (int ii = -1; ii <= 1; ++ii) {
-                for (int jj = -1; jj <= 1; ++jj) {
-                    for (int kk = -1; kk <= 1; ++kk) {
-                        char *it = reinterpret_cast<char *>(&(send_buffer[translate()(ii, jj, kk)][0]));
-                        pack_dims<DIMS, 0>()(*this, /*make_array(*/ ii, jj, kk /*)*/, it, _fields...);
-                    }
-                }
-            }
+            run_tasks(make_tasks<true>(_fields...));
         }
 
+        /**
+           Function to unpack received data, see pack.
+
+           \param[in] _fields data fields where to unpack data
+        */
         template <typename... FIELDS>
         void unpack(const FIELDS &... _fields) const {
-            for (int ii = -1; ii <= 1; ++ii) {
-                for (int jj = -1; jj <= 1; ++jj) {
-                    for (int kk = -1; kk <= 1; ++kk) {
-                        char *it = reinterpret_cast<char *>(&(recv_buffer[translate()(ii, jj, kk)][0]));
-                        unpack_dims<DIMS, 0>()(*this, ii, jj, kk, it, _fields...);
-                    }
-                }
-            }
+            run_tasks(make_tasks<false>(_fields...));
         }
 
         /**
-           Function to unpack received data
+           Function to pack data to be sent
 
            \tparam array_of_fotf this should be an array of field_on_the_fly
            \param[in] fields vector with fields on the fly
         */
         template <typename T1, typename T2, template <typename> class T3>
         void pack(std::vector<field_on_the_fly<T1, T2, T3>> const &fields) {
-            for (int ii = -1; ii <= 1; ++ii) {
-                for (int jj = -1; jj <= 1; ++jj) {
-                    for (int kk = -1; kk <= 1; ++kk) {
-                        typename field_on_the_fly<T1, T2, T3>::value_type *it =
-                            reinterpret_cast<typename field_on_the_fly<T1, T2, T3>::value_type *>(
-                                &(send_buffer[translate()(ii, jj, kk)][0]));
-                        pack_vector_dims<DIMS, 0>()(*this, ii, jj, kk, it, fields);
-                    }
-                }
-            }
+            run_tasks(make_tasks<true>(fields));
         }
 
         /**
@@ -275,108 +264,102 @@ namespace gridtools {
         */
         template <typename T1, typename T2, template <typename> class T3>
         void unpack(std::vector<field_on_the_fly<T1, T2, T3>> const &fields) {
-            for (int ii = -1; ii <= 1; ++ii) {
-                for (int jj = -1; jj <= 1; ++jj) {
-                    for (int kk = -1; kk <= 1; ++kk) {
-                        typename field_on_the_fly<T1, T2, T3>::value_type *it =
-                            reinterpret_cast<typename field_on_the_fly<T1, T2, T3>::value_type *>(
-                                &(recv_buffer[translate()(ii, jj, kk)][0]));
-                        unpack_vector_dims<DIMS, 0>()(*this, ii, jj, kk, it, fields);
-                    }
-                }
-            }
+            run_tasks(make_tasks<false>(fields));
         }
 
       private:
-        template <int, int>
-        struct pack_dims {};
-
-        template <int dummy>
-        struct pack_dims<3, dummy> {
-
-            template <typename T, typename iterator>
-            void operator()(const T &, int, int, int, iterator &) const {}
-
-            template <typename T, typename iterator, typename FIRST, typename... FIELDS>
-            void operator()(
-                const T &hm, int ii, int jj, int kk, iterator &it, FIRST const &first, const FIELDS &... _fields)
-                const {
-                typedef typename layout_transform<typename FIRST::inner_layoutmap, proc_layout_abs>::type proc_layout;
-                const int ii_P = make_array(ii, jj, kk)[proc_layout::template at<0>()];
-                const int jj_P = make_array(ii, jj, kk)[proc_layout::template at<1>()];
-                const int kk_P = make_array(ii, jj, kk)[proc_layout::template at<2>()];
-                if ((ii != 0 || jj != 0 || kk != 0) && (hm.pattern().proc_grid().proc(ii_P, jj_P, kk_P) != -1)) {
-                    first.pack(make_array(ii, jj, kk), first.ptr, it);
-                    operator()(hm, ii, jj, kk, it, _fields...);
-                }
-            }
+        /**
+           The packing or unpacking of one field for one neighbor. Its position in the buffer is computed upfront,
+           so that all tasks are independent.
+        */
+        struct field_task {
+            void (*m_f)(void const *, gridtools::array<int, DIMS> const &, char *);
+            void const *m_field;
+            gridtools::array<int, DIMS> m_eta;
+            char *m_it;
+            int m_size; // number of elements
         };
 
-        template <int, int>
-        struct unpack_dims {};
-
-        template <int dummy>
-        struct unpack_dims<3, dummy> {
-
-            template <typename T, typename iterator>
-            void operator()(const T &, int, int, int, iterator &) const {}
-
-            template <typename T, typename iterator, typename FIRST, typename... FIELDS>
-            void operator()(
-                const T &hm, int ii, int jj, int kk, iterator &it, FIRST const &first, const FIELDS &... _fields)
-                const {
-                typedef typename layout_transform<typename FIRST::inner_layoutmap, proc_layout_abs>::type proc_layout;
-                const int ii_P = make_array(ii, jj, kk)[proc_layout::template at<0>()];
-                const int jj_P = make_array(ii, jj, kk)[proc_layout::template at<1>()];
-                const int kk_P = make_array(ii, jj, kk)[proc_layout::template at<2>()];
-                if ((ii != 0 || jj != 0 || kk != 0) && (hm.pattern().proc_grid().proc(ii_P, jj_P, kk_P) != -1)) {
-                    first.unpack(make_array(ii, jj, kk), first.ptr, it);
-                    operator()(hm, ii, jj, kk, it, _fields...);
-                }
-            }
-        };
+        template <typename Field>
+        static void pack_field(void const *field, gridtools::array<int, DIMS> const &eta, char *it) {
+            Field const &f = *static_cast<Field const *>(field);
+            f.pack(eta, f.ptr, it);
+        }
 
-        template <int, int>
-        struct pack_vector_dims {};
-
-        template <int dummy>
-        struct pack_vector_dims<3, dummy> {
-
-            template <typename T, typename iterator, typename array_of_fotf>
-            void operator()(const T &hm, int ii, int jj, int kk, iterator &it, array_of_fotf const &_fields) const {
-                typedef typename layout_transform<typename array_of_fotf::value_type::inner_layoutmap,
-                    proc_layout_abs>::type proc_layout;
-                const int ii_P = make_array(ii, jj, kk)[proc_layout::template at<0>()];
-                const int jj_P = make_array(ii, jj, kk)[proc_layout::template at<1>()];
-                const int kk_P = make_array(ii, jj, kk)[proc_layout::template at<2>()];
-                if ((ii != 0 || jj != 0 || kk != 0) && (hm.pattern().proc_grid().proc(ii_P, jj_P, kk_P) != -1)) {
-                    for (unsigned int fi = 0; fi < _fields.size(); ++fi) {
-                        _fields[fi].pack(make_array(ii, jj, kk), _fields[fi].ptr, it);
-                    }
-                }
-            }
-        };
+        template <typename Field>
+        static void unpack_field(void const *field, gridtools::array<int, DIMS> const &eta, char *it) {
+            Field const &f = *static_cast<Field const *>(field);
+            f.unpack(eta, f.ptr, it);
+        }
+
+        template <typename Field>
+        bool has_neighbor(Field const &, int ii, int jj, int kk) const {
+            typedef typename layout_transform<typename Field::inner_layoutmap, proc_layout_abs>::type proc_layout;
+            const int ii_P = make_array(ii, jj, kk)[proc_layout::template at<0>()];
+            const int jj_P = make_array(ii, jj, kk)[proc_layout::template at<1>()];
+            const int kk_P = make_array(ii, jj, kk)[proc_layout::template at<2>()];
+            return (ii != 0 || jj != 0 || kk != 0) && (this->pattern().proc_grid().proc(ii_P, jj_P, kk_P) != -1);
+        }
 
-        template <int, int>
-        struct unpack_vector_dims {};
-
-        template <int dummy>
-        struct unpack_vector_dims<3, dummy> {
-
-            template <typename T, typename iterator, typename array_of_fotf>
-            void operator()(const T &hm, int ii, int jj, int kk, iterator &it, array_of_fotf const &_fields) const {
-                typedef typename layout_transform<typename array_of_fotf::value_type::inner_layoutmap,
-                    proc_layout_abs>::type proc_layout;
-                const int ii_P = make_array(ii, jj, kk)[proc_layout::template at<0>()];
-                const int jj_P = make_array(ii, jj, kk)[proc_layout::template at<1>()];
-                const int kk_P = make_array(ii, jj, kk)[proc_layout::template at<2>()];
-                if ((ii != 0 || jj != 0 || kk != 0) && (hm.pattern().proc_grid().proc(ii_P, jj_P, kk_P) != -1)) {
-                    for (unsigned int fi = 0; fi < _fields.size(); ++fi) {
-                        _fields[fi].unpack(make_array(ii, jj, kk), _fields[fi].ptr, it);
+        /**
+           Adds the task of a field for the neighbor (ii, jj, kk) at buffer position it and advances it past the
+           data of the field. Returns false if there is no such neighbor, the following fields are then skipped.
+        */
+        template <bool Pack, typename Field>
+        bool add_task(std::vector<field_task> &tasks, int ii, int jj, int kk, char *&it, Field const &field) const {
+            if (!has_neighbor(field, ii, jj, kk))
+                return false;
+            const gridtools::array<int, DIMS> eta = make_array(ii, jj, kk);
+            const int size = Pack ? field.send_buffer_size(eta) : field.recv_buffer_size(eta);
+            tasks.push_back({Pack ? &pack_field<Field> : &unpack_field<Field>, &field, eta, it, size});
+            it += size * sizeof(typename Field::value_type);
+            return true;
+        }
+
+        template <bool Pack, typename... FIELDS>
+        void add_tasks(std::vector<field_task> &tasks, int ii, int jj, int kk, char *it, const FIELDS &... _fields)
+            const {
+            bool active = true;
+            (void)std::initializer_list<bool>{(active = active && add_task<Pack>(tasks, ii, jj, kk, it, _fields))...};
+        }
+
+        template <bool Pack, typename T1, typename T2, template <typename> class T3>
+        void add_tasks(std::vector<field_task> &tasks,
+            int ii,
+            int jj,
+            int kk,
+            char *it,
+            std::vector<field_on_the_fly<T1, T2, T3>> const &fields) const {
+            for (auto const &field : fields)
+                if (!add_task<Pack>(tasks, ii, jj, kk, it, field))
+                    return;
+        }
+
+        template <bool Pack, typename... FIELDS>
+        std::vector<field_task> make_tasks(const FIELDS &... _fields) const {
+            std::vector<field_task> tasks;
+            for (int ii = -1; ii <= 1; ++ii) {
+                for (int jj = -1; jj <= 1; ++jj) {
+                    for (int kk = -1; kk <= 1; ++kk) {
+                        char *it = Pack ? send_buffer[translate()(ii, jj, kk)] : recv_buffer[translate()(ii, jj, kk)];
+                        add_tasks<Pack>(tasks, ii, jj, kk, it, _fields...);
                     }
                 }
             }
-        };
+            return tasks;
+        }
+
+        static void run_tasks(std::vector<field_task> const &tasks) {
+            // large regions are parallelized within the region, one after the other
+            for (auto const &task : tasks)
+                if (task.m_size >= _impl::parallel_pack_min_size)
+                    task.m_f(task.m_field, task.m_eta, task.m_it);
+            const int n = tasks.size();
+#pragma omp parallel for schedule(dynamic, 1)
+            for (int t = 0; t < n; ++t)
+                if (tasks[t].m_size < _impl::parallel_pack_min_size)
+                    tasks[t].m_f(tasks[t].m_field, tasks[t].m_eta, tasks[t].m_it);
+        }
     };
 
 #ifdef __CUDACC__
@@ -14,6 +14,7 @@
 #include "../../common/make_array.hpp"
 #include "../low_level/Halo_Exchange_3D.hpp"
 #include "../low_level/proc_grids_3D.hpp"
+#include <algorithm>
 #include <boost/type_traits/remove_pointer.hpp>
 #include <vector>
 
@@ -24,8 +25,10 @@
 #include "descriptor_base.hpp"
 #include "descriptors_fwd.hpp"
 #include "empty_field_base.hpp"
+#include "face_exchange.hpp"
 #include "gcl_parameters.hpp"
 #include "helpers_impl.hpp"
+#include "zero_copy_datatypes.hpp"
 #include <boost/preprocessor/arithmetic/inc.hpp>
 #include <boost/preprocessor/punctuation/comma_if.hpp>
 #include <boost/preprocessor/repetition/enum_binary_params.hpp>
@@ -70,72 +73,71 @@ namespace gridtools {
 
         template <typename iterator_in, typename iterator_out>
         void pack(gridtools::array<int, 3> const &eta, iterator_in const *field_ptr, iterator_out *&it) const {
-            // std::cout << "BASE ADDR IN PACK " << std::hex << reinterpret_cast<void*>(it) << std::dec << std::endl;
-            // std::cout << "k=" << base_type::halos[2].loop_low_bound_inside(eta[2])
-            //           << " to <= " << base_type::halos[2].loop_high_bound_inside(eta[2]) << ",\n"
-            //           << "j=" << base_type::halos[1].loop_low_bound_inside(eta[1])
-            //           << " to <= " << base_type::halos[1].loop_high_bound_inside(eta[1]) << ",\n"
-            //           << "i=" << base_type::halos[0].loop_low_bound_inside(eta[0])
-            //           << " to <= " << base_type::halos[0].loop_high_bound_inside(eta[0])
-            //           << std::endl;
-            for (int k = halos[2].loop_low_bound_inside(eta[2]); k <= halos[2].loop_high_bound_inside(eta[2]); ++k) {
-                for (int j = halos[1].loop_low_bound_inside(eta[1]); j <= halos[1].loop_high_bound_inside(eta[1]);
-                     ++j) {
-                    for (int i = halos[0].loop_low_bound_inside(eta[0]); i <= halos[0].loop_high_bound_inside(eta[0]);
-                         ++i) {
-
-                        // std::cout << "      "
-                        //           << i << ", "
-                        //           << j << ", "
-                        //           << k << ", "
-                        //           << base_type::halos[0].total_length() << ", "
-                        //           << base_type::halos[1].total_length() << ", "
-                        //           << base_type::halos[2].total_length() << ", "
-                        //           << field_ptr[gridtools::access
-                        //                        (i,j,k,
-                        //                         base_type::halos[0].total_length(),
-                        //                         base_type::halos[1].total_length(),
-                        //                         base_type::halos[2].total_length())]
-                        //           << std::endl;
-
-                        *(reinterpret_cast<iterator_in *>(it)) = field_ptr[gridtools::access(
-                            i, j, k, halos[0].total_length(), halos[1].total_length(), halos[2].total_length())];
-                        reinterpret_cast<char *&>(it) += sizeof(iterator_in);
-                    }
-                }
-            }
+            pack_box(make_array(halos[0].loop_low_bound_inside(eta[0]),
+                         halos[1].loop_low_bound_inside(eta[1]),
+                         halos[2].loop_low_bound_inside(eta[2])),
+                make_array(halos[0].loop_high_bound_inside(eta[0]),
+                    halos[1].loop_high_bound_inside(eta[1]),
+                    halos[2].loop_high_bound_inside(eta[2])),
+                field_ptr,
+                it);
         }
 
         template <typename iterator_in, typename iterator_out>
         void unpack(gridtools::array<int, 3> const &eta, iterator_in *field_ptr, iterator_out *&it) const {
-            // std::cout << "k=" << base_type::halos[2].loop_low_bound_outside(eta[2])
-            //           << " to <= " << base_type::halos[2].loop_high_bound_outside(eta[2]) << ",\n"
-            //           << "j=" << base_type::halos[1].loop_low_bound_outside(eta[1])
-            //           << " to <= " << base_type::halos[1].loop_high_bound_outside(eta[1]) << ",\n"
-            //           << "i=" << base_type::halos[0].loop_low_bound_outside(eta[0])
-            //           << " to <= " << base_type::halos[0].loop_high_bound_outside(eta[0])
-            //           << std::endl;
-            for (int k = halos[2].loop_low_bound_outside(eta[2]); k <= halos[2].loop_high_bound_outside(eta[2]); ++k) {
-                for (int j = halos[1].loop_low_bound_outside(eta[1]); j <= halos[1].loop_high_bound_outside(eta[1]);
-                     ++j) {
-                    for (int i = halos[0].loop_low_bound_outside(eta[0]); i <= halos[0].loop_high_bound_outside(eta[0]);
-                         ++i) {
-                        // std::cout << "      "
-                        //           << i << ", "
-                        //           << j << ", "
-                        //           << k << ", "
-                        //           << base_type::halos[0].total_length() << ", "
-                        //           << base_type::halos[1].total_length() << ", "
-                        //           << base_type::halos[2].total_length() << ", "
-                        //           << *(reinterpret_cast<iterator_in*>(it))
-                        //           << std::endl;
-                        field_ptr[gridtools::access(
-                            i, j, k, halos[0].total_length(), halos[1].total_length(), halos[2].total_length())] =
-                            *(reinterpret_cast<iterator_in *>(it));
-                        reinterpret_cast<char *&>(it) += sizeof(iterator_in);
-                    }
-                }
-            }
+            unpack_box(make_array(halos[0].loop_low_bound_outside(eta[0]),
+                           halos[1].loop_low_bound_outside(eta[1]),
+                           halos[2].loop_low_bound_outside(eta[2])),
+                make_array(halos[0].loop_high_bound_outside(eta[0]),
+                    halos[1].loop_high_bound_outside(eta[1]),
+                    halos[2].loop_high_bound_outside(eta[2])),
+                field_ptr,
+                it);
+        }
+
+        /**
+           Copies the box [first, last] (bounds included) of a field into the buffer pointed by it, which is advanced
+           past the copied data.
+        */
+        template <typename iterator_in, typename iterator_out>
+        void pack_box(gridtools::array<int, DIMS> const &first,
+            gridtools::array<int, DIMS> const &last,
+            iterator_in const *field_ptr,
+            iterator_out *&it) const {
+            iterator_in *buffer = reinterpret_cast<iterator_in *>(it);
+            int size = for_each_row(first, last, [&](int i, int j, int k, int offset, int length) {
+                iterator_in const *src = field_ptr + gridtools::access(i,
+                                                        j,
+                                                        k,
+                                                        halos[0].total_length(),
+                                                        halos[1].total_length(),
+                                                        halos[2].total_length());
+                for (int l = 0; l < length; ++l)
+                    buffer[offset + l] = src[l];
+            });
+            reinterpret_cast<char *&>(it) += size * sizeof(iterator_in);
+        }
+
+        /**
+           Copies the buffer pointed by it into the box [first, last] (bounds included) of a field, see pack_box.
+        */
+        template <typename iterator_in, typename iterator_out>
+        void unpack_box(gridtools::array<int, DIMS> const &first,
+            gridtools::array<int, DIMS> const &last,
+            iterator_in *field_ptr,
+            iterator_out *&it) const {
+            iterator_in const *buffer = reinterpret_cast<iterator_in const *>(it);
+            int size = for_each_row(first, last, [&](int i, int j, int k, int offset, int length) {
+                iterator_in *dst = field_ptr + gridtools::access(i,
+                                                   j,
+                                                   k,
+                                                   halos[0].total_length(),
+                                                   halos[1].total_length(),
+                                                   halos[2].total_length());
+                for (int l = 0; l < length; ++l)
+                    dst[l] = buffer[offset + l];
+            });
+            reinterpret_cast<char *&>(it) += size * sizeof(iterator_in);
         }
 
         template <typename iterator>
@@ -183,6 +185,27 @@ namespace gridtools {
             unpack(eta, field, it);
             unpack_all(eta, it, args...);
         }
+
+      private:
+        /**
+           Calls f(i, j, k, offset, length) for each row of the box [first, last] (bounds included) along the first
+           dimension, which is the one with stride 1. offset is the position of the row in the contiguous buffer
+           holding the box. Boxes of at least _impl::parallel_pack_min_size elements are processed in parallel over
+           the last dimension. Returns the number of elements in the box.
+        */
+        template <typename F>
+        static int for_each_row(
+            gridtools::array<int, DIMS> const &first, gridtools::array<int, DIMS> const &last, F f) {
+            const int ni = std::max(0, last[0] - first[0] + 1);
+            const int nj = std::max(0, last[1] - first[1] + 1);
+            const int nk = std::max(0, last[2] - first[2] + 1);
+            const int size = ni * nj * nk;
+#pragma omp parallel for if (size >= _impl::parallel_pack_min_size)
+            for (int k = 0; k < nk; ++k)
+                for (int j = 0; j < nj; ++j)
+                    f(first[0], first[1] + j, first[2] + k, (k * nj + j) * ni, ni);
+            return size;
+        }
     };
 
     /** \class field_descriptor_no_dt
@@ -433,6 +456,14 @@ namespace gridtools {
         array<int, _impl::static_pow3<DIMS>::value> send_size;
         array<int, _impl::static_pow3<DIMS>::value> recv_size;
 
+        bool m_zero_copy = false;
+        _impl::zero_copy_datatypes<DataType> m_zero_copy_types;
+
+        bool m_face_exchange = false;
+        _impl::face_exchange<DataType, empty_field_no_dt> m_faces;
+
+        bool m_shared_memory = false;
+
       public:
         typedef gcl_cpu arch_type;
         typedef descriptor_base<HaloExch> base_type;
@@ -467,6 +498,16 @@ namespace gridtools {
             std::cout << "Destructor " << __FILE__ << ":" << __LINE__ << std::endl;
 #endif
 
+            // the shared send buffers belong to the pattern, and the receive buffers of the neighbors on the node
+            // are their send buffers
+            if (base_type::m_haloexch.shared_send_buffers_allocated()) {
+                for (auto &buffer : send_buffer)
+                    buffer = nullptr;
+                for_each_neighbor([&](array<int, DIMS> const &eta, int ii_P, int jj_P, int kk_P) {
+                    if (base_type::m_haloexch.shared_source(ii_P, jj_P, kk_P))
+                        recv_buffer[translate()(eta[0], eta[1], eta[2])] = nullptr;
+                });
+            }
             _destroy_dynamic_ut<DIMS, 0>().do_it(this);
         }
 
@@ -495,7 +536,26 @@ namespace gridtools {
 
            \param max_fields_n Maximum number of data fields that will be passed to the communication functions
         */
-        void setup(int max_fields_n) { _impl::allocation_service<this_type>()(this, max_fields_n); }
+        void setup(int max_fields_n) {
+            _impl::allocation_service<this_type>()(this, max_fields_n);
+            if (m_shared_memory)
+                share_send_buffers();
+        }
+
+        /**
+           Makes setup allocate the send buffers in an MPI-3 shared memory window among the ranks on the same node,
+           so that the halos sent to neighbors on the same node are copied by them directly from the send buffers,
+           with one memcpy and no MPI message. The other neighbors are not affected. Must be called by all the ranks
+           before setup.
+
+           \param[in] value true to use shared memory with the neighbors on the same node
+        */
+        void set_shared_memory(bool value) { m_shared_memory = value; }
+
+        /**
+           Returns true if the send buffers are shared with the ranks on the same node, see set_shared_memory.
+        */
+        bool shared_memory() const { return m_shared_memory; }
 
 #ifdef GCL_TRACE
         void set_pattern_tag(int tag) { base_type::m_haloexch.set_pattern_tag(tag); };
@@ -508,7 +568,13 @@ namespace gridtools {
         */
         template <typename... FIELDS>
         void pack(const FIELDS &... _fields) {
-            pack_dims<DIMS, 0>()(*this, _fields...);
+            base_type::m_haloexch.acquire_shared_send_buffers();
+            if (m_face_exchange)
+                pack_faces(std::vector<DataType *>{field_ptr(_fields)...});
+            else if (m_zero_copy)
+                register_zero_copy(std::vector<DataType *>{field_ptr(_fields)...});
+            else
+                pack_dims<DIMS, 0>()(*this, _fields...);
         }
 
         /**
@@ -518,7 +584,13 @@ namespace gridtools {
         */
         template <typename... FIELDS>
         void unpack(const FIELDS &... _fields) const {
-            unpack_dims<DIMS, 0>()(*this, _fields...);
+            if (m_face_exchange)
+                assert(m_faces.fields() == std::vector<DataType *>({field_ptr(_fields)...}));
+            else if (m_zero_copy)
+                assert(m_zero_copy_types.fields() == std::vector<DataType *>({field_ptr(_fields)...}));
+            else
+                unpack_dims<DIMS, 0>()(*this, _fields...);
+            base_type::m_haloexch.release_shared_sources();
         }
 
         /**
@@ -526,14 +598,141 @@ namespace gridtools {
 
            \param[in] fields vector with data fields pointers to be packed from
         */
-        void pack(std::vector<DataType *> const &fields) { pack_vector_dims<DIMS, 0>()(*this, fields); }
+        void pack(std::vector<DataType *> const &fields) {
+            base_type::m_haloexch.acquire_shared_send_buffers();
+            if (m_face_exchange)
+                pack_faces(fields);
+            else if (m_zero_copy)
+                register_zero_copy(fields);
+            else
+                pack_vector_dims<DIMS, 0>()(*this, fields);
+        }
 
         /**
            Function to unpack received data
 
            \param[in] fields vector with data fields pointers to be unpacked into
         */
-        void unpack(std::vector<DataType *> const &fields) { unpack_vector_dims<DIMS, 0>()(*this, fields); }
+        void unpack(std::vector<DataType *> const &fields) {
+            if (m_face_exchange)
+                assert(m_faces.fields() == fields);
+            else if (m_zero_copy)
+                assert(m_zero_copy_types.fields() == fields);
+            else
+                unpack_vector_dims<DIMS, 0>()(*this, fields);
+            base_type::m_haloexch.release_shared_sources();
+        }
+
+        /**
+           Function to pack data to be sent, each field with its own halos. The halo of a field along a dimension must
+           have the same begin, end and total length as the halo of the pattern, and widths not larger than it, so
+           that the buffers allocated by setup suffice. Each neighbor still receives one message, with the halos of
+           all the fields as wide as each of them requires. All the processes must pass the same halos for a field.
+           In zero-copy and face exchange modes the halos of the pattern are exchanged for all the fields.
+
+           \param[in] fields vector with data fields pointers to be packed from
+           \param[in] halos vector with the halos of each field, with the dimensions ordered as in halo
+        */
+        void pack(std::vector<DataType *> const &fields, std::vector<array<halo_descriptor, DIMS>> const &halos) {
+            if (m_face_exchange || m_zero_copy) {
+                pack(fields);
+            } else {
+                base_type::m_haloexch.acquire_shared_send_buffers();
+                pack_vector_halos(fields, field_halos(halos));
+            }
+        }
+
+        /**
+           Function to unpack received data, each field with its own halos, see pack.
+
+           \param[in] fields vector with data fields pointers to be unpacked into
+           \param[in] halos vector with the halos of each field, the same passed to pack
+        */
+        void unpack(std::vector<DataType *> const &fields, std::vector<array<halo_descriptor, DIMS>> const &halos) {
+            if (m_face_exchange || m_zero_copy) {
+                unpack(fields);
+            } else {
+                unpack_vector_halos(fields, field_halos(halos));
+                base_type::m_haloexch.release_shared_sources();
+            }
+        }
+
+        /**
+           Switches between packing the halos into contiguous buffers (the default) and zero-copy exchanges. In
+           zero-copy mode the halo regions of the fields are described by MPI derived datatypes, created once per
+           halo layout and list of fields, so that MPI sends directly from and receives directly into the fields:
+           pack only registers the datatypes of the fields and unpack does nothing. The fields passed to unpack must
+           be the ones passed to pack, and with split-phase communication the receives must be posted after pack,
+           unless the fields are the same as in the previous pack. Must not be called while an exchange is in
+           progress.
+
+           \param[in] value true to exchange without packing
+        */
+        void set_zero_copy(bool value) {
+            if (m_zero_copy && !value)
+                register_buffers();
+            m_zero_copy = value;
+        }
+
+        /**
+           Returns true if the exchanges do not pack the halos, see set_zero_copy.
+        */
+        bool zero_copy() const { return m_zero_copy; }
+
+        /**
+           Switches between exchanging the halos with all the 26 neighbors at once (the default) and exchanging them
+           in three phases, one per dimension, with the two face neighbors only. The faces of a phase include the
+           halos received in the previous ones, so that edges and corners are filled with 6 messages instead of 26,
+           which pays off when the exchange is dominated by latency. pack packs the first phase, which can be
+           overlapped with computation, and wait (or exchange) completes all of them; unpack does nothing, the fields
+           passed to it must be the ones passed to pack. Zero copy and persistent requests are not used by the phased
+           exchange. Must not be called while an exchange is in progress.
+
+           \param[in] value true to exchange the faces in phases
+        */
+        void set_face_exchange(bool value) { m_face_exchange = value; }
+
+        /**
+           Returns true if the halos are exchanged in phases with the face neighbors, see set_face_exchange.
+        */
+        bool face_exchange() const { return m_face_exchange; }
+
+        void exchange() {
+            if (m_face_exchange) {
+                m_faces.start();
+                m_faces.wait();
+            } else {
+                base_type::exchange();
+            }
+        }
+
+        void post_receives() {
+            if (m_face_exchange)
+                m_faces.post_receives();
+            else
+                base_type::post_receives();
+        }
+
+        void do_sends() {
+            if (m_face_exchange)
+                m_faces.do_sends();
+            else
+                base_type::do_sends();
+        }
+
+        void start_exchange() {
+            if (m_face_exchange)
+                m_faces.start();
+            else
+                base_type::start_exchange();
+        }
+
+        void wait() {
+            if (m_face_exchange)
+                m_faces.wait();
+            else
+                base_type::wait();
+        }
 
         /// Utilities
 
@@ -554,6 +753,156 @@ namespace gridtools {
         // friend class _impl::unpack_service<this_type>;
 
       private:
+        void share_send_buffers() {
+            base_type::m_haloexch.allocate_shared_send_buffers();
+            typedef proc_layout map_type;
+            for (int ii = -1; ii <= 1; ++ii)
+                for (int jj = -1; jj <= 1; ++jj)
+                    for (int kk = -1; kk <= 1; ++kk)
+                        if (ii != 0 || jj != 0 || kk != 0) {
+                            DataType *&buffer = send_buffer[translate()(ii, jj, kk)];
+                            _impl::gcl_alloc<DataType, arch_type>::free(buffer);
+                            buffer = static_cast<DataType *>(
+                                base_type::m_haloexch.send_buffer(make_array(ii, jj, kk)[map_type::template at<0>()],
+                                    make_array(ii, jj, kk)[map_type::template at<1>()],
+                                    make_array(ii, jj, kk)[map_type::template at<2>()]));
+                        }
+            // the halos from the neighbors on the node are unpacked directly from their send buffers
+            for_each_neighbor([&](array<int, DIMS> const &eta, int ii_P, int jj_P, int kk_P) {
+                void *source = base_type::m_haloexch.shared_source(ii_P, jj_P, kk_P);
+                if (!source)
+                    return;
+                DataType *&buffer = recv_buffer[translate()(eta[0], eta[1], eta[2])];
+                _impl::gcl_alloc<DataType, arch_type>::free(buffer);
+                buffer = static_cast<DataType *>(source);
+                base_type::m_haloexch.register_receive_from_buffer(
+                    buffer, recv_size[translate()(eta[0], eta[1], eta[2])] * sizeof(DataType), ii_P, jj_P, kk_P);
+            });
+        }
+
+        // the halos of the fields are written by the exchange, whatever the constness of the pointers passed
+        static DataType *field_ptr(DataType const *field) { return const_cast<DataType *>(field); }
+
+        template <typename F>
+        void for_each_neighbor(F f) const {
+            typedef proc_layout map_type;
+            for (int ii = -1; ii <= 1; ++ii)
+                for (int jj = -1; jj <= 1; ++jj)
+                    for (int kk = -1; kk <= 1; ++kk) {
+                        const int ii_P = make_array(ii, jj, kk)[map_type::template at<0>()];
+                        const int jj_P = make_array(ii, jj, kk)[map_type::template at<1>()];
+                        const int kk_P = make_array(ii, jj, kk)[map_type::template at<2>()];
+                        if ((ii != 0 || jj != 0 || kk != 0) && pattern().proc_grid().proc(ii_P, jj_P, kk_P) != -1)
+                            f(make_array(ii, jj, kk), ii_P, jj_P, kk_P);
+                    }
+        }
+
+        void pack_faces(std::vector<DataType *> const &fields) {
+            typedef proc_layout map_type;
+            array<int, 2 * DIMS> procs;
+            for (int d = 0; d < DIMS; ++d)
+                for (int side = -1; side <= 1; side += 2) {
+                    array<int, DIMS> eta{0, 0, 0};
+                    eta[d] = side;
+                    procs[2 * d + (side > 0)] = pattern().proc_grid().proc(eta[map_type::template at<0>()],
+                        eta[map_type::template at<1>()],
+                        eta[map_type::template at<2>()]);
+                }
+            m_faces.pack(halo, procs, get_communicator(pattern().proc_grid()), fields);
+        }
+
+        void register_zero_copy(std::vector<DataType *> const &fields) {
+            if (!m_zero_copy_types.update(halo.halos, fields))
+                return;
+            for_each_neighbor([&](array<int, DIMS> const &eta, int ii_P, int jj_P, int kk_P) {
+                base_type::m_haloexch.register_send_to_datatype(
+                    MPI_BOTTOM, m_zero_copy_types.send_type(eta), ii_P, jj_P, kk_P);
+                base_type::m_haloexch.register_receive_from_datatype(
+                    MPI_BOTTOM, m_zero_copy_types.recv_type(eta), ii_P, jj_P, kk_P);
+            });
+        }
+
+        // restores the buffers registered by setup, the sizes are set by every pack
+        void register_buffers() {
+            for_each_neighbor([&](array<int, DIMS> const &eta, int ii_P, int jj_P, int kk_P) {
+                base_type::m_haloexch.register_send_to_buffer(send_buffer[translate()(eta[0], eta[1], eta[2])],
+                    send_size[translate()(eta[0], eta[1], eta[2])] * sizeof(DataType),
+                    ii_P,
+                    jj_P,
+                    kk_P);
+                base_type::m_haloexch.register_receive_from_buffer(recv_buffer[translate()(eta[0], eta[1], eta[2])],
+                    recv_size[translate()(eta[0], eta[1], eta[2])] * sizeof(DataType),
+                    ii_P,
+                    jj_P,
+                    kk_P);
+            });
+        }
+
+        // the descriptions of fields with their own halos, which must fit in the buffers allocated for halo
+        std::vector<empty_field_no_dt> field_halos(std::vector<array<halo_descriptor, DIMS>> const &halos) const {
+            std::vector<empty_field_no_dt> res(halos.size());
+            for (size_t i = 0; i < halos.size(); ++i)
+                for (int d = 0; d < DIMS; ++d) {
+                    halo_descriptor const &h = halos[i][d];
+                    halo_descriptor const &max = halo.halos[d];
+                    assert(h.begin() == max.begin() && h.end() == max.end() &&
+                           h.total_length() == max.total_length());
+                    assert(h.minus() <= max.minus() && h.plus() <= max.plus());
+                    res[i].add_halo(d, h);
+                }
+            return res;
+        }
+
+        void pack_vector_halos(std::vector<DataType *> const &fields, std::vector<empty_field_no_dt> const &halos) {
+            assert(fields.size() == halos.size());
+            typedef proc_layout map_type;
+#pragma omp parallel for schedule(dynamic, 1) collapse(3)
+            for (int ii = -1; ii <= 1; ++ii) {
+                for (int jj = -1; jj <= 1; ++jj) {
+                    for (int kk = -1; kk <= 1; ++kk) {
+                        const int ii_P = make_array(ii, jj, kk)[map_type::template at<0>()];
+                        const int jj_P = make_array(ii, jj, kk)[map_type::template at<1>()];
+                        const int kk_P = make_array(ii, jj, kk)[map_type::template at<2>()];
+                        if ((ii != 0 || jj != 0 || kk != 0) && (pattern().proc_grid().proc(ii_P, jj_P, kk_P) != -1)) {
+                            const auto eta = make_array(ii, jj, kk);
+                            DataType *it = &(send_buffer[translate()(ii, jj, kk)][0]);
+                            int send = 0;
+                            int recv = 0;
+                            for (size_t i = 0; i < fields.size(); ++i) {
+                                halos[i].pack(eta, fields[i], it);
+                                send += halos[i].send_buffer_size(eta);
+                                recv += halos[i].recv_buffer_size(eta);
+                            }
+
+                            base_type::m_haloexch.set_send_to_size(send * sizeof(DataType), ii_P, jj_P, kk_P);
+                            base_type::m_haloexch.set_receive_from_size(recv * sizeof(DataType), ii_P, jj_P, kk_P);
+                        }
+                    }
+                }
+            }
+        }
+
+        void unpack_vector_halos(
+            std::vector<DataType *> const &fields, std::vector<empty_field_no_dt> const &halos) const {
+            assert(fields.size() == halos.size());
+            typedef proc_layout map_type;
+#pragma omp parallel for schedule(dynamic, 1) collapse(3)
+            for (int ii = -1; ii <= 1; ++ii) {
+                for (int jj = -1; jj <= 1; ++jj) {
+                    for (int kk = -1; kk <= 1; ++kk) {
+                        const int ii_P = make_array(ii, jj, kk)[map_type::template at<0>()];
+                        const int jj_P = make_array(ii, jj, kk)[map_type::template at<1>()];
+                        const int kk_P = make_array(ii, jj, kk)[map_type::template at<2>()];
+                        if ((ii != 0 || jj != 0 || kk != 0) && (pattern().proc_grid().proc(ii_P, jj_P, kk_P) != -1)) {
+                            DataType *it = &(recv_buffer[translate()(ii, jj, kk)][0]);
+                            for (size_t i = 0; i < fields.size(); ++i)
+                                halos[i].unpack(make_array(ii, jj, kk), fields[i], it);
+                        }
+                    }
+                }
+            }
+        }
+
         template <int I, int dummy>
         struct pack_dims {};
 
@@ -657,6 +657,25 @@ namespace gridtools {
                 m_unpackXU(fields, d_recv_buffer, d_recv_size, dangeroushalo_r, halo_d_r);
             }
         }
+
+        /**
+           Function to pack data before sending, each field with its own halos. The kernels pack the halos of the
+           pattern for all the fields, which contain the ones of the fields, so the halos are ignored.
+
+           \param[in] fields vector with data fields pointers to be packed from
+        */
+        void pack(std::vector<DataType *> const &fields, std::vector<array<halo_descriptor, DIMS>> const &) {
+            pack(fields);
+        }
+
+        /**
+           Function to unpack received data, each field with its own halos, see pack.
+
+           \param[in] fields vector with data fields pointers to be unpacked into
+        */
+        void unpack(std::vector<DataType *> const &fields, std::vector<array<halo_descriptor, DIMS>> const &) {
+            unpack(fields);
+        }
     };
 #endif
 } // namespace gridtools
@@ -16,6 +16,12 @@
 
 namespace gridtools {
     namespace _impl {
+        /**
+           Minimal number of elements of a halo region of a single field for which the host pack and unpack are
+           parallelized within the region. Smaller regions are packed by a single thread, in parallel with the other
+           fields and neighbors.
+        */
+        constexpr int parallel_pack_min_size = 1 << 15;
 
         template <typename T, typename arch /*=gcl_cpu*/>
         struct gcl_alloc;
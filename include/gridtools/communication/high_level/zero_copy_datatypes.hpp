@@ -0,0 +1,152 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <vector>
+
+#include "../../common/array.hpp"
+#include "../../common/halo_descriptor.hpp"
+#include "../../common/make_array.hpp"
+#include "../../common/numerics.hpp"
+#include "empty_field_base.hpp"
+
+namespace gridtools {
+    namespace _impl {
+        /**
+           MPI datatypes describing the halo regions of a list of data fields with the same layout, so that the
+           halos can be sent from and received into the fields without packing.
+
+           For every neighbor eta there is a subarray datatype for the region to be sent (inside) and for the region
+           to be received (outside) of a single field. They are created once per halo layout. The datatypes for the
+           whole list of fields combine them in a struct at the absolute addresses of the fields, to be used with
+           MPI_BOTTOM, and are recreated only when the list of fields changes.
+
+           \tparam DataType Value type of the elements of the fields
+        */
+        template <typename DataType>
+        class zero_copy_datatypes {
+            static constexpr int DIMS = 3;
+            static constexpr int N = static_pow3<DIMS>::value;
+
+            typedef array<halo_descriptor, DIMS> halos_t;
+            typedef array<MPI_Datatype, N> types_t;
+
+            bool m_has_layout = false;
+            halos_t m_halos;
+            types_t m_inside;
+            types_t m_outside;
+
+            std::vector<DataType *> m_fields;
+            types_t m_send;
+            types_t m_recv;
+
+            static void fill(types_t &types) {
+                for (auto &type : types)
+                    type = MPI_DATATYPE_NULL;
+            }
+
+            static void free(types_t &types) {
+                int finalized;
+                MPI_Finalized(&finalized);
+                for (auto &type : types)
+                    if (type != MPI_DATATYPE_NULL) {
+                        if (!finalized)
+                            MPI_Type_free(&type);
+                        type = MPI_DATATYPE_NULL;
+                    }
+            }
+
+            static MPI_Datatype valid_or_null(std::pair<MPI_Datatype, bool> const &type) {
+                return type.second ? type.first : MPI_DATATYPE_NULL;
+            }
+
+            void set_layout(halos_t const &halos) {
+                free(m_inside);
+                free(m_outside);
+                m_halos = halos;
+                for (int ii = -1; ii <= 1; ++ii)
+                    for (int jj = -1; jj <= 1; ++jj)
+                        for (int kk = -1; kk <= 1; ++kk) {
+                            const auto eta = make_array(ii, jj, kk);
+                            const int idx = neigh_idx(eta);
+                            if (ii == 0 && jj == 0 && kk == 0)
+                                continue;
+                            m_inside[idx] = valid_or_null(make_datatype_outin<DataType>::inside(m_halos, eta));
+                            m_outside[idx] = valid_or_null(make_datatype_outin<DataType>::outside(m_halos, eta));
+                        }
+                m_has_layout = true;
+            }
+
+            static MPI_Datatype make_struct(MPI_Datatype type, std::vector<DataType *> const &fields) {
+                if (type == MPI_DATATYPE_NULL || fields.empty())
+                    return MPI_DATATYPE_NULL;
+                const int n = fields.size();
+                std::vector<int> lengths(n, 1);
+                std::vector<MPI_Aint> displacements(n);
+                std::vector<MPI_Datatype> types(n, type);
+                for (int i = 0; i < n; ++i)
+                    MPI_Get_address(fields[i], &displacements[i]);
+                MPI_Datatype res;
+                MPI_Type_create_struct(n, &lengths[0], &displacements[0], &types[0], &res);
+                MPI_Type_commit(&res);
+                return res;
+            }
+
+          public:
+            zero_copy_datatypes() {
+                fill(m_inside);
+                fill(m_outside);
+                fill(m_send);
+                fill(m_recv);
+            }
+
+            zero_copy_datatypes(zero_copy_datatypes const &) = delete;
+            zero_copy_datatypes &operator=(zero_copy_datatypes const &) = delete;
+
+            ~zero_copy_datatypes() {
+                free(m_send);
+                free(m_recv);
+                free(m_inside);
+                free(m_outside);
+            }
+
+            /**
+               Makes the datatypes describe the given fields with the given halos.
+
+               \return true if the datatypes have been recreated
+            */
+            bool update(halos_t const &halos, std::vector<DataType *> const &fields) {
+                bool layout_changed = !m_has_layout;
+                for (int i = 0; i < DIMS; ++i)
+                    layout_changed = layout_changed || !(m_halos[i] == halos[i]);
+                if (!layout_changed && fields == m_fields)
+                    return false;
+                if (layout_changed)
+                    set_layout(halos);
+                free(m_send);
+                free(m_recv);
+                m_fields = fields;
+                for (int i = 0; i < N; ++i) {
+                    m_send[i] = make_struct(m_inside[i], m_fields);
+                    m_recv[i] = make_struct(m_outside[i], m_fields);
+                }
+                return true;
+            }
+
+            /** Datatype of the data to be sent to neighbor eta, MPI_DATATYPE_NULL if there is none */
+            MPI_Datatype send_type(array<int, DIMS> const &eta) const { return m_send[neigh_idx(eta)]; }
+
+            /** Datatype of the data to be received from neighbor eta, MPI_DATATYPE_NULL if there is none */
+            MPI_Datatype recv_type(array<int, DIMS> const &eta) const { return m_recv[neigh_idx(eta)]; }
+
+            std::vector<DataType *> const &fields() const { return m_fields; }
+        };
+    } // namespace _impl
+} // namespace gridtools
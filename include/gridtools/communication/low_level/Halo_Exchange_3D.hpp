@@ -12,6 +12,13 @@
 #ifdef GT_VERBOSE
 #include <iostream>
 #endif
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <thread>
+#include <vector>
 
 #include "../../common/defs.hpp"
 #include "../../common/gt_assert.hpp"
@@ -154,7 +161,9 @@ namespace gridtools {
 
         class sr_buffers {
             char *m_buffers[27]; // there is ona buffer more to allow for a simple indexing
-            int m_size[27];      // Sizes in bytes
+            int m_size[27];      // Sizes in bytes, or number of elements of m_type
+            MPI_Datatype m_type[27];
+
           public:
             explicit sr_buffers() {
                 m_buffers[0] = nullptr;
@@ -212,11 +221,16 @@ namespace gridtools {
                 m_size[24] = 0;
                 m_size[25] = 0;
                 m_size[26] = 0;
+
+                for (int i = 0; i < 27; ++i)
+                    m_type[i] = MPI_CHAR;
             }
 
             char *&buffer(int I, int J, int K) { return m_buffers[translate()(I, J, K)]; }
             int &size(int I, int J, int K) { return m_size[translate()(I, J, K)]; }
             int size(int I, int J, int K) const { return m_size[translate()(I, J, K)]; }
+            MPI_Datatype &type(int I, int J, int K) { return m_type[translate()(I, J, K)]; }
+            MPI_Datatype type(int I, int J, int K) const { return m_type[translate()(I, J, K)]; }
         };
 
         template <int I, int J, int K>
@@ -224,6 +238,8 @@ namespace gridtools {
             static const int value = (K + 1) * 9 + (I + 1) * 3 + J + 1;
         };
 
+        static int tag(int I, int J, int K) { return (K + 1) * 9 + (I + 1) * 3 + J + 1; }
+
         struct request_t {
             MPI_Request request[27];
             MPI_Request &operator()(int i, int j, int k) { return request[translate()(i, j, k)]; }
@@ -249,11 +265,248 @@ namespace gridtools {
         request_t request;
         request_t_mark send_request;
 
+        /**
+           Persistent requests (MPI_Recv_init/MPI_Send_init) for the receives or the sends to all neighbors. They are
+           created on first use and recreated only when a buffer or a size of that kind changes. Copies of the pattern
+           do not share the requests.
+        */
+        class persistent_request_set {
+            std::vector<MPI_Request> m_requests;
+            bool m_valid = false;
+
+          public:
+            persistent_request_set() = default;
+            persistent_request_set(persistent_request_set const &) {}
+            persistent_request_set &operator=(persistent_request_set const &) {
+                clear();
+                return *this;
+            }
+            ~persistent_request_set() { clear(); }
+
+            bool valid() const { return m_valid; }
+
+            void invalidate() { m_valid = false; }
+
+            void clear() {
+                int finalized;
+                MPI_Finalized(&finalized);
+                if (!finalized)
+                    for (auto &request : m_requests)
+                        MPI_Request_free(&request);
+                m_requests.clear();
+                m_valid = false;
+            }
+
+            void add(MPI_Request const &request) { m_requests.push_back(request); }
+
+            void set_valid() { m_valid = true; }
+
+            void start() {
+                if (!m_requests.empty())
+                    MPI_Startall(m_requests.size(), m_requests.data());
+            }
+
+            void wait() {
+                if (!m_requests.empty())
+                    MPI_Waitall(m_requests.size(), m_requests.data(), MPI_STATUSES_IGNORE);
+            }
+        };
+
+        persistent_request_set m_persistent_recvs;
+        persistent_request_set m_persistent_sends;
+        bool m_use_persistent = false;
+
+        /**
+           Send buffers allocated in an MPI-3 shared memory window among the ranks of the communicator that are on
+           the same node. The data received from a neighbor on the same node is unpacked directly from its send
+           buffer. Each rank stores the offsets of its buffers at the beginning of its part of the window, so that the
+           sizes may differ between ranks, followed by two counters of exchanges through which the neighbors on the
+           node synchronize pairwise: a sender may pack once its receivers have unpacked the previous exchange, and a
+           receiver may unpack once its senders have packed.
+        */
+        class shared_send_buffers {
+            struct header {
+                MPI_Aint offsets[27];
+                std::atomic<std::uint64_t> packed;   // exchanges whose send buffers are packed
+                std::atomic<std::uint64_t> unpacked; // exchanges whose halos from the node have been unpacked
+            };
+
+            MPI_Comm m_node_comm = MPI_COMM_NULL;
+            MPI_Win m_win = MPI_WIN_NULL;
+            char *m_buffers[27];
+            char *m_sources[27];
+            header *m_header;
+            std::vector<header const *> m_neighbors; // headers of the neighbors on the node
+            std::uint64_t m_exchanges = 0;
+
+            static constexpr MPI_Aint alignment = 64;
+
+            void wait_for(std::atomic<std::uint64_t> const header::*counter) const {
+                for (header const *neighbor : m_neighbors)
+                    while ((neighbor->*counter).load(std::memory_order_acquire) < m_exchanges)
+                        std::this_thread::yield();
+                MPI_Win_sync(m_win);
+            }
+
+          public:
+            /**
+               Collective over comm.
+
+               \param[in] comm Communicator of the process grid
+               \param[in] sizes Sizes in bytes of the send buffers, indexed by translate
+               \param[in] procs Ranks in comm of the neighbors, indexed by translate, -1 where there is none
+            */
+            shared_send_buffers(MPI_Comm comm, int const *sizes, int const *procs) {
+                MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &m_node_comm);
+
+                const MPI_Aint header_size = ((sizeof(header) + alignment - 1) / alignment) * alignment;
+                MPI_Aint offsets[27];
+                MPI_Aint total = header_size;
+                for (int i = 0; i < 27; ++i) {
+                    offsets[i] = total;
+                    total += ((sizes[i] + alignment - 1) / alignment) * alignment;
+                }
+
+                // let each rank's part of the window be allocated close to it
+                MPI_Info info;
+                MPI_Info_create(&info);
+                MPI_Info_set(info, "alloc_shared_noncontig", "true");
+                char *base;
+                MPI_Win_allocate_shared(total, 1, info, m_node_comm, &base, &m_win);
+                MPI_Info_free(&info);
+                MPI_Win_lock_all(MPI_MODE_NOCHECK, m_win);
+
+                m_header = new (base) header;
+                std::memcpy(m_header->offsets, offsets, sizeof(offsets));
+                m_header->packed.store(0);
+                m_header->unpacked.store(0);
+                for (int i = 0; i < 27; ++i)
+                    m_buffers[i] = base + offsets[i];
+                MPI_Win_sync(m_win);
+                MPI_Barrier(m_node_comm);
+                MPI_Win_sync(m_win);
+
+                MPI_Group group, node_group;
+                MPI_Comm_group(comm, &group);
+                MPI_Comm_group(m_node_comm, &node_group);
+                for (int i = -1; i <= 1; ++i)
+                    for (int j = -1; j <= 1; ++j)
+                        for (int k = -1; k <= 1; ++k) {
+                            const int idx = translate()(i, j, k);
+                            m_sources[idx] = nullptr;
+                            if ((i == 0 && j == 0 && k == 0) || procs[idx] == -1)
+                                continue;
+                            int node_rank;
+                            MPI_Group_translate_ranks(group, 1, &procs[idx], node_group, &node_rank);
+                            if (node_rank == MPI_UNDEFINED)
+                                continue;
+                            MPI_Aint size;
+                            int disp_unit;
+                            char *neighbor_base;
+                            MPI_Win_shared_query(m_win, node_rank, &size, &disp_unit, &neighbor_base);
+                            // the neighbor sends to us in the opposite direction
+                            header const *neighbor = reinterpret_cast<header const *>(neighbor_base);
+                            m_sources[idx] = neighbor_base + neighbor->offsets[translate()(-i, -j, -k)];
+                            m_neighbors.push_back(neighbor);
+                        }
+                MPI_Group_free(&group);
+                MPI_Group_free(&node_group);
+            }
+
+            shared_send_buffers(shared_send_buffers const &) = delete;
+            shared_send_buffers &operator=(shared_send_buffers const &) = delete;
+
+            ~shared_send_buffers() {
+                int finalized;
+                MPI_Finalized(&finalized);
+                if (finalized)
+                    return;
+                MPI_Win_unlock_all(m_win);
+                MPI_Win_free(&m_win);
+                MPI_Comm_free(&m_node_comm);
+            }
+
+            char *buffer(int I, int J, int K) const { return m_buffers[translate()(I, J, K)]; }
+
+            /** Send buffer of neighbor I, J, K holding the data for this rank, nullptr if not on the same node */
+            char *source(int I, int J, int K) const { return m_sources[translate()(I, J, K)]; }
+
+            /** Waits until the neighbors on the node have unpacked the last exchange from the send buffers */
+            void acquire_buffers() {
+                release_sources();
+                wait_for(&header::unpacked);
+            }
+
+            /** Makes the packed send buffers visible to the neighbors on the node */
+            void post_buffers() {
+                ++m_exchanges;
+                MPI_Win_sync(m_win);
+                m_header->packed.store(m_exchanges, std::memory_order_release);
+            }
+
+            /** Waits until the neighbors on the node have packed the last exchange */
+            void acquire_sources() const { wait_for(&header::packed); }
+
+            /** Lets the neighbors on the node overwrite the send buffers unpacked by this rank */
+            void release_sources() const { m_header->unpacked.store(m_exchanges, std::memory_order_release); }
+        };
+
+        std::shared_ptr<shared_send_buffers> m_shared;
+
         const PROC_GRID /*&*/ m_proc_grid;
 
+        void init_persistent_receives() {
+            m_persistent_recvs.clear();
+            for (int i = -1; i <= 1; ++i)
+                for (int j = -1; j <= 1; ++j)
+                    for (int k = -1; k <= 1; ++k)
+                        if ((i != 0 || j != 0 || k != 0) && m_proc_grid.proc(i, j, k) != -1 &&
+                            m_recv_buffers.size(i, j, k) && !recv_on_node(i, j, k)) {
+                            MPI_Request request;
+                            MPI_Recv_init(m_recv_buffers.buffer(i, j, k),
+                                m_recv_buffers.size(i, j, k),
+                                m_recv_buffers.type(i, j, k),
+                                m_proc_grid.proc(i, j, k),
+                                tag(-i, -j, -k),
+                                get_communicator(m_proc_grid),
+                                &request);
+                            m_persistent_recvs.add(request);
+                        }
+            m_persistent_recvs.set_valid();
+        }
+
+        void init_persistent_sends() {
+            m_persistent_sends.clear();
+            for (int i = -1; i <= 1; ++i)
+                for (int j = -1; j <= 1; ++j)
+                    for (int k = -1; k <= 1; ++k)
+                        if ((i != 0 || j != 0 || k != 0) && m_proc_grid.proc(i, j, k) != -1 &&
+                            m_send_buffers.size(i, j, k) && !send_on_node(i, j, k)) {
+                            MPI_Request request;
+                            MPI_Send_init(m_send_buffers.buffer(i, j, k),
+                                m_send_buffers.size(i, j, k),
+                                m_send_buffers.type(i, j, k),
+                                m_proc_grid.proc(i, j, k),
+                                tag(i, j, k),
+                                get_communicator(m_proc_grid),
+                                &request);
+                            m_persistent_sends.add(request);
+                        }
+            m_persistent_sends.set_valid();
+        }
+
+        // data described by datatypes is never in the shared buffers
+        static bool on_node(shared_send_buffers const *shared, sr_buffers const &buffers, int I, int J, int K) {
+            return shared && shared->source(I, J, K) && buffers.type(I, J, K) == MPI_CHAR;
+        }
+
+        bool recv_on_node(int I, int J, int K) const { return on_node(m_shared.get(), m_recv_buffers, I, J, K); }
+
+        bool send_on_node(int I, int J, int K) const { return on_node(m_shared.get(), m_send_buffers, I, J, K); }
+
         template <int I, int J, int K>
         void post_receive() {
-            if (m_recv_buffers.size(I, J, K)) {
+            if (m_recv_buffers.size(I, J, K) && !recv_on_node(I, J, K)) {
 #ifdef GT_VERBOSE
                 std::cout << "@" << gridtools::PID << "@ IRECV (" << I << "," << J << "," << K << ") "
                           << " P " << m_proc_grid.template proc<I, J, K>() << " - "
@@ -268,7 +521,7 @@ namespace gridtools {
 
                 MPI_Irecv(static_cast<char *>(m_recv_buffers.buffer(I, J, K)),
                     m_recv_buffers.size(I, J, K),
-                    MPI_CHAR,
+                    m_recv_buffers.type(I, J, K),
                     m_proc_grid.template proc<I, J, K>(),
                     TAG<-I, -J, -K>::value,
                     get_communicator(m_proc_grid),
@@ -288,7 +541,7 @@ namespace gridtools {
 
         template <int I, int J, int K>
         void perform_isend() {
-            if (m_send_buffers.size(I, J, K)) {
+            if (m_send_buffers.size(I, J, K) && !send_on_node(I, J, K)) {
 #ifdef GT_VERBOSE
                 std::cout << "@" << gridtools::PID << "@ ISEND (" << I << "," << J << "," << K << ") "
                           << " P " << m_proc_grid.template proc<I, J, K>() << " - "
@@ -303,7 +556,7 @@ namespace gridtools {
 
                 MPI_Isend(static_cast<char *>(m_send_buffers.buffer(I, J, K)),
                     m_send_buffers.size(I, J, K),
-                    MPI_CHAR,
+                    m_send_buffers.type(I, J, K),
                     m_proc_grid.template proc<I, J, K>(),
                     TAG<I, J, K>::value,
                     get_communicator(m_proc_grid),
@@ -351,7 +604,7 @@ namespace gridtools {
 
         template <int I, int J, int K>
         void wait() {
-            if (m_recv_buffers.size(I, J, K)) {
+            if (m_recv_buffers.size(I, J, K) && !recv_on_node(I, J, K)) {
 #ifdef GT_VERBOSE
                 std::cout << "@" << gridtools::PID << "@ WAIT  (" << I << "," << J << "," << K << ") "
                           << " R " << translate()(-I, -J, -K) << "\n";
@@ -444,8 +697,12 @@ namespace gridtools {
 //                 << " (" << translate()(I,J,K) << ")\n";
 #endif
 
+            if (m_send_buffers.buffer(I, J, K) != p || m_send_buffers.size(I, J, K) != s ||
+                m_send_buffers.type(I, J, K) != MPI_CHAR)
+                m_persistent_sends.invalidate();
             m_send_buffers.buffer(I, J, K) = reinterpret_cast<char *>(p);
             m_send_buffers.size(I, J, K) = s;
+            m_send_buffers.type(I, J, K) = MPI_CHAR;
         }
 
         /** Function to register send buffers with the communication patter.
@@ -507,8 +764,12 @@ namespace gridtools {
 //                 <<  " (" << translate()(I,J,K) << ")\n";
 #endif
 
+            if (m_recv_buffers.buffer(I, J, K) != p || m_recv_buffers.size(I, J, K) != s ||
+                m_recv_buffers.type(I, J, K) != MPI_CHAR)
+                m_persistent_recvs.invalidate();
             m_recv_buffers.buffer(I, J, K) = reinterpret_cast<char *>(p);
             m_recv_buffers.size(I, J, K) = s;
+            m_recv_buffers.type(I, J, K) = MPI_CHAR;
         }
 
         /** Function to register buffers for received data with the communication patter.
@@ -539,6 +800,49 @@ namespace gridtools {
             register_receive_from_buffer(p, s, I, J, K);
         }
 
+        /** Function to register a committed MPI datatype describing the data to be sent to neighbor I, J, K
+            in place of a contiguous buffer. One element of the datatype is sent from address p, which may be
+            MPI_BOTTOM for datatypes built on absolute addresses. MPI_DATATYPE_NULL sends nothing. The datatype
+            is not owned by the pattern and must stay valid until it is replaced. Registering a datatype always
+            recreates the persistent requests, since a datatype handle may be reused after being freed.
+
+           \param[in] p Address the datatype is relative to
+           \param[in] t Committed MPI datatype, or MPI_DATATYPE_NULL
+           \param[in] I Relative coordinates of the receiving process along the first dimension
+           \param[in] J Relative coordinates of the receiving process along the second dimension
+           \param[in] K Relative coordinates of the receiving process along the third dimension
+        */
+        void register_send_to_datatype(void *p, MPI_Datatype t, int I, int J, int K) {
+            assert((I >= -1 && I <= 1));
+            assert((J >= -1 && J <= 1));
+            assert((K >= -1 && K <= 1));
+
+            m_persistent_sends.invalidate();
+            m_send_buffers.buffer(I, J, K) = reinterpret_cast<char *>(p);
+            m_send_buffers.size(I, J, K) = t != MPI_DATATYPE_NULL ? 1 : 0;
+            m_send_buffers.type(I, J, K) = t;
+        }
+
+        /** Function to register a committed MPI datatype describing where the data received from neighbor I, J, K
+            is stored, in place of a contiguous buffer. See register_send_to_datatype.
+
+           \param[in] p Address the datatype is relative to
+           \param[in] t Committed MPI datatype, or MPI_DATATYPE_NULL
+           \param[in] I Relative coordinates of the sending process along the first dimension
+           \param[in] J Relative coordinates of the sending process along the second dimension
+           \param[in] K Relative coordinates of the sending process along the third dimension
+        */
+        void register_receive_from_datatype(void *p, MPI_Datatype t, int I, int J, int K) {
+            assert((I >= -1 && I <= 1));
+            assert((J >= -1 && J <= 1));
+            assert((K >= -1 && K <= 1));
+
+            m_persistent_recvs.invalidate();
+            m_recv_buffers.buffer(I, J, K) = reinterpret_cast<char *>(p);
+            m_recv_buffers.size(I, J, K) = t != MPI_DATATYPE_NULL ? 1 : 0;
+            m_recv_buffers.type(I, J, K) = t;
+        }
+
         /* Setting sizes */
 
         /** Function to set send buffers sizes if the size must be updated
@@ -561,6 +865,8 @@ namespace gridtools {
             assert((J >= -1 && J <= 1));
             assert((K >= -1 && K <= 1));
 
+            if (m_send_buffers.size(I, J, K) != s)
+                m_persistent_sends.invalidate();
             m_send_buffers.size(I, J, K) = s;
         }
 
@@ -611,6 +917,8 @@ namespace gridtools {
             assert((J >= -1 && J <= 1));
             assert((K >= -1 && K <= 1));
 
+            if (m_recv_buffers.size(I, J, K) != s)
+                m_persistent_recvs.invalidate();
             m_recv_buffers.size(I, J, K) = s;
         }
 
@@ -667,7 +975,89 @@ namespace gridtools {
             wait();
         }
 
+        /** Switches between posting new non-blocking receives and sends at every exchange (the default) and
+            starting persistent requests that are created once for the registered buffers and sizes. Must not be
+            called while an exchange is in progress.
+
+            \param[in] value true to use persistent requests
+        */
+        void set_persistent_requests(bool value) {
+            m_use_persistent = value;
+            if (!value) {
+                m_persistent_recvs.clear();
+                m_persistent_sends.clear();
+            }
+        }
+
+        /** Returns true if the exchanges use persistent requests, see set_persistent_requests.
+         */
+        bool persistent_requests() const { return m_use_persistent; }
+
+        /** Moves the send buffers into an MPI-3 shared memory window among the ranks on the same node, allocating
+            for each neighbor a buffer of the size in bytes currently registered with register_send_to_buffer. The
+            new buffers replace the registered ones and can be retrieved with send_buffer. The data sent to the
+            neighbors on the same node is then read by them directly from the send buffers (see shared_source),
+            without MPI messages: before packing, the send buffers have to be acquired with
+            acquire_shared_send_buffers, and after unpacking, the sources released with release_shared_sources.
+            Data from other neighbors is exchanged as before. Collective over the communicator of the process grid.
+        */
+        void allocate_shared_send_buffers() {
+            int sizes[27];
+            int procs[27];
+            for (int i = -1; i <= 1; ++i)
+                for (int j = -1; j <= 1; ++j)
+                    for (int k = -1; k <= 1; ++k) {
+                        sizes[translate()(i, j, k)] = m_send_buffers.size(i, j, k);
+                        procs[translate()(i, j, k)] = m_proc_grid.proc(i, j, k);
+                    }
+            m_shared = std::make_shared<shared_send_buffers>(get_communicator(m_proc_grid), sizes, procs);
+            for (int i = -1; i <= 1; ++i)
+                for (int j = -1; j <= 1; ++j)
+                    for (int k = -1; k <= 1; ++k)
+                        if (i != 0 || j != 0 || k != 0)
+                            register_send_to_buffer(m_shared->buffer(i, j, k), sizes[translate()(i, j, k)], i, j, k);
+        }
+
+        /** Returns true if the send buffers are in a shared memory window, see allocate_shared_send_buffers.
+         */
+        bool shared_send_buffers_allocated() const { return static_cast<bool>(m_shared); }
+
+        /** Send buffer of neighbor I, J, K holding the data for this rank if it is on the same node and the send
+            buffers are shared, nullptr otherwise. It holds the received data from wait until release_shared_sources.
+        */
+        void *shared_source(int I, int J, int K) const { return m_shared ? m_shared->source(I, J, K) : nullptr; }
+
+        /** Waits until the neighbors on the same node have read the data of the previous exchange from the shared
+            send buffers, which may then be packed. Implies release_shared_sources.
+        */
+        void acquire_shared_send_buffers() {
+            if (m_shared)
+                m_shared->acquire_buffers();
+        }
+
+        /** Lets the neighbors on the same node overwrite the shared send buffers read by this rank since wait.
+         */
+        void release_shared_sources() const {
+            if (m_shared)
+                m_shared->release_sources();
+        }
+
+        /** Retrieve the send buffer registered for neighbor I, J, K.
+
+            \param[in] I Relative coordinates of the receiving process along the first dimension
+            \param[in] J Relative coordinates of the receiving process along the second dimension
+            \param[in] K Relative coordinates of the receiving process along the third dimension
+        */
+        void *send_buffer(int I, int J, int K) { return m_send_buffers.buffer(I, J, K); }
+
         void post_receives() {
+            if (m_use_persistent) {
+                if (!m_persistent_recvs.valid())
+                    init_persistent_receives();
+                m_persistent_recvs.start();
+                return;
+            }
+
             /* Posting receives face -1
              */
             if (m_proc_grid.template proc<1, 0, -1>() != -1) {
@@ -786,6 +1176,16 @@ namespace gridtools {
         }
 
         void do_sends() {
+            if (m_shared)
+                m_shared->post_buffers();
+
+            if (m_use_persistent) {
+                if (!m_persistent_sends.valid())
+                    init_persistent_sends();
+                m_persistent_sends.start();
+                return;
+            }
+
             /* Sending data face -1
              */
             if (m_proc_grid.template proc<-1, 0, -1>() != -1) {
@@ -934,6 +1334,15 @@ namespace gridtools {
         }
 
         void wait() {
+            // the data of the neighbors on the node is unpacked directly from their send buffers
+            if (m_shared)
+                m_shared->acquire_sources();
+
+            if (m_use_persistent) {
+                m_persistent_sends.wait();
+                m_persistent_recvs.wait();
+                return;
+            }
 
             wait_for_sends();
 
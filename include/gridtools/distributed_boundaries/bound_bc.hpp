@@ -10,12 +10,15 @@
 
 #pragma once
 
+#include <algorithm>
 #include <functional>
 #include <tuple>
 #include <type_traits>
 
 #include "../boundary_conditions/boundary.hpp"
+#include "../common/array.hpp"
 #include "../common/halo_descriptor.hpp"
+#include "../stencil_composition/extent.hpp"
 
 namespace gridtools {
     namespace _impl {
@@ -212,6 +215,8 @@ namespace gridtools {
       private:
         boundary_class m_bcapply;
         stores_type m_stores;
+        bool m_has_halos = false;
+        array<halo_descriptor, 3> m_halos;
 
       public:
         /**
@@ -246,6 +251,32 @@ namespace gridtools {
          */
         boundary_class boundary_to_apply() const { return m_bcapply; }
 
+        /**
+         * @brief Returns a copy of this bound_bc whose data stores are exchanged, and have the boundary condition
+         * applied, with the given halos instead of the ones of gridtools::distributed_boundaries. This allows data
+         * stores needing narrower halos to be exchanged in the same messages as the others, without sending the
+         * halo widths they do not need. Each halo must have the same begin, end and total length as the one of
+         * gridtools::distributed_boundaries in the same dimension, and widths not larger than it.
+         *
+         * \param halos array of 3 gridtools::halo_descriptor with the halos of the data stores of this job
+         */
+        bound_bc with_halos(array<halo_descriptor, 3> const &halos) const {
+            bound_bc res = *this;
+            res.m_has_halos = true;
+            res.m_halos = halos;
+            return res;
+        }
+
+        /**
+         * @brief Returns true if the halos of this job have been set with gridtools::bound_bc::with_halos
+         */
+        bool has_halos() const { return m_has_halos; }
+
+        /**
+         * @brief Returns the halos set with gridtools::bound_bc::with_halos
+         */
+        array<halo_descriptor, 3> const &halos() const { return m_halos; }
+
         /**
          * @brief In the case in which the DataStores passed as template to the bound_bc class
          * contains placeholders, this member function will return a bound_bc object in which
@@ -267,8 +298,9 @@ namespace gridtools {
             auto full_list = _impl::substitute_placeholders(
                 ro_store_tuple, m_stores, meta::make_index_sequence<std::tuple_size<decltype(m_stores)>::value>{});
 
-            return bound_bc<BCApply, decltype(full_list), typename _impl::comm_indices<stores_type>::type>{
+            bound_bc<BCApply, decltype(full_list), typename _impl::comm_indices<stores_type>::type> res{
                 m_bcapply, wstd::move(full_list)};
+            return m_has_halos ? res.with_halos(m_halos) : res;
         }
     };
 
@@ -306,6 +338,61 @@ namespace gridtools {
     template <typename... T>
     struct is_bound_bc<bound_bc<T...>> : std::true_type {};
 
+    /**
+     * @brief A data store to be exchanged by gridtools::distributed_boundaries with its own halos instead of the ones
+     * of gridtools::distributed_boundaries, as gridtools::bound_bc::with_halos does for the data stores of a boundary
+     * condition. Built by gridtools::with_halos.
+     */
+    template <typename DataStore>
+    struct store_with_halos {
+        DataStore store;
+        array<halo_descriptor, 3> halos;
+    };
+
+    /**
+     * @brief Free-standing function used to make a data store to be exchanged with the given halos, see
+     * gridtools::store_with_halos.
+     *
+     * \param store The data store
+     * \param halos array of 3 gridtools::halo_descriptor with the halos of the data store
+     */
+    template <typename DataStore>
+    store_with_halos<typename std::decay<DataStore>::type> with_halos(
+        DataStore &&store, array<halo_descriptor, 3> const &halos) {
+        return {std::forward<DataStore>(store), halos};
+    }
+
+    /** @brief Metafunctions to query if a type is a store_with_halos
+     */
+    template <typename T>
+    struct is_store_with_halos : std::false_type {};
+
+    template <typename DataStore>
+    struct is_store_with_halos<store_with_halos<DataStore>> : std::true_type {};
+
+    /**
+     * @brief Returns the halos as wide as the given extent, e.g. from gridtools::computation::get_arg_extent, so that a
+     * data store is exchanged exactly as deep as it is read on each side. Extents are often asymmetric: an upwind
+     * stencil reading only at negative offsets in i needs no halo on the plus side. The widths are limited to the ones
+     * of the given halos, since points beyond them are not exchanged anyway (e.g. vertical extents with no halo in k).
+     *
+     * \param extent The extent at which a data store is read
+     * \param halos array of 3 gridtools::halo_descriptor with the widest halos, from which begin, end and total length
+     * are taken
+     */
+    inline array<halo_descriptor, 3> extent_halos(rt_extent const &extent, array<halo_descriptor, 3> const &halos) {
+        auto halo = [](int_t minus, int_t plus, halo_descriptor const &h) {
+            return halo_descriptor(std::min<int_t>(h.minus(), std::max<int_t>(0, -minus)),
+                std::min<int_t>(h.plus(), std::max<int_t>(0, plus)),
+                h.begin(),
+                h.end(),
+                h.total_length());
+        };
+        return {halo(extent.iminus, extent.iplus, halos[0]),
+            halo(extent.jminus, extent.jplus, halos[1]),
+            halo(extent.kminus, extent.kplus, halos[2])};
+    }
+
     /** @} */
 
 } // namespace gridtools
@@ -13,6 +13,8 @@
 /** \defgroup Distributed-Boundaries Distributed Boundary Conditions
  */
 
+#include <vector>
+
 #include "../boundary_conditions/predicate.hpp"
 #include "../common/boollist.hpp"
 #include "../common/halo_descriptor.hpp"
@@ -98,6 +100,13 @@ namespace gridtools {
                           d);
         \endverbatim
 
+        The exchange can also be split in two phases to overlap the communication with computation:
+        gridtools::distributed_boundaries::start_exchange packs the halos, starts the communication and applies the
+        boundary conditions on the faces that do not communicate while the messages are in flight;
+        gridtools::distributed_boundaries::wait completes the communication and unpacks. Both take the same jobs.
+        Since the boundary conditions are applied before the halos are received, they must not read the communicated
+        parts of the halos.
+
         \tparam CTraits Communication traits. To see an example see gridtools::comm_traits
     */
     template <typename CTraits>
@@ -119,6 +128,9 @@ namespace gridtools {
         performance_meter_t m_meter_pack;
         performance_meter_t m_meter_exchange;
         performance_meter_t m_meter_bc;
+        performance_meter_t m_meter_wait;
+
+        bool m_in_flight = false;
 
       public:
         /**
@@ -136,7 +148,7 @@ namespace gridtools {
             array<halo_descriptor, 3> halos, boollist<3> period, uint_t max_stores, MPI_Comm CartComm)
             : m_halos{halos}, m_sizes{0, 0, 0}, m_max_stores{max_stores}, m_he(period, CartComm),
               m_meter_pack("pack/unpack       "), m_meter_exchange("exchange          "),
-              m_meter_bc("boundary condition") {
+              m_meter_bc("boundary condition"), m_meter_wait("wait              ") {
 
             m_he.pattern().proc_grid().fill_dims(m_sizes);
 
@@ -185,56 +197,127 @@ namespace gridtools {
         */
         template <typename... Jobs>
         void exchange(Jobs const &... jobs) {
-#ifdef __CUDACC__
-            // Workaround for cuda to handle tuple_cat. Compilation is a little slower.
-            // This can be removed when nvcc supports it.
-            auto all_stores_for_exc = _workaround::tuple_cat(collect_stores(jobs)...);
-#else
-            auto all_stores_for_exc = std::tuple_cat(collect_stores(jobs)...);
-#endif
-            if (m_max_stores < std::tuple_size<decltype(all_stores_for_exc)>::value) {
-                std::string err{"Too many data stores to be exchanged" +
-                                std::to_string(std::tuple_size<decltype(all_stores_for_exc)>::value) +
-                                " instead of the maximum allowed, which is " + std::to_string(m_max_stores)};
-                throw std::runtime_error(err);
-            }
+            assert_not_in_flight();
+            auto all_stores_for_exc = exchanged_stores(jobs...);
 
             m_meter_pack.start();
-            call_pack(all_stores_for_exc,
-                meta::make_integer_sequence<uint_t, std::tuple_size<decltype(all_stores_for_exc)>::value>{});
+            pack_stores(all_stores_for_exc, jobs...);
             m_meter_pack.pause();
+            // nothing overlaps a synchronous exchange, all of it is waiting
             m_meter_exchange.start();
+            m_meter_wait.start();
             m_he.exchange();
+            m_meter_wait.pause();
             m_meter_exchange.pause();
             m_meter_pack.start();
-            call_unpack(all_stores_for_exc,
-                meta::make_integer_sequence<uint_t, std::tuple_size<decltype(all_stores_for_exc)>::value>{});
+            unpack_stores(all_stores_for_exc, jobs...);
             m_meter_pack.pause();
 
             boundary_only(jobs...);
         }
 
+        /**
+            @brief First phase of a split exchange: packs the halos of the data_stores to be communicated, starts the
+            communication and applies the boundary conditions while the messages are in flight. The caller can
+            then compute on data that does not depend on the halos before calling
+            gridtools::distributed_boundaries::wait with the same jobs.
+
+            \param jobs Variadic list of jobs
+        */
+        template <typename... Jobs>
+        void start_exchange(Jobs const &... jobs) {
+            assert_not_in_flight();
+            auto all_stores_for_exc = exchanged_stores(jobs...);
+
+            m_meter_pack.start();
+            pack_stores(all_stores_for_exc, jobs...);
+            m_meter_pack.pause();
+            m_meter_exchange.start();
+            m_he.start_exchange();
+            m_in_flight = true;
+
+            boundary_only(jobs...);
+        }
+
+        /**
+            @brief Second phase of a split exchange: waits for the communication started by
+            gridtools::distributed_boundaries::start_exchange and unpacks the received halos.
+
+            \param jobs Variadic list of jobs, the same as passed to start_exchange
+        */
+        template <typename... Jobs>
+        void wait(Jobs const &... jobs) {
+            if (!m_in_flight)
+                throw std::runtime_error("distributed_boundaries::wait called without a started exchange");
+            auto all_stores_for_exc = exchanged_stores(jobs...);
+
+            m_meter_wait.start();
+            m_he.wait();
+            m_meter_wait.pause();
+            m_meter_exchange.pause();
+            m_in_flight = false;
+            m_meter_pack.start();
+            unpack_stores(all_stores_for_exc, jobs...);
+            m_meter_pack.pause();
+        }
+
+        /**
+            @brief Member function to perform the halo update of data stores read by a computation, each exchanged
+            exactly as deep as the computation reads it on each side (see gridtools::computation::get_arg_extent)
+            instead of with the halos given at construction. The data stores are passed as to the run member of the
+            computation, as placeholder-data store pairs. No boundary condition is applied; jobs with boundary
+            conditions can get their halos with gridtools::extent_halos and gridtools::bound_bc::with_halos.
+
+            \param comp The computation that will read the data stores
+            \param arg_storage_pairs Variadic list of placeholders of comp associated to data stores
+        */
+        template <typename Computation, typename... ArgStoragePairs>
+        void exchange_for(Computation const &comp, ArgStoragePairs const &... arg_storage_pairs) {
+            exchange(with_halos(arg_storage_pairs.m_value,
+                extent_halos(comp.get_arg_extent(typename ArgStoragePairs::arg_t()), m_halos))...);
+        }
+
         typename pattern_type::grid_type const &proc_grid() const { return m_he.comm(); }
 
         std::string print_meters() const {
-            return m_meter_pack.to_string() + "\n" + m_meter_exchange.to_string() + "\n" + m_meter_bc.to_string();
+            return m_meter_pack.to_string() + "\n" + m_meter_exchange.to_string() + "\n" + m_meter_wait.to_string() +
+                   "\n" + m_meter_bc.to_string() + "\noverlap efficiency\t" +
+                   std::to_string(get_overlap_efficiency());
         }
 
-        double get_time_pack() const { return m_meter_pack.get_time(); }
-        double get_time_exchange() const { return m_meter_exchange.get_time(); }
-        double get_time_boundary() const { return m_meter_bc.get_time(); }
+        double get_time_pack() const { return m_meter_pack.total_time(); }
+        /// time from the start of the communication to its completion
+        double get_time_exchange() const { return m_meter_exchange.total_time(); }
+        /// time spent blocking on the completion of the communication
+        double get_time_wait() const { return m_meter_wait.total_time(); }
+        double get_time_boundary() const { return m_meter_bc.total_time(); }
+
+        /**
+            @brief Fraction of the communication time that was hidden behind other work, i.e. not spent waiting for
+            the communication to complete. Zero for synchronous exchanges.
+        */
+        double get_overlap_efficiency() const {
+            double exchange = get_time_exchange();
+            return exchange > 0 ? 1 - get_time_wait() / exchange : 0;
+        }
 
-        size_t get_count_exchange() const { return m_meter_exchange.get_count(); }
+        size_t get_count_exchange() const { return m_meter_exchange.count(); }
         // no get_count_pack() as it is equivalent to get_count_exchange()
-        size_t get_count_boundary() const { return m_meter_bc.get_count(); }
+        size_t get_count_boundary() const { return m_meter_bc.count(); }
 
         void reset_meters() {
-            m_meter_pack.reset_meter();
-            m_meter_exchange.reset_meter();
-            m_meter_bc.reset_meter();
+            m_meter_pack.reset();
+            m_meter_exchange.reset();
+            m_meter_wait.reset();
+            m_meter_bc.reset();
         }
 
       private:
+        void assert_not_in_flight() const {
+            if (m_in_flight)
+                throw std::runtime_error("distributed_boundaries: the previous exchange has not been waited for");
+        }
+
         template <typename BoundaryApply, typename ArgsTuple, uint_t... Ids>
         static void call_apply(
             BoundaryApply boundary_apply, ArgsTuple const &args, meta::integer_sequence<uint_t, Ids...>) {
@@ -246,7 +329,8 @@ namespace gridtools {
             /*Apply boundary to data*/
             call_apply(boundary<typename BCApply::boundary_class,
                            typename CTraits::compute_arch,
-                           proc_grid_predicate<typename pattern_type::grid_type>>(m_halos,
+                           proc_grid_predicate<typename pattern_type::grid_type>>(
+                           bcapply.has_halos() ? bcapply.halos() : m_halos,
                            bcapply.boundary_to_apply(),
                            proc_grid_predicate<typename pattern_type::grid_type>(m_he.comm())),
                 bcapply.stores(),
@@ -267,11 +351,123 @@ namespace gridtools {
 
         template <typename FirstJob>
         static auto collect_stores(FirstJob const &first_job,
-            typename std::enable_if<not is_bound_bc<FirstJob>::value, void *>::type = nullptr)
-            -> decltype(std::make_tuple(first_job)) {
+            typename std::enable_if<is_store_with_halos<FirstJob>::value, void *>::type = nullptr)
+            -> decltype(std::make_tuple(first_job.store)) {
+            return std::make_tuple(first_job.store);
+        }
+
+        template <typename FirstJob>
+        static auto collect_stores(FirstJob const &first_job,
+            typename std::enable_if<not is_bound_bc<FirstJob>::value and not is_store_with_halos<FirstJob>::value,
+                void *>::type = nullptr) -> decltype(std::make_tuple(first_job)) {
             return std::make_tuple(first_job);
         }
 
+        template <typename... Jobs>
+        auto exchanged_stores(Jobs const &... jobs) const
+#ifdef __CUDACC__
+            // Workaround for cuda to handle tuple_cat. Compilation is a little slower.
+            // This can be removed when nvcc supports it.
+            -> decltype(_workaround::tuple_cat(collect_stores(jobs)...)) {
+            auto res = _workaround::tuple_cat(collect_stores(jobs)...);
+#else
+            -> decltype(std::tuple_cat(collect_stores(jobs)...)) {
+            auto res = std::tuple_cat(collect_stores(jobs)...);
+#endif
+            if (m_max_stores < std::tuple_size<decltype(res)>::value) {
+                std::string err{"Too many data stores to be exchanged" +
+                                std::to_string(std::tuple_size<decltype(res)>::value) +
+                                " instead of the maximum allowed, which is " + std::to_string(m_max_stores)};
+                throw std::runtime_error(err);
+            }
+            return res;
+        }
+
+        template <typename Job>
+        static typename std::enable_if<is_bound_bc<Job>::value, bool>::type job_has_halos(Job const &job) {
+            return job.has_halos();
+        }
+
+        template <typename Job>
+        static typename std::enable_if<is_store_with_halos<Job>::value, bool>::type job_has_halos(Job const &) {
+            return true;
+        }
+
+        template <typename Job>
+        static typename std::enable_if<not is_bound_bc<Job>::value and not is_store_with_halos<Job>::value, bool>::type
+        job_has_halos(Job const &) {
+            return false;
+        }
+
+        template <typename... Jobs>
+        static bool any_job_has_halos(Jobs const &... jobs) {
+            bool res = false;
+            using execute_in_order = int[];
+            (void)execute_in_order{0, (res = res || job_has_halos(jobs), 0)...};
+            return res;
+        }
+
+        void check_halos(array<halo_descriptor, 3> const &halos) const {
+            for (int d = 0; d < 3; ++d) {
+                halo_descriptor const &h = halos[d];
+                if (h.begin() != m_halos[d].begin() || h.end() != m_halos[d].end() ||
+                    h.total_length() != m_halos[d].total_length() || h.minus() > m_halos[d].minus() ||
+                    h.plus() > m_halos[d].plus())
+                    throw std::runtime_error("distributed_boundaries: the halos of a job in dimension " +
+                                             std::to_string(d) + " do not fit in the halos of the pattern");
+            }
+        }
+
+        template <typename Job>
+        typename std::enable_if<is_bound_bc<Job>::value, void>::type append_halos(
+            std::vector<array<halo_descriptor, 3>> &halos, Job const &job) const {
+            if (job.has_halos())
+                check_halos(job.halos());
+            halos.insert(halos.end(),
+                std::tuple_size<typename Job::exc_stores_type>::value,
+                job.has_halos() ? job.halos() : m_halos);
+        }
+
+        template <typename Job>
+        typename std::enable_if<is_store_with_halos<Job>::value, void>::type append_halos(
+            std::vector<array<halo_descriptor, 3>> &halos, Job const &job) const {
+            check_halos(job.halos);
+            halos.push_back(job.halos);
+        }
+
+        template <typename Job>
+        typename std::enable_if<not is_bound_bc<Job>::value and not is_store_with_halos<Job>::value, void>::type
+        append_halos(std::vector<array<halo_descriptor, 3>> &halos, Job const &) const {
+            halos.push_back(m_halos);
+        }
+
+        /** The halos of each of the data stores exchanged for the jobs, in the order of exchanged_stores */
+        template <typename... Jobs>
+        std::vector<array<halo_descriptor, 3>> stores_halos(Jobs const &... jobs) const {
+            std::vector<array<halo_descriptor, 3>> res;
+            using execute_in_order = int[];
+            (void)execute_in_order{0, (append_halos(res, jobs), 0)...};
+            return res;
+        }
+
+        template <typename Stores, typename... Jobs>
+        void pack_stores(Stores const &stores, Jobs const &... jobs) {
+            using ids_t = meta::make_integer_sequence<uint_t, std::tuple_size<Stores>::value>;
+            if (any_job_has_halos(jobs...))
+                call_pack_halos(stores, stores_halos(jobs...), ids_t{});
+            else
+                call_pack(stores, ids_t{});
+        }
+
+        template <typename Stores, typename... Jobs>
+        void unpack_stores(Stores const &stores, Jobs const &... jobs) {
+            using ids_t = meta::make_integer_sequence<uint_t, std::tuple_size<Stores>::value>;
+            if (any_job_has_halos(jobs...))
+                call_unpack_halos(stores, stores_halos(jobs...), ids_t{});
+            else
+                call_unpack(stores, ids_t{});
+        }
+
         template <typename Stores, uint_t... Ids>
         void call_pack(Stores const &stores, meta::integer_sequence<uint_t, Ids...>) {
             m_he.pack(advanced::get_raw_pointer_of(_impl::proper_view<typename CTraits::compute_arch,
@@ -293,6 +489,30 @@ namespace gridtools {
 
         template <typename Stores, uint_t... Ids>
         static void call_unpack(Stores const &stores, meta::integer_sequence<uint_t>) {}
+
+        template <typename Stores, uint_t... Ids>
+        void call_pack_halos(Stores const &stores,
+            std::vector<array<halo_descriptor, 3>> const &halos,
+            meta::integer_sequence<uint_t, Ids...>) {
+            m_he.pack(std::vector<typename CTraits::value_type *>{
+                          advanced::get_raw_pointer_of(_impl::proper_view<typename CTraits::compute_arch,
+                              access_mode::read_write,
+                              typename std::decay<typename std::tuple_element<Ids, Stores>::type>::type>::
+                                  make(std::get<Ids>(stores)))...},
+                halos);
+        }
+
+        template <typename Stores, uint_t... Ids>
+        void call_unpack_halos(Stores const &stores,
+            std::vector<array<halo_descriptor, 3>> const &halos,
+            meta::integer_sequence<uint_t, Ids...>) {
+            m_he.unpack(std::vector<typename CTraits::value_type *>{
+                            advanced::get_raw_pointer_of(_impl::proper_view<typename CTraits::compute_arch,
+                                access_mode::read_write,
+                                typename std::decay<typename std::tuple_element<Ids, Stores>::type>::type>::
+                                    make(std::get<Ids>(stores)))...},
+                halos);
+        }
     };
 
     /** @} */
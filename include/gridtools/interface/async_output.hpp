@@ -0,0 +1,257 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+#include "../common/defs.hpp"
+#include "../common/hugepage_alloc.hpp"
+#include "../storage/common/storage_info_rt.hpp"
+
+namespace gridtools {
+
+    /**
+     * @brief Snapshot of a data store, as passed to the writer of an async_output.
+     */
+    struct output_field {
+        std::string name;
+        std::size_t step;
+        std::string type; // typeid of the element type
+        std::size_t element_size;
+        storage_info_rt info;
+        void const *data; // padded memory of the data store, see storage_info_rt
+        std::size_t size; // in bytes
+    };
+
+    /**
+     * @brief Writer for async_output, writing every field to the raw file <prefix><name>.<step>.
+     */
+    struct raw_file_writer {
+        std::string prefix;
+
+        void operator()(output_field const &field) const {
+            std::string path = prefix + field.name + "." + std::to_string(field.step);
+            std::ofstream out(path, std::ios::binary);
+            out.write(static_cast<char const *>(field.data), field.size);
+            if (!out)
+                throw std::runtime_error("cannot write " + path);
+        }
+    };
+
+    /**
+     * @brief Output of data stores by a background thread.
+     *
+     * snapshot copies the data stores into staging buffers and returns, while a background thread passes the copies
+     * to the writer. Thus the caller only pays for the copies, which are done by all OpenMP threads. The staging
+     * buffers are taken from a pool and reused; if the snapshot does not fit into the pool, because the previous ones
+     * are still being written, snapshot waits until enough buffers are written (back-pressure). A field larger than
+     * the pool is taken as soon as nothing else is pending.
+     *
+     * Exceptions thrown by the writer are rethrown by the next call to snapshot or flush. The destructor waits until
+     * all snapshots are written, but cannot throw: call flush before destroying the output to handle the errors of
+     * the last snapshots. An error that has not been rethrown is printed to std::cerr by the destructor.
+     */
+    class async_output {
+        using holder_t = std::unique_ptr<void, std::integral_constant<decltype(&hugepage_free), &hugepage_free>>;
+
+        struct buffer {
+            holder_t ptr;
+            std::size_t capacity;
+        };
+
+        struct job {
+            output_field field;
+            buffer staging;
+        };
+
+        std::function<void(output_field const &)> m_writer;
+        std::size_t m_pool_size;
+        std::size_t m_pending = 0;  // bytes of the snapshots that are not written yet
+        std::size_t m_reserved = 0; // bytes of all staging buffers
+        std::vector<buffer> m_free;
+        std::deque<job> m_queue;
+        bool m_writing = false;
+        bool m_stop = false;
+        std::exception_ptr m_error;
+        mutable std::mutex m_mutex;
+        std::condition_variable m_cv;
+        std::thread m_thread;
+
+        void rethrow_error() {
+            if (m_error) {
+                auto error = m_error;
+                m_error = nullptr;
+                std::rethrow_exception(error);
+            }
+        }
+
+        buffer acquire(std::unique_lock<std::mutex> &lock, std::size_t size) {
+            m_cv.wait(lock, [&] { return m_error || m_pending == 0 || m_pending + size <= m_pool_size; });
+            rethrow_error();
+            m_pending += size;
+            // the smallest free buffer that is large enough
+            auto best = m_free.end();
+            for (auto it = m_free.begin(); it != m_free.end(); ++it)
+                if (it->capacity >= size && (best == m_free.end() || it->capacity < best->capacity))
+                    best = it;
+            if (best != m_free.end()) {
+                buffer res = std::move(*best);
+                m_free.erase(best);
+                return res;
+            }
+            // release free buffers to stay within the pool size
+            std::sort(m_free.begin(), m_free.end(), [](buffer const &a, buffer const &b) {
+                return a.capacity > b.capacity;
+            });
+            while (!m_free.empty() && m_reserved + size > m_pool_size) {
+                m_reserved -= m_free.back().capacity;
+                m_free.pop_back();
+            }
+            m_reserved += size;
+            return {holder_t(hugepage_alloc(size)), size};
+        }
+
+        static void copy(void *dst, void const *src, std::size_t size) {
+            constexpr std::size_t chunk_size = 1 << 20;
+            int chunks = (size + chunk_size - 1) / chunk_size;
+#ifdef _OPENMP
+#pragma omp parallel for if (chunks > 1)
+#endif
+            for (int i = 0; i < chunks; ++i) {
+                std::size_t first = i * chunk_size;
+                std::memcpy(static_cast<char *>(dst) + first,
+                    static_cast<char const *>(src) + first,
+                    std::min(chunk_size, size - first));
+            }
+        }
+
+        template <class DataStore>
+        void snapshot_one(std::size_t step, DataStore const &ds) {
+            using data_t = typename DataStore::data_t;
+            // bring the host copy up to date
+            ds.sync();
+            std::size_t size = ds.padded_total_length() * sizeof(data_t);
+            buffer staging;
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                staging = acquire(lock, size);
+            }
+            copy(staging.ptr.get(), ds.get_storage_ptr()->get_cpu_ptr(), size);
+            output_field field = {
+                ds.name(), step, typeid(data_t).name(), sizeof(data_t), make_storage_info_rt(ds.info()), nullptr, size};
+            field.data = staging.ptr.get();
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_queue.push_back({std::move(field), std::move(staging)});
+            }
+            m_cv.notify_all();
+        }
+
+        void run() {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            while (true) {
+                m_cv.wait(lock, [&] { return m_stop || !m_queue.empty(); });
+                if (m_queue.empty())
+                    return;
+                job current = std::move(m_queue.front());
+                m_queue.pop_front();
+                m_writing = true;
+                lock.unlock();
+                std::exception_ptr error;
+                try {
+                    m_writer(current.field);
+                } catch (...) {
+                    error = std::current_exception();
+                }
+                lock.lock();
+                if (error && !m_error)
+                    m_error = error;
+                m_writing = false;
+                m_pending -= current.field.size;
+                m_free.push_back(std::move(current.staging));
+                m_cv.notify_all();
+            }
+        }
+
+      public:
+        /**
+         * @param writer Called by the background thread for every snapshot of a data store, in order
+         * @param pool_size Size of the staging buffers in bytes, at least the size of a snapshot to allow for
+         * computing while the previous snapshot is written
+         */
+        async_output(std::function<void(output_field const &)> writer, std::size_t pool_size)
+            : m_writer(std::move(writer)), m_pool_size(pool_size), m_thread(&async_output::run, this) {}
+
+        async_output(async_output const &) = delete;
+        async_output &operator=(async_output const &) = delete;
+
+        ~async_output() {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stop = true;
+            }
+            m_cv.notify_all();
+            m_thread.join();
+            if (m_error) {
+                try {
+                    std::rethrow_exception(m_error);
+                } catch (std::exception const &e) {
+                    std::cerr << "async_output: unreported writer error: " << e.what() << std::endl;
+                } catch (...) {
+                    std::cerr << "async_output: unreported writer error" << std::endl;
+                }
+            }
+        }
+
+        /**
+         * @brief Copies the data stores, which can be modified as soon as this returns, and queues them for output.
+         * @param step Time step passed to the writer
+         * @param data_stores Data stores to output
+         */
+        template <class... DataStores>
+        void snapshot(std::size_t step, DataStores const &... data_stores) {
+            void((int[]){0, (snapshot_one(step, data_stores), 0)...});
+        }
+
+        /**
+         * @brief Waits until all snapshots are written.
+         */
+        void flush() {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cv.wait(lock, [&] { return m_queue.empty() && !m_writing; });
+            rethrow_error();
+        }
+
+        /**
+         * @brief Bytes of the staging buffers currently held by the pool.
+         */
+        std::size_t reserved() const {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_reserved;
+        }
+    };
+} // namespace gridtools
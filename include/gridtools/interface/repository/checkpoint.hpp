@@ -0,0 +1,399 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <typeinfo>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <boost/variant/apply_visitor.hpp>
+#include <boost/variant/static_visitor.hpp>
+
+#include "../../common/defs.hpp"
+#include "../../storage/common/definitions.hpp"
+#include "../../storage/common/mapped_file.hpp"
+#include "../../storage/common/storage_info_rt.hpp"
+
+/**
+ * Binary checkpoints of the data stores of a repository (see GT_MAKE_REPOSITORY).
+ *
+ * A checkpoint file consists of a header followed by the payloads of the fields, in native byte order:
+ *
+ *   char[8]      magic "GTCKPT1"
+ *   uint64       number of fields
+ *   per field, ordered by name:
+ *     uint64     offset of the payload in the file, a multiple of checkpoint_page_size
+ *     uint64     size of the payload in bytes
+ *     uint64     size of the element type in bytes
+ *     uint64     rank
+ *     uint64[]   total lengths, padded lengths and strides (rank each), see storage_info_rt
+ *     uint64     length of the name, followed by the name
+ *     uint64     length of the type name, followed by the type name (typeid of the element type)
+ *
+ * The payload of a field is the memory of the data store as it is: padded_total_length elements from the first one.
+ * Thus a field can be used directly from a mapping of the file (checkpoint_file::map) or copied back as a whole.
+ */
+
+namespace gridtools {
+    constexpr std::size_t checkpoint_page_size = 4096;
+
+    /**
+     * @brief Description of a field in a checkpoint file.
+     */
+    struct checkpoint_field {
+        std::string name;
+        std::string type;
+        std::size_t element_size;
+        std::vector<uint_t> total_lengths;
+        std::vector<uint_t> padded_lengths;
+        std::vector<uint_t> strides;
+        std::size_t offset; // of the payload in the file
+        std::size_t size;   // of the payload in bytes
+    };
+
+    namespace checkpoint_impl_ {
+        constexpr char magic[8] = "GTCKPT1";
+
+        // payloads are written in chunks of this size, such that large fields are written by several threads
+        constexpr std::size_t chunk_size = std::size_t(64) << 20;
+
+        struct field_data {
+            checkpoint_field field;
+            void *ptr;
+        };
+
+        struct collect_fields : boost::static_visitor<> {
+            std::vector<field_data> &fields;
+            std::string const &name;
+
+            collect_fields(std::vector<field_data> &fields, std::string const &name) : fields(fields), name(name) {}
+
+            template <class DataStore>
+            void operator()(DataStore const &ds) const {
+                using data_t = typename DataStore::data_t;
+                auto info = make_storage_info_rt(ds.info());
+                // bring the host copy up to date
+                ds.sync();
+                fields.push_back({{name,
+                                      typeid(data_t).name(),
+                                      sizeof(data_t),
+                                      info.total_lengths(),
+                                      info.padded_lengths(),
+                                      info.strides(),
+                                      0,
+                                      ds.padded_total_length() * sizeof(data_t)},
+                    ds.get_storage_ptr()->get_cpu_ptr()});
+            }
+        };
+
+        struct check_field : boost::static_visitor<> {
+            checkpoint_field const &field;
+
+            check_field(checkpoint_field const &field) : field(field) {}
+
+            template <class DataStore>
+            void operator()(DataStore const &ds) const {
+                using data_t = typename DataStore::data_t;
+                auto info = make_storage_info_rt(ds.info());
+                if (field.type != typeid(data_t).name() || field.element_size != sizeof(data_t) ||
+                    field.total_lengths != info.total_lengths() || field.padded_lengths != info.padded_lengths() ||
+                    field.strides != info.strides())
+                    throw std::runtime_error(
+                        "field " + field.name + " of the checkpoint does not match the data store");
+            }
+        };
+
+        struct copy_field : boost::static_visitor<> {
+            void const *payload;
+            std::size_t first;
+            std::size_t last;
+
+            copy_field(void const *payload, std::size_t first, std::size_t last)
+                : payload(payload), first(first), last(last) {}
+
+            template <class DataStore>
+            void operator()(DataStore const &ds) const {
+                auto *ptr = reinterpret_cast<char *>(ds.get_storage_ptr()->get_cpu_ptr());
+                std::memcpy(ptr + first, static_cast<char const *>(payload) + first, last - first);
+            }
+        };
+
+        struct sync_field : boost::static_visitor<> {
+            bool to_device;
+
+            sync_field(bool to_device) : to_device(to_device) {}
+
+            template <class DataStore>
+            void operator()(DataStore const &ds) const {
+                if (to_device)
+                    ds.clone_to_device();
+                else
+                    ds.sync();
+            }
+        };
+
+        inline void put(std::vector<char> &buffer, void const *data, std::size_t size) {
+            buffer.insert(buffer.end(), static_cast<char const *>(data), static_cast<char const *>(data) + size);
+        }
+
+        inline void put(std::vector<char> &buffer, std::uint64_t value) { put(buffer, &value, sizeof(value)); }
+
+        inline void put(std::vector<char> &buffer, std::string const &str) {
+            put(buffer, str.size());
+            put(buffer, str.data(), str.size());
+        }
+
+        inline void put(std::vector<char> &buffer, std::vector<uint_t> const &values) {
+            for (auto value : values)
+                put(buffer, value);
+        }
+
+        inline std::vector<char> make_header(std::vector<field_data> const &fields) {
+            std::vector<char> res;
+            put(res, magic, sizeof(magic));
+            put(res, fields.size());
+            for (auto const &data : fields) {
+                auto const &field = data.field;
+                put(res, field.offset);
+                put(res, field.size);
+                put(res, field.element_size);
+                put(res, field.total_lengths.size());
+                put(res, field.total_lengths);
+                put(res, field.padded_lengths);
+                put(res, field.strides);
+                put(res, field.name);
+                put(res, field.type);
+            }
+            return res;
+        }
+
+        inline std::size_t page_align(std::size_t size) {
+            return (size + checkpoint_page_size - 1) / checkpoint_page_size * checkpoint_page_size;
+        }
+
+        class header_reader {
+            char const *m_it;
+            char const *m_end;
+
+            void get(void *data, std::size_t size) {
+                if (std::size_t(m_end - m_it) < size)
+                    throw std::runtime_error("truncated checkpoint header");
+                std::memcpy(data, m_it, size);
+                m_it += size;
+            }
+
+          public:
+            header_reader(void const *data, std::size_t size)
+                : m_it(static_cast<char const *>(data)), m_end(m_it + size) {}
+
+            std::uint64_t get() {
+                std::uint64_t res;
+                get(&res, sizeof(res));
+                return res;
+            }
+
+            std::string get_string() {
+                std::string res(get(), '\0');
+                get(&res[0], res.size());
+                return res;
+            }
+
+            std::vector<uint_t> get_vector(std::size_t size) {
+                std::vector<uint_t> res(size);
+                for (auto &value : res)
+                    value = get();
+                return res;
+            }
+
+            std::vector<checkpoint_field> get_fields() {
+                char m[sizeof(magic)];
+                get(m, sizeof(m));
+                if (std::memcmp(m, magic, sizeof(magic)))
+                    throw std::runtime_error("not a gridtools checkpoint");
+                std::vector<checkpoint_field> res(get());
+                for (auto &field : res) {
+                    field.offset = get();
+                    field.size = get();
+                    field.element_size = get();
+                    auto rank = get();
+                    field.total_lengths = get_vector(rank);
+                    field.padded_lengths = get_vector(rank);
+                    field.strides = get_vector(rank);
+                    field.name = get_string();
+                    field.type = get_string();
+                }
+                return res;
+            }
+        };
+    } // namespace checkpoint_impl_
+
+    /**
+     * @brief Writes the data stores of a repository to a checkpoint file.
+     *
+     * The data stores are synchronized to the host first. The payloads are written in chunks by all OpenMP threads
+     * concurrently, directly from the memory of the data stores.
+     */
+    template <class Repository>
+    void write_checkpoint(Repository const &repo, std::string const &path) {
+        std::vector<checkpoint_impl_::field_data> fields;
+        for (auto const &elem : repo.data_stores())
+            boost::apply_visitor(checkpoint_impl_::collect_fields(fields, elem.first), elem.second);
+        std::sort(fields.begin(), fields.end(), [](checkpoint_impl_::field_data const &a,
+                                                    checkpoint_impl_::field_data const &b) {
+            return a.field.name < b.field.name;
+        });
+
+        // the header size does not depend on the offsets
+        std::size_t offset = checkpoint_impl_::page_align(checkpoint_impl_::make_header(fields).size());
+        for (auto &data : fields) {
+            data.field.offset = offset;
+            offset = checkpoint_impl_::page_align(offset + data.field.size);
+        }
+        auto header = checkpoint_impl_::make_header(fields);
+
+        struct chunk {
+            char const *data;
+            std::size_t size;
+            std::size_t offset;
+        };
+        std::vector<chunk> chunks = {{header.data(), header.size(), 0}};
+        for (auto const &data : fields)
+            for (std::size_t first = 0; first < data.field.size; first += checkpoint_impl_::chunk_size)
+                chunks.push_back({static_cast<char const *>(data.ptr) + first,
+                    std::min(checkpoint_impl_::chunk_size, data.field.size - first),
+                    data.field.offset + first});
+
+        int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0 || ftruncate(fd, offset) != 0) {
+            std::string reason = std::strerror(errno);
+            if (fd >= 0)
+                ::close(fd);
+            throw std::runtime_error("cannot create " + path + ": " + reason);
+        }
+        int error = 0;
+        int n_chunks = chunks.size();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+        for (int i = 0; i < n_chunks; ++i) {
+            std::size_t written = 0;
+            while (written < chunks[i].size) {
+                auto res = pwrite(fd, chunks[i].data + written, chunks[i].size - written, chunks[i].offset + written);
+                if (res <= 0) {
+#ifdef _OPENMP
+#pragma omp atomic write
+#endif
+                    error = res < 0 ? errno : EIO;
+                    break;
+                }
+                written += res;
+            }
+        }
+        if (::close(fd) != 0 && !error)
+            error = errno;
+        if (error)
+            throw std::runtime_error("cannot write " + path + ": " + std::strerror(error));
+    }
+
+    /**
+     * @brief A checkpoint file, mapped privately: fields mapped from it can be modified without modifying the file.
+     */
+    class checkpoint_file {
+        mapped_file m_file;
+        std::vector<checkpoint_field> m_fields;
+
+      public:
+        explicit checkpoint_file(std::string const &path)
+            : m_file(path),
+              m_fields(checkpoint_impl_::header_reader(m_file.data(), m_file.size()).get_fields()) {
+            for (auto const &field : m_fields)
+                if (field.offset + field.size > m_file.size())
+                    throw std::runtime_error("truncated checkpoint " + path);
+        }
+
+        std::vector<checkpoint_field> const &fields() const { return m_fields; }
+
+        checkpoint_field const &field(std::string const &name) const {
+            for (auto const &field : m_fields)
+                if (field.name == name)
+                    return field;
+            throw std::runtime_error("no field " + name + " in the checkpoint");
+        }
+
+        /**
+         * @brief Pointer to the payload of a field in the mapping.
+         */
+        void *payload(std::string const &name) const {
+            return static_cast<char *>(m_file.data()) + field(name).offset;
+        }
+
+        /**
+         * @brief Returns a data store using the payload of the field in the mapping as its memory, without copying.
+         * Pages are read from the file when touched. Only supported by host storages; the checkpoint_file must outlive
+         * the data store.
+         */
+        template <class DataStore>
+        DataStore map(std::string const &name, typename DataStore::storage_info_t const &info) const {
+            using data_t = typename DataStore::data_t;
+            DataStore res(info, static_cast<data_t *>(payload(name)), ownership::external_cpu, name);
+            checkpoint_impl_::check_field check(field(name));
+            check(res);
+            return res;
+        }
+
+        /**
+         * @brief Copies the fields of the checkpoint into the data stores of a repository with the same names, types
+         * and storage infos, in chunks by all OpenMP threads concurrently.
+         */
+        template <class Repository>
+        void read(Repository &repo) const {
+            using variant_t = typename std::decay<decltype(repo.data_stores().begin()->second)>::type;
+            struct chunk {
+                variant_t *ds;
+                checkpoint_impl_::copy_field copy;
+            };
+            std::vector<chunk> chunks;
+            for (auto &elem : repo.data_stores()) {
+                auto const &field = this->field(elem.first);
+                boost::apply_visitor(checkpoint_impl_::check_field(field), elem.second);
+                boost::apply_visitor(checkpoint_impl_::sync_field(false), elem.second);
+                for (std::size_t first = 0; first < field.size; first += checkpoint_impl_::chunk_size)
+                    chunks.push_back({&elem.second,
+                        {payload(field.name), first, std::min(field.size, first + checkpoint_impl_::chunk_size)}});
+            }
+            int n_chunks = chunks.size();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+            for (int i = 0; i < n_chunks; ++i)
+                boost::apply_visitor(chunks[i].copy, *chunks[i].ds);
+            for (auto &elem : repo.data_stores())
+                boost::apply_visitor(checkpoint_impl_::sync_field(true), elem.second);
+        }
+    };
+
+    /**
+     * @brief Reads the data stores of a repository from a checkpoint file written by write_checkpoint.
+     */
+    template <class Repository>
+    void read_checkpoint(Repository &repo, std::string const &path) {
+        checkpoint_file(path).read(repo);
+    }
+} // namespace gridtools
@@ -0,0 +1,297 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "../common/defs.hpp"
+#include "../common/tuple_util.hpp"
+#include "../storage/data_store.hpp"
+
+/**
+ * @file
+ *
+ * Ordering of asynchronous computation runs.
+ *
+ * The asynchronous runs of a computation are executed in order by a worker thread of the computation, which is started
+ * with the first asynchronous run and kept until the computation is destroyed, such that its OpenMP team (for the CPU
+ * backends) is reused by all runs. A run starts after all earlier asynchronous runs it conflicts with have finished.
+ * Two runs conflict if one of them writes a field (a data store with inout intent) that the other one accesses, or if
+ * they are runs of the same computation. Synchronous runs wait for the conflicting asynchronous runs as well. Runs that
+ * are issued from within an asynchronous run are not ordered again, the enclosing run already is.
+ *
+ * Fields are identified by their storage. Expandable parameters are tracked element-wise, other argument types are not
+ * tracked.
+ */
+
+namespace gridtools {
+    struct field_access {
+        void const *m_key;
+        bool m_written;
+    };
+
+    namespace async_run_impl_ {
+        inline bool &in_async_run() {
+            static thread_local bool res = false;
+            return res;
+        }
+
+        /// the asynchronous runs that access a field and have not been found finished yet
+        class registry {
+            struct entry {
+                std::shared_future<void> m_writer;
+                std::vector<std::shared_future<void>> m_readers;
+            };
+
+            std::map<void const *, entry> m_entries;
+
+            static bool finished(std::shared_future<void> const &future) {
+                return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+            }
+
+          public:
+            std::mutex m_mutex;
+
+            static registry &instance() {
+                static registry res;
+                return res;
+            }
+
+            bool empty() const { return m_entries.empty(); }
+
+            void add_dependencies(
+                std::vector<field_access> const &accesses, std::vector<std::shared_future<void>> &dst) const {
+                for (auto const &access : accesses) {
+                    auto found = m_entries.find(access.m_key);
+                    if (found == m_entries.end())
+                        continue;
+                    if (found->second.m_writer.valid())
+                        dst.push_back(found->second.m_writer);
+                    if (access.m_written)
+                        dst.insert(dst.end(), found->second.m_readers.begin(), found->second.m_readers.end());
+                }
+            }
+
+            void add_run(std::vector<field_access> const &accesses, std::shared_future<void> const &run) {
+                for (auto const &access : accesses) {
+                    auto &entry = m_entries[access.m_key];
+                    if (access.m_written) {
+                        entry.m_writer = run;
+                        entry.m_readers.clear();
+                    } else {
+                        entry.m_readers.push_back(run);
+                    }
+                }
+                // forget the finished runs
+                for (auto it = m_entries.begin(); it != m_entries.end();) {
+                    auto &entry = it->second;
+                    if (entry.m_writer.valid() && finished(entry.m_writer))
+                        entry.m_writer = {};
+                    entry.m_readers.erase(std::remove_if(entry.m_readers.begin(), entry.m_readers.end(), finished),
+                        entry.m_readers.end());
+                    if (!entry.m_writer.valid() && entry.m_readers.empty())
+                        it = m_entries.erase(it);
+                    else
+                        ++it;
+                }
+            }
+        };
+
+        template <class Obj>
+        struct run_f {
+            Obj *m_obj;
+
+            template <class... Args>
+            void operator()(Args const &... args) const {
+                m_obj->run(args...);
+            }
+        };
+
+        template <class F, class Srcs>
+        struct task {
+            F m_f;
+            Srcs m_srcs;
+            std::vector<std::shared_future<void>> m_dependencies;
+
+            struct in_async_run_guard {
+                in_async_run_guard() { in_async_run() = true; }
+                ~in_async_run_guard() { in_async_run() = false; }
+            };
+
+            void operator()() {
+                for (auto const &dependency : m_dependencies)
+                    dependency.wait();
+                m_dependencies.clear();
+                in_async_run_guard guard;
+                tuple_util::apply(m_f, m_srcs);
+            }
+        };
+
+        /// a thread executing the jobs passed to it in order
+        class worker {
+            std::mutex m_mutex;
+            std::condition_variable m_cv;
+            std::deque<std::function<void()>> m_jobs;
+            bool m_stop = false;
+            std::thread m_thread;
+
+            void loop() {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                while (true) {
+                    m_cv.wait(lock, [&] { return m_stop || !m_jobs.empty(); });
+                    if (m_jobs.empty())
+                        return;
+                    auto job = std::move(m_jobs.front());
+                    m_jobs.pop_front();
+                    lock.unlock();
+                    job();
+                    lock.lock();
+                }
+            }
+
+          public:
+            worker() : m_thread(&worker::loop, this) {}
+
+            worker(worker const &) = delete;
+            worker &operator=(worker const &) = delete;
+
+            /// executes the pending jobs before returning
+            ~worker() {
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_stop = true;
+                }
+                m_cv.notify_all();
+                m_thread.join();
+            }
+
+            void submit(std::function<void()> job) {
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_jobs.push_back(std::move(job));
+                }
+                m_cv.notify_all();
+            }
+        };
+    } // namespace async_run_impl_
+
+    template <class T, enable_if_t<is_data_store<T>::value, int> = 0>
+    void add_field_accesses(T const &src, bool written, std::vector<field_access> &dst) {
+        if (src.valid())
+            dst.push_back({src.get_storage_ptr().get(), written});
+    }
+
+    template <class T>
+    void add_field_accesses(std::vector<T> const &srcs, bool written, std::vector<field_access> &dst) {
+        for (auto const &src : srcs)
+            add_field_accesses(src, written, dst);
+    }
+
+    template <class T, enable_if_t<!is_data_store<T>::value, int> = 0>
+    void add_field_accesses(T const &, bool, std::vector<field_access> &) {}
+
+    /**
+     * @brief The asynchronous runs of a computation, executed by its worker thread (see above).
+     *
+     * Moving waits for the pending runs of both objects, such that no run refers to a moved-from computation.
+     * The destructor waits for the pending runs.
+     */
+    class async_runs {
+        std::shared_future<void> m_last;
+        std::unique_ptr<async_run_impl_::worker> m_worker;
+
+      public:
+        async_runs() = default;
+
+        async_runs(async_runs &&other) : m_worker((other.wait(), std::move(other.m_worker))) {}
+
+        async_runs &operator=(async_runs &&other) {
+            wait();
+            other.wait();
+            m_last = {};
+            m_worker = std::move(other.m_worker);
+            return *this;
+        }
+
+        ~async_runs() { wait(); }
+
+        /**
+         * @brief Waits until the pending runs have finished.
+         */
+        void wait() const {
+            if (m_last.valid())
+                m_last.wait();
+        }
+
+        /**
+         * @brief Queues `f(srcs...)` on the worker thread, to be executed once the runs it conflicts with have
+         * finished.
+         *
+         * @param accesses the fields accessed by the run
+         */
+        template <class F, class... Srcs>
+        std::shared_future<void> launch(F const &f, std::vector<field_access> const &accesses, Srcs const &... srcs) {
+            using task_t = async_run_impl_::task<F, std::tuple<Srcs...>>;
+            auto &registry = async_run_impl_::registry::instance();
+            std::lock_guard<std::mutex> lock(registry.m_mutex);
+            task_t task{f, std::tuple<Srcs...>{srcs...}, {}};
+            // the earlier runs of the same computation are ordered by the worker
+            if (!async_run_impl_::in_async_run())
+                registry.add_dependencies(accesses, task.m_dependencies);
+            auto job = std::make_shared<std::packaged_task<void()>>(wstd::move(task));
+            m_last = job->get_future().share();
+            if (!m_worker)
+                m_worker.reset(new async_run_impl_::worker());
+            m_worker->submit([job] { (*job)(); });
+            registry.add_run(accesses, m_last);
+            return m_last;
+        }
+
+        /**
+         * @brief Queues `obj.run(srcs...)`, see `launch`.
+         */
+        template <class Obj, class... Srcs>
+        std::shared_future<void> launch_run(Obj &obj, std::vector<field_access> const &accesses, Srcs const &... srcs) {
+            return launch(async_run_impl_::run_f<Obj>{&obj}, accesses, srcs...);
+        }
+
+        /**
+         * @brief Waits until the pending runs and the asynchronous runs that conflict with a synchronous run accessing
+         * the given fields have finished.
+         */
+        void wait_for_conflicts(std::vector<field_access> const &accesses) const {
+            if (async_run_impl_::in_async_run())
+                return;
+            wait();
+            std::vector<std::shared_future<void>> dependencies;
+            {
+                auto &registry = async_run_impl_::registry::instance();
+                std::lock_guard<std::mutex> lock(registry.m_mutex);
+                if (registry.empty())
+                    return;
+                registry.add_dependencies(accesses, dependencies);
+            }
+            for (auto const &dependency : dependencies)
+                dependency.wait();
+        }
+    };
+} // namespace gridtools
@@ -25,14 +25,22 @@ namespace gridtools {
     /**
      * @brief loops over all blocks and execute sequentially all mss functors for each block
      * @tparam MssComponents a meta array with the mss components of all MSS
+     * @param stage_meters meters for the single mss components (see stage_meters.hpp)
      */
-    template <class MssComponents, class LocalDomainListArray, class Grid>
-    void fused_mss_loop(backend::cuda, LocalDomainListArray const &local_domain_lists, const Grid &grid) {
-        run_mss_functors<MssComponents>(backend::cuda{}, local_domain_lists, grid, execution_info_cuda{});
+    template <class MssComponents, class LocalDomainListArray, class Grid, class StageMeters>
+    void fused_mss_loop(
+        backend::cuda, LocalDomainListArray const &local_domain_lists, const Grid &grid, StageMeters &stage_meters) {
+        run_mss_functors<MssComponents>(
+            backend::cuda{}, local_domain_lists, grid, execution_info_cuda{}, stage_meters);
     }
 
     /**
      * @brief determines whether ESFs should be fused in one single kernel execution or not for this backend.
      */
     constexpr std::true_type mss_fuse_esfs(backend::cuda) { return {}; }
+
+    /**
+     * @brief determines whether the ESFs that share a local k cache are kept in one kernel execution for this backend.
+     */
+    constexpr std::true_type mss_fuse_k_cached_esfs(backend::cuda) { return {}; }
 } // namespace gridtools
@@ -27,7 +27,7 @@
 #include "../caches/extract_extent_caches.hpp"
 #include "../iteration_policy.hpp"
 #include "../run_functor_arguments.hpp"
-#include "./iterate_domain_cache_aux.hpp"
+#include "../caches/iterate_domain_cache_aux.hpp"
 
 namespace gridtools {
     /**
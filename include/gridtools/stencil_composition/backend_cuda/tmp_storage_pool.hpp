@@ -0,0 +1,32 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <cstddef>
+
+#include "../../common/defs.hpp"
+#include "../../storage/common/definitions.hpp"
+
+#ifdef __CUDACC__
+#include "../../common/cuda_util.hpp"
+
+namespace gridtools {
+    inline void *tmp_pool_allocate(backend::cuda const &, std::size_t bytes) {
+        void *res;
+        GT_CUDA_CHECK(cudaMalloc(&res, bytes));
+        return res;
+    }
+
+    inline void tmp_pool_free(backend::cuda const &, void *ptr) { cudaFree(ptr); }
+
+    /// temporaries are never accessed from the host and need no host copy
+    constexpr ownership tmp_pool_ownership(backend::cuda const &) { return ownership::external_gpu_only; }
+} // namespace gridtools
+#endif
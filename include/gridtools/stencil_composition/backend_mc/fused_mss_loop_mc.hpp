@@ -32,21 +32,29 @@ namespace gridtools {
     /**
      * @brief loops over all blocks and execute sequentially all mss functors for each block
      * @tparam MssComponents a meta array with the mss components of all MSS
+     * @param requested block sizes to use instead of the default ones (see tiling.hpp)
+     * @param stage_meters meters for the single mss components (see stage_meters.hpp)
      */
     template <class MssComponents,
         class LocalDomainListArray,
         class Grid,
+        class StageMeters,
         enable_if_t<!_impl::all_mss_kparallel<MssComponents>::value, int> = 0>
-    void fused_mss_loop(backend::mc, LocalDomainListArray const &local_domain_lists, const Grid &grid) {
+    void fused_mss_loop(backend::mc,
+        LocalDomainListArray const &local_domain_lists,
+        const Grid &grid,
+        tiling const &requested,
+        StageMeters &stage_meters) {
         GT_STATIC_ASSERT((meta::all_of<is_mss_components, MssComponents>::value), GT_INTERNAL_ERROR);
 
-        execinfo_mc exinfo(grid);
+        execinfo_mc exinfo(grid, requested);
         const int_t i_blocks = exinfo.i_blocks();
         const int_t j_blocks = exinfo.j_blocks();
 #pragma omp parallel for collapse(2)
         for (int_t bj = 0; bj < j_blocks; ++bj) {
             for (int_t bi = 0; bi < i_blocks; ++bi) {
-                run_mss_functors<MssComponents>(backend::mc{}, local_domain_lists, grid, exinfo.block(bi, bj));
+                run_mss_functors<MssComponents>(
+                    backend::mc{}, local_domain_lists, grid, exinfo.block(bi, bj), stage_meters);
             }
         }
     }
@@ -54,26 +62,41 @@ namespace gridtools {
     /**
      * @brief loops over all blocks and execute sequentially all mss functors for each block
      * @tparam MssComponents a meta array with the mss components of all MSS
+     * @param requested block sizes to use instead of the default ones (see tiling.hpp)
+     * @param stage_meters meters of the block loop, the single blocks are too small to be timed per mss component
+     * (see stage_meters.hpp)
      */
     template <class MssComponents,
         class LocalDomainListArray,
         class Grid,
+        class StageMeters,
         enable_if_t<_impl::all_mss_kparallel<MssComponents>::value, int> = 0>
-    void fused_mss_loop(backend::mc, LocalDomainListArray const &local_domain_lists, const Grid &grid) {
+    void fused_mss_loop(backend::mc,
+        LocalDomainListArray const &local_domain_lists,
+        const Grid &grid,
+        tiling const &requested,
+        StageMeters &stage_meters) {
         GT_STATIC_ASSERT((meta::all_of<is_mss_components, MssComponents>::value), GT_INTERNAL_ERROR);
 
-        execinfo_mc exinfo(grid);
+        execinfo_mc exinfo(grid, requested);
         const int_t i_blocks = exinfo.i_blocks();
         const int_t j_blocks = exinfo.j_blocks();
         const int_t k_first = grid.k_min();
         const int_t k_last = grid.k_max();
-#pragma omp parallel for collapse(3)
-        for (int_t bj = 0; bj < j_blocks; ++bj) {
-            for (int_t k = k_first; k <= k_last; ++k) {
-                for (int_t bi = 0; bi < i_blocks; ++bi) {
-                    run_mss_functors<MssComponents>(backend::mc{}, local_domain_lists, grid, exinfo.block(bi, bj, k));
+#pragma omp parallel
+        {
+            stage_meters.start_block_loop();
+            no_stage_meters block_meters;
+#pragma omp for collapse(3) nowait
+            for (int_t bj = 0; bj < j_blocks; ++bj) {
+                for (int_t k = k_first; k <= k_last; ++k) {
+                    for (int_t bi = 0; bi < i_blocks; ++bi) {
+                        run_mss_functors<MssComponents>(
+                            backend::mc{}, local_domain_lists, grid, exinfo.block(bi, bj, k), block_meters);
+                    }
                 }
             }
+            stage_meters.pause_block_loop();
         }
     }
 
@@ -81,4 +104,10 @@ namespace gridtools {
      * @brief determines whether ESFs should be fused in one single kernel execution or not for this backend.
      */
     std::false_type mss_fuse_esfs(backend::mc);
+
+    /**
+     * @brief determines whether the ESFs that share a local k cache are kept in one kernel execution for this backend.
+     * The k-cached mc loop runs all stages of a k level before moving to the next one.
+     */
+    std::true_type mss_fuse_k_cached_esfs(backend::mc);
 } // namespace gridtools
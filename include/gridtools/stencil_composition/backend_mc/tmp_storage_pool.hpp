@@ -0,0 +1,30 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <cstddef>
+
+#include "../../common/defs.hpp"
+#include "../../common/hugepage_alloc.hpp"
+#include "../../storage/storage_mc/mc_storage.hpp"
+
+namespace gridtools {
+    /**
+     * @brief Pooled temporaries are allocated like mc storages: on huge pages and first-touched by the threads that
+     * compute on them.
+     */
+    inline void *tmp_pool_allocate(backend::mc const &, std::size_t bytes) {
+        void *res = hugepage_alloc(bytes);
+        mc_storage_impl_::first_touch(res, bytes);
+        return res;
+    }
+
+    inline void tmp_pool_free(backend::mc const &, void *ptr) { hugepage_free(ptr); }
+} // namespace gridtools
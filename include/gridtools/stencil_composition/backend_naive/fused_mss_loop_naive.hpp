@@ -10,6 +10,7 @@
 #pragma once
 
 #include <cstdlib>
+#include <tuple>
 
 #include "../../common/generic_metafunctions/for_each.hpp"
 #include "../../common/tuple_util.hpp"
@@ -80,15 +81,24 @@ namespace gridtools {
             split_loop_intervals, meta::flatten, (GT_META_CALL(meta::transform, (split_loop_interval, LoopIntervals))));
 
         // execute stages in mss
-        template <class Grid>
+        template <class MssComponentsArray, class LocalDomains, class Grid, class StageMeters>
         struct mss_executor_f {
+            LocalDomains const &m_local_domains;
             Grid const &m_grid;
-            template <class MssComponents, class LocalDomain>
-            void operator()(MssComponents, LocalDomain const &local_domain) const {
-                GT_STATIC_ASSERT(is_local_domain<LocalDomain>::value, GT_INTERNAL_ERROR);
+            StageMeters &m_stage_meters;
+
+            template <class Index>
+            void operator()(Index) const {
+                using mss_components_t = GT_META_CALL(meta::at, (MssComponentsArray, Index));
+                using local_domain_t = GT_META_CALL(meta::at, (LocalDomains, Index));
+                GT_STATIC_ASSERT(is_local_domain<local_domain_t>::value, GT_INTERNAL_ERROR);
                 GT_STATIC_ASSERT(is_grid<Grid>::value, GT_INTERNAL_ERROR);
-                using loop_intervals_t = GT_META_CALL(split_loop_intervals, typename MssComponents::loop_intervals_t);
-                for_each<loop_intervals_t>(stage_executor_f<LocalDomain, Grid>{local_domain, m_grid});
+                using loop_intervals_t =
+                    GT_META_CALL(split_loop_intervals, typename mss_components_t::loop_intervals_t);
+                m_stage_meters.start(Index{});
+                for_each<loop_intervals_t>(
+                    stage_executor_f<local_domain_t, Grid>{std::get<Index::value>(m_local_domains), m_grid});
+                m_stage_meters.pause(Index{});
             }
         };
     } // namespace naive_impl_
@@ -96,14 +106,23 @@ namespace gridtools {
     /**
      * @brief loops over all blocks and execute sequentially all mss functors
      * @tparam MssComponents a meta array with the mss components of all MSS
+     * @param stage_meters meters for the single mss components (see stage_meters.hpp)
      */
-    template <class MssComponents, class LocalDomains, class Grid>
-    void fused_mss_loop(backend::naive, LocalDomains const &local_domains, Grid const &grid) {
-        tuple_util::for_each(naive_impl_::mss_executor_f<Grid>{grid}, MssComponents{}, local_domains);
+    template <class MssComponents, class LocalDomains, class Grid, class StageMeters>
+    void fused_mss_loop(
+        backend::naive, LocalDomains const &local_domains, Grid const &grid, StageMeters &stage_meters) {
+        for_each<GT_META_CALL(meta::make_indices_for, MssComponents)>(
+            naive_impl_::mss_executor_f<MssComponents, LocalDomains, Grid, StageMeters>{
+                local_domains, grid, stage_meters});
     }
 
     /**
      * @brief determines whether ESFs should be fused in one single kernel execution or not for this backend.
      */
     std::true_type mss_fuse_esfs(backend::naive);
+
+    /**
+     * @brief determines whether the ESFs that share a local k cache are kept in one kernel execution for this backend.
+     */
+    std::true_type mss_fuse_k_cached_esfs(backend::naive);
 } // namespace gridtools
@@ -26,9 +26,11 @@ namespace gridtools {
     /**
      * @brief loops over all blocks and execute sequentially all mss functors for each block
      * @tparam MssComponents a meta array with the mss components of all MSS
+     * @param stage_meters meters for the single mss components (see stage_meters.hpp)
      */
-    template <class MssComponents, class LocalDomainListArray, class Grid>
-    void fused_mss_loop(backend::x86, LocalDomainListArray const &local_domain_lists, const Grid &grid) {
+    template <class MssComponents, class LocalDomainListArray, class Grid, class StageMeters>
+    void fused_mss_loop(
+        backend::x86, LocalDomainListArray const &local_domain_lists, const Grid &grid, StageMeters &stage_meters) {
         GT_STATIC_ASSERT((meta::all_of<is_mss_components, MssComponents>::value), GT_INTERNAL_ERROR);
         GT_STATIC_ASSERT(is_grid<Grid>::value, GT_INTERNAL_ERROR);
         uint_t n = grid.i_high_bound() - grid.i_low_bound();
@@ -43,7 +45,7 @@ namespace gridtools {
             for (uint_t bi = 0; bi <= NBI; ++bi) {
                 for (uint_t bj = 0; bj <= NBJ; ++bj) {
                     run_mss_functors<MssComponents>(
-                        backend::x86{}, local_domain_lists, grid, execution_info_x86{bi, bj});
+                        backend::x86{}, local_domain_lists, grid, execution_info_x86{bi, bj}, stage_meters);
                 }
             }
         }
@@ -53,4 +55,10 @@ namespace gridtools {
      * @brief determines whether ESFs should be fused in one single kernel execution or not for this backend.
      */
     constexpr std::false_type mss_fuse_esfs(backend::x86) { return {}; }
+
+    /**
+     * @brief determines whether the ESFs that share a local k cache are kept in one kernel execution for this backend.
+     * The x86 backend loops over the columns outside of the k loop, which is only correct for single ESFs.
+     */
+    constexpr std::false_type mss_fuse_k_cached_esfs(backend::x86) { return {}; }
 } // namespace gridtools
@@ -25,6 +25,11 @@
  *
  *  block_k_size is not used at a moment. That is why it has fallback implementation.
  *
+ *  Backends with runtime block size may additionally honor a requested tiling (see tiling.hpp):
+ *   - uint_t block_i_size(Backend, Grid, tiling)
+ *   - std::vector<tiling> tiling_candidates(Backend, Grid)
+ *  The fallbacks ignore the tiling and provide no candidates.
+ *
  *  Ideally for backends where block size is compile time, it is enough to define only constexpr version.
  *  And for backends where block size is run time, it is enough to define only the version with two args.
  *  However X86/Naive backend still have to define constexpr version that returns 0.
@@ -36,6 +41,7 @@
 #include "../common/host_device.hpp"
 
 #include "./grid.hpp"
+#include "./tiling.hpp"
 
 #include "./backend_cuda/block.hpp"
 #include "./backend_naive/block.hpp"
@@ -64,4 +70,17 @@ namespace gridtools {
         GT_STATIC_ASSERT(is_grid<Grid>::value, GT_INTERNAL_ERROR);
         return grid.k_total_length();
     }
+
+    template <class Backend, class Grid>
+    uint_t block_i_size(Backend const &backend, Grid const &grid, tiling const &) {
+        return block_i_size(backend, grid);
+    }
+    template <class Backend, class Grid>
+    uint_t block_j_size(Backend const &backend, Grid const &grid, tiling const &) {
+        return block_j_size(backend, grid);
+    }
+    template <class Backend, class Grid>
+    std::vector<tiling> tiling_candidates(Backend const &, Grid const &) {
+        return {};
+    }
 } // namespace gridtools
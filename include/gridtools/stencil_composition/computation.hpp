@@ -9,8 +9,11 @@
  */
 #pragma once
 
+#include <future>
 #include <memory>
 #include <string>
+#include <tuple>
+#include <type_traits>
 #include <utility>
 
 #include "../common/defs.hpp"
@@ -19,6 +22,7 @@
 #include "accessor_intent.hpp"
 #include "arg.hpp"
 #include "extent.hpp"
+#include "tiling.hpp"
 
 namespace gridtools {
 
@@ -34,6 +38,88 @@ namespace gridtools {
                 }
             };
 
+            template <class Obj>
+            struct run_async_f {
+                Obj &m_obj;
+
+                template <class... Args>
+                std::shared_future<void> operator()(Args &&... args) const {
+                    return m_obj.run_async(wstd::forward<Args>(args)...);
+                }
+            };
+
+            template <class Obj, class ArgsTuple, class = void>
+            struct has_run_async : std::false_type {};
+
+            template <class Obj, class... Args>
+            struct has_run_async<Obj,
+                std::tuple<Args...>,
+                void_t<decltype(std::declval<Obj &>().run_async(std::declval<Args>()...))>> : std::true_type {};
+
+            inline std::shared_future<void> finished_run() {
+                std::promise<void> res;
+                res.set_value();
+                return res.get_future().share();
+            }
+
+            template <class Obj>
+            struct run_interior_f {
+                Obj &m_obj;
+
+                template <class... Args>
+                void operator()(Args &&... args) const {
+                    m_obj.run_interior(wstd::forward<Args>(args)...);
+                }
+            };
+
+            template <class Obj>
+            struct run_interior_async_f {
+                Obj &m_obj;
+
+                template <class... Args>
+                std::shared_future<void> operator()(Args &&... args) const {
+                    return m_obj.run_interior_async(wstd::forward<Args>(args)...);
+                }
+            };
+
+            template <class Obj>
+            struct run_boundary_f {
+                Obj &m_obj;
+
+                template <class... Args>
+                void operator()(Args &&... args) const {
+                    m_obj.run_boundary(wstd::forward<Args>(args)...);
+                }
+            };
+
+            template <class Obj, class ArgsTuple, class = void>
+            struct has_split_run : std::false_type {};
+
+            template <class Obj, class... Args>
+            struct has_split_run<Obj,
+                std::tuple<Args...>,
+                void_t<decltype(std::declval<Obj &>().run_interior(std::declval<Args>()...)),
+                    decltype(std::declval<Obj &>().run_boundary(std::declval<Args>()...))>> : std::true_type {};
+
+            template <class Obj, class ArgsTuple, class = void>
+            struct has_run_interior_async : std::false_type {};
+
+            template <class Obj, class... Args>
+            struct has_run_interior_async<Obj,
+                std::tuple<Args...>,
+                void_t<decltype(std::declval<Obj &>().run_interior_async(std::declval<Args>()...))>>
+                : std::true_type {};
+
+            template <class Obj, class = void>
+            struct has_tiling : std::false_type {};
+
+            template <class Obj>
+            struct has_tiling<Obj,
+                void_t<decltype(std::declval<Obj const &>().get_tiling()),
+                    decltype(std::declval<Obj &>().set_tiling(std::declval<tiling const &>())),
+                    decltype(std::declval<Obj &>().enable_tiling_autotuner(size_t())),
+                    decltype(std::declval<Obj const &>().is_tiling_autotuner_active())>> : std::true_type {};
+
             template <typename Arg>
             struct iface_arg {
                 virtual ~iface_arg() = default;
@@ -68,10 +154,28 @@ namespace gridtools {
         struct iface : virtual _impl::computation_detail::iface_arg<Args>... {
             virtual ~iface() = default;
             virtual void run(arg_storage_pair_crefs_t const &) = 0;
+            /// computations without asynchronous runs are run synchronously
+            virtual std::shared_future<void> run_async(arg_storage_pair_crefs_t const &args) {
+                run(args);
+                return _impl::computation_detail::finished_run();
+            }
+            /// computations without split runs do all the work in the boundary run
+            virtual void run_interior(arg_storage_pair_crefs_t const &) {}
+            virtual std::shared_future<void> run_interior_async(arg_storage_pair_crefs_t const &args) {
+                run_interior(args);
+                return _impl::computation_detail::finished_run();
+            }
+            virtual void run_boundary(arg_storage_pair_crefs_t const &args) { run(args); }
             virtual std::string print_meter() const = 0;
             virtual double get_time() const = 0;
             virtual size_t get_count() const = 0;
             virtual void reset_meter() = 0;
+            virtual std::string print_stage_meters() const = 0;
+            /// computations without runtime tiling run with the default block sizes of their backend
+            virtual tiling get_tiling() const { return {}; }
+            virtual void set_tiling(tiling const &) {}
+            virtual void enable_tiling_autotuner(size_t) {}
+            virtual bool is_tiling_autotuner_active() const { return false; }
         };
 
         template <class Obj>
@@ -83,10 +187,66 @@ namespace gridtools {
             void run(arg_storage_pair_crefs_t const &args) override {
                 tuple_util::apply(_impl::computation_detail::run_f<Obj>{m_obj}, args);
             }
+            std::shared_future<void> run_async(arg_storage_pair_crefs_t const &args) override {
+                return run_async(args, _impl::computation_detail::has_run_async<Obj, arg_storage_pair_crefs_t>());
+            }
+            std::shared_future<void> run_async(arg_storage_pair_crefs_t const &args, std::true_type) {
+                return tuple_util::apply(_impl::computation_detail::run_async_f<Obj>{m_obj}, args);
+            }
+            std::shared_future<void> run_async(arg_storage_pair_crefs_t const &args, std::false_type) {
+                return iface::run_async(args);
+            }
+            void run_interior(arg_storage_pair_crefs_t const &args) override {
+                run_interior(args, _impl::computation_detail::has_split_run<Obj, arg_storage_pair_crefs_t>());
+            }
+            void run_interior(arg_storage_pair_crefs_t const &args, std::true_type) {
+                tuple_util::apply(_impl::computation_detail::run_interior_f<Obj>{m_obj}, args);
+            }
+            void run_interior(arg_storage_pair_crefs_t const &args, std::false_type) { iface::run_interior(args); }
+            std::shared_future<void> run_interior_async(arg_storage_pair_crefs_t const &args) override {
+                return run_interior_async(
+                    args, _impl::computation_detail::has_run_interior_async<Obj, arg_storage_pair_crefs_t>());
+            }
+            std::shared_future<void> run_interior_async(arg_storage_pair_crefs_t const &args, std::true_type) {
+                return tuple_util::apply(_impl::computation_detail::run_interior_async_f<Obj>{m_obj}, args);
+            }
+            std::shared_future<void> run_interior_async(arg_storage_pair_crefs_t const &args, std::false_type) {
+                return iface::run_interior_async(args);
+            }
+            void run_boundary(arg_storage_pair_crefs_t const &args) override {
+                run_boundary(args, _impl::computation_detail::has_split_run<Obj, arg_storage_pair_crefs_t>());
+            }
+            void run_boundary(arg_storage_pair_crefs_t const &args, std::true_type) {
+                tuple_util::apply(_impl::computation_detail::run_boundary_f<Obj>{m_obj}, args);
+            }
+            void run_boundary(arg_storage_pair_crefs_t const &args, std::false_type) { iface::run_boundary(args); }
             std::string print_meter() const override { return m_obj.print_meter(); }
             double get_time() const override { return m_obj.get_time(); }
             size_t get_count() const override { return m_obj.get_count(); }
             void reset_meter() override { m_obj.reset_meter(); }
+            std::string print_stage_meters() const override { return m_obj.print_stage_meters(); }
+            tiling get_tiling() const override { return get_tiling(_impl::computation_detail::has_tiling<Obj>()); }
+            tiling get_tiling(std::true_type) const { return m_obj.get_tiling(); }
+            tiling get_tiling(std::false_type) const { return iface::get_tiling(); }
+            void set_tiling(tiling const &requested) override {
+                set_tiling(requested, _impl::computation_detail::has_tiling<Obj>());
+            }
+            void set_tiling(tiling const &requested, std::true_type) { m_obj.set_tiling(requested); }
+            void set_tiling(tiling const &requested, std::false_type) { iface::set_tiling(requested); }
+            void enable_tiling_autotuner(size_t runs_per_candidate) override {
+                enable_tiling_autotuner(runs_per_candidate, _impl::computation_detail::has_tiling<Obj>());
+            }
+            void enable_tiling_autotuner(size_t runs_per_candidate, std::true_type) {
+                m_obj.enable_tiling_autotuner(runs_per_candidate);
+            }
+            void enable_tiling_autotuner(size_t runs_per_candidate, std::false_type) {
+                iface::enable_tiling_autotuner(runs_per_candidate);
+            }
+            bool is_tiling_autotuner_active() const override {
+                return is_tiling_autotuner_active(_impl::computation_detail::has_tiling<Obj>());
+            }
+            bool is_tiling_autotuner_active(std::true_type) const { return m_obj.is_tiling_autotuner_active(); }
+            bool is_tiling_autotuner_active(std::false_type) const { return iface::is_tiling_autotuner_active(); }
         };
 
         std::unique_ptr<iface> m_impl;
@@ -109,6 +269,34 @@ namespace gridtools {
             m_impl->run(permute_to<arg_storage_pair_crefs_t>(std::make_tuple(std::cref(args)...)));
         }
 
+        /// runs the computation on its worker thread, see async_run.hpp for the ordering of the runs
+        template <class... SomeArgs, class... SomeDataStores>
+        typename std::enable_if<sizeof...(SomeArgs) == sizeof...(Args), std::shared_future<void>>::type run_async(
+            arg_storage_pair<SomeArgs, SomeDataStores> const &... args) {
+            return m_impl->run_async(permute_to<arg_storage_pair_crefs_t>(std::make_tuple(std::cref(args)...)));
+        }
+
+        /// split run that overlaps the halo exchange of the fields with computation: the interior of the domain first
+        template <class... SomeArgs, class... SomeDataStores>
+        typename std::enable_if<sizeof...(SomeArgs) == sizeof...(Args)>::type run_interior(
+            arg_storage_pair<SomeArgs, SomeDataStores> const &... args) {
+            m_impl->run_interior(permute_to<arg_storage_pair_crefs_t>(std::make_tuple(std::cref(args)...)));
+        }
+
+        template <class... SomeArgs, class... SomeDataStores>
+        typename std::enable_if<sizeof...(SomeArgs) == sizeof...(Args), std::shared_future<void>>::type
+        run_interior_async(arg_storage_pair<SomeArgs, SomeDataStores> const &... args) {
+            return m_impl->run_interior_async(
+                permute_to<arg_storage_pair_crefs_t>(std::make_tuple(std::cref(args)...)));
+        }
+
+        /// completes a split run once the halos are up to date, see `run_interior`
+        template <class... SomeArgs, class... SomeDataStores>
+        typename std::enable_if<sizeof...(SomeArgs) == sizeof...(Args)>::type run_boundary(
+            arg_storage_pair<SomeArgs, SomeDataStores> const &... args) {
+            m_impl->run_boundary(permute_to<arg_storage_pair_crefs_t>(std::make_tuple(std::cref(args)...)));
+        }
+
         std::string print_meter() const { return m_impl->print_meter(); }
 
         double get_time() const { return m_impl->get_time(); }
@@ -117,6 +305,21 @@ namespace gridtools {
 
         void reset_meter() { m_impl->reset_meter(); }
 
+        /// per stage breakdown of the timings, empty unless compiled with GT_ENABLE_STAGE_METERS (see stage_meters.hpp)
+        std::string print_stage_meters() const { return m_impl->print_stage_meters(); }
+
+        /// block sizes of the horizontal iteration space, see tiling.hpp
+        tiling get_tiling() const { return m_impl->get_tiling(); }
+
+        void set_tiling(tiling const &requested) { m_impl->set_tiling(requested); }
+
+        /// times the candidate tilings of the backend during the next runs and locks in the fastest one
+        void enable_tiling_autotuner(size_t runs_per_candidate = 1) {
+            m_impl->enable_tiling_autotuner(runs_per_candidate);
+        }
+
+        bool is_tiling_autotuner_active() const { return m_impl->is_tiling_autotuner_active(); }
+
         template <class Arg>
         enable_if_t<meta::st_contains<meta::list<Args...>, Arg>::value, rt_extent> get_arg_extent(Arg) const {
             return static_cast<_impl::computation_detail::iface_arg<Arg> const &>(*m_impl).get_arg_extent(Arg());
@@ -12,6 +12,7 @@
 #include <cassert>
 #include <cstddef>
 #include <functional>
+#include <future>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -22,6 +23,7 @@
 #include "../../common/tuple_util.hpp"
 #include "../../meta.hpp"
 #include "../arg.hpp"
+#include "../async_run.hpp"
 #include "../esf_fwd.hpp"
 #include "../esf_metafunctions.hpp"
 #include "../fused_mss_loop.hpp"
@@ -252,9 +254,29 @@ namespace gridtools {
                 using result_type = void;
             };
 
-            template <class Intermediate, class Args>
+            template <class Intermediate>
+            struct run_interior_f {
+                Intermediate &m_intermediate;
+                template <class... Args>
+                void operator()(Args const &... args) const {
+                    m_intermediate.run_interior(args...);
+                }
+                using result_type = void;
+            };
+
+            template <class Intermediate>
+            struct run_boundary_f {
+                Intermediate &m_intermediate;
+                template <class... Args>
+                void operator()(Args const &... args) const {
+                    m_intermediate.run_boundary(args...);
+                }
+                using result_type = void;
+            };
+
+            template <template <class> class RunF = run_f, class Intermediate, class Args>
             void invoke_run(Intermediate &intermediate, Args &&args) {
-                tuple_util::apply(run_f<Intermediate>{intermediate}, wstd::forward<Args>(args));
+                tuple_util::apply(RunF<Intermediate>{intermediate}, wstd::forward<Args>(args));
             }
         } // namespace expand_detail
     }     // namespace _impl
@@ -296,6 +318,9 @@ namespace gridtools {
             non_expandable_bound_arg_storage_pairs_t,
             GT_META_CALL(_impl::expand_detail::converted_mss_descriptors, (N, MssDescriptors))>;
 
+        /// the runs started with run_async, first such that moving waits for them before the other members change
+        async_runs m_async_runs;
+
         /// Storages that are expandable, is bound in construction time.
         //
         expandable_bound_arg_storage_pairs_t m_expandable_bound_arg_storage_pairs;
@@ -310,6 +335,23 @@ namespace gridtools {
 
         typename timer_traits<Backend>::timer_type m_meter;
 
+        struct add_field_accesses_f {
+            std::vector<field_access> &m_dst;
+
+            template <class Arg, class DataStore>
+            void operator()(arg_storage_pair<Arg, DataStore> const &src) const {
+                add_field_accesses(src.m_value, intermediate_expand::get_arg_intent(Arg()) == intent::inout, m_dst);
+            }
+        };
+
+        template <class... Args, class... DataStores>
+        std::vector<field_access> field_accesses(arg_storage_pair<Args, DataStores> const &... srcs) const {
+            auto res = m_intermediate.field_accesses();
+            tuple_util::for_each(add_field_accesses_f{res}, m_expandable_bound_arg_storage_pairs);
+            tuple_util::for_each(add_field_accesses_f{res}, std::tie(srcs...));
+            return res;
+        }
+
         template <class ExpandableBoundArgStoragePairRefs, class NonExpandableBoundArgStoragePairRefs>
         intermediate_expand(Grid const &grid,
             std::pair<ExpandableBoundArgStoragePairRefs, NonExpandableBoundArgStoragePairRefs> &&arg_refs)
@@ -327,8 +369,15 @@ namespace gridtools {
             : intermediate_expand(
                   grid, split_args_tuple<_impl::expand_detail::is_expandable>(wstd::move(arg_storage_pairs))) {}
 
-        template <class... Args, class... DataStores>
-        void run(arg_storage_pair<Args, DataStores> const &... args) {
+        intermediate_expand(intermediate_expand &&) = default;
+        intermediate_expand &operator=(intermediate_expand &&) = default;
+
+        ~intermediate_expand() { m_async_runs.wait(); }
+
+      private:
+        template <template <class> class RunF, class... Args, class... DataStores>
+        void run_chunks(arg_storage_pair<Args, DataStores> const &... args) {
+            m_async_runs.wait_for_conflicts(field_accesses(args...));
             m_meter.start();
             // split arguments to expandable and plain arg_storage_pairs
             auto arg_groups = split_args<_impl::expand_detail::is_expandable>(args...);
@@ -346,25 +395,85 @@ namespace gridtools {
                     _impl::expand_detail::convert_arg_storage_pairs<ExpandFactor>(offset, expandable_args);
                 // concatenate that chunk with the plain portion of the arguments
                 // and invoke the `run` of the `m_intermediate`.
-                _impl::expand_detail::invoke_run(
+                _impl::expand_detail::invoke_run<RunF>(
                     m_intermediate, tuple_util::flatten(std::tie(plain_args, converted_args)));
             }
             // process the reminder the same way
             for (; offset < size; ++offset) {
                 auto converted_args = _impl::expand_detail::convert_arg_storage_pairs<1>(offset, expandable_args);
-                _impl::expand_detail::invoke_run(
+                _impl::expand_detail::invoke_run<RunF>(
                     m_intermediate_remainder, tuple_util::flatten(std::tie(plain_args, converted_args)));
             }
             m_meter.pause();
         }
 
+        struct run_interior_f {
+            intermediate_expand *m_self;
+
+            template <class... Args>
+            void operator()(Args const &... args) const {
+                m_self->run_interior(args...);
+            }
+        };
+
+      public:
+        template <class... Args, class... DataStores>
+        void run(arg_storage_pair<Args, DataStores> const &... args) {
+            run_chunks<_impl::expand_detail::run_f>(args...);
+        }
+
+        template <class... Args, class... DataStores>
+        std::shared_future<void> run_async(arg_storage_pair<Args, DataStores> const &... args) {
+            return m_async_runs.launch_run(*this, field_accesses(args...), args...);
+        }
+
+        /// first phase of a split run for all chunks, see `intermediate::run_interior`
+        template <class... Args, class... DataStores>
+        void run_interior(arg_storage_pair<Args, DataStores> const &... args) {
+            run_chunks<_impl::expand_detail::run_interior_f>(args...);
+        }
+
+        template <class... Args, class... DataStores>
+        std::shared_future<void> run_interior_async(arg_storage_pair<Args, DataStores> const &... args) {
+            return m_async_runs.launch(run_interior_f{this}, field_accesses(args...), args...);
+        }
+
+        template <class... Args, class... DataStores>
+        void run_boundary(arg_storage_pair<Args, DataStores> const &... args) {
+            run_chunks<_impl::expand_detail::run_boundary_f>(args...);
+        }
+
         std::string print_meter() const { return m_meter.to_string(); }
 
         double get_time() const { return m_meter.total_time(); }
 
         size_t get_count() const { return m_meter.count(); }
 
-        void reset_meter() { m_meter.reset(); }
+        void reset_meter() {
+            m_meter.reset();
+            m_intermediate.reset_stage_meters();
+            m_intermediate_remainder.reset_stage_meters();
+        }
+
+        std::string print_stage_meters() const {
+            return m_intermediate.print_stage_meters() + m_intermediate_remainder.print_stage_meters();
+        }
+
+        tiling get_tiling() const { return m_intermediate.get_tiling(); }
+
+        void set_tiling(tiling const &requested) {
+            m_intermediate.set_tiling(requested);
+            m_intermediate_remainder.set_tiling(requested);
+        }
+
+        void enable_tiling_autotuner(size_t runs_per_candidate = 1) {
+            m_intermediate.enable_tiling_autotuner(runs_per_candidate);
+            m_intermediate_remainder.enable_tiling_autotuner(runs_per_candidate);
+        }
+
+        bool is_tiling_autotuner_active() const {
+            return m_intermediate.is_tiling_autotuner_active() || m_intermediate_remainder.is_tiling_autotuner_active();
+        }
 
         template <class Placeholder>
         static constexpr auto get_arg_extent(Placeholder) GT_AUTO_RETURN(converted_intermediate<1>::get_arg_extent(
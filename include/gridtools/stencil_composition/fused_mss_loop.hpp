@@ -17,3 +17,18 @@
 #endif
 #include "./backend_naive/fused_mss_loop_naive.hpp"
 #include "./backend_x86/fused_mss_loop_x86.hpp"
+#include "./tiling.hpp"
+
+namespace gridtools {
+    /**
+     * @brief fallback for backends that do not support runtime tiling: the requested tiling is ignored.
+     */
+    template <class MssComponents, class Backend, class LocalDomainListArray, class Grid, class StageMeters>
+    void fused_mss_loop(Backend const &backend,
+        LocalDomainListArray const &local_domain_lists,
+        const Grid &grid,
+        tiling const &,
+        StageMeters &stage_meters) {
+        fused_mss_loop<MssComponents>(backend, local_domain_lists, grid, stage_meters);
+    }
+} // namespace gridtools
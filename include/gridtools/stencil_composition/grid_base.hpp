@@ -9,6 +9,8 @@
  */
 
 #pragma once
+#include <cassert>
+
 #include "../common/array.hpp"
 #include "../common/halo_descriptor.hpp"
 #include "axis.hpp"
@@ -97,6 +99,19 @@ namespace gridtools {
         GT_FUNCTION halo_descriptor const &direction_i() const { return m_direction_i; }
 
         GT_FUNCTION halo_descriptor const &direction_j() const { return m_direction_j; }
+
+        /**
+         * @brief Restricts the horizontal compute domain to the given (inclusive) ranges. They have to lie within the
+         * current compute domain, the halos and total lengths are kept.
+         */
+        void restrict_compute_domain(uint_t i_begin, uint_t i_end, uint_t j_begin, uint_t j_end) {
+            assert(i_begin >= i_low_bound() && i_end <= i_high_bound());
+            assert(j_begin >= j_low_bound() && j_end <= j_high_bound());
+            m_direction_i = halo_descriptor(
+                m_direction_i.minus(), m_direction_i.plus(), i_begin, i_end, m_direction_i.total_length());
+            m_direction_j = halo_descriptor(
+                m_direction_j.minus(), m_direction_j.plus(), j_begin, j_end, m_direction_j.total_length());
+        }
     };
 
 } // namespace gridtools
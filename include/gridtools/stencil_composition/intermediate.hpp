@@ -9,13 +9,18 @@
  */
 #pragma once
 
+#include <chrono>
+#include <future>
 #include <memory>
 #include <tuple>
 #include <utility>
+#include <vector>
 
 #include "../common/timer/timer_traits.hpp"
 #include "../common/tuple_util.hpp"
 #include "../meta.hpp"
+#include "async_run.hpp"
+#include "block.hpp"
 #include "compute_extents_metafunctions.hpp"
 #include "dim.hpp"
 #include "esf.hpp"
@@ -26,6 +31,9 @@
 #include "level.hpp"
 #include "local_domain.hpp"
 #include "mss_components_metafunctions.hpp"
+#include "stage_meters.hpp"
+#include "tiling.hpp"
+#include "tmp_storage_pool.hpp"
 
 /**
  * @file
@@ -139,11 +147,41 @@ namespace gridtools {
 
       private:
         using fuse_esfs_t = decltype(mss_fuse_esfs(std::declval<Backend>()));
+        using fuse_k_cached_esfs_t = decltype(mss_fuse_k_cached_esfs(std::declval<Backend>()));
         using mss_components_array_t = GT_META_CALL(build_mss_components_array,
-            (fuse_esfs_t::value, mss_descriptors_t, extent_map_t, typename Grid::axis_type));
+            (fuse_esfs_t::value,
+                fuse_k_cached_esfs_t::value,
+                mss_descriptors_t,
+                extent_map_t,
+                typename Grid::axis_type));
 
         using max_extent_for_tmp_t = GT_META_CALL(_impl::get_max_extent_for_tmp, mss_components_array_t);
 
+        using stage_meters_t =
+            typename get_stage_meters<Backend, mss_descriptors_t, mss_components_array_t>::type;
+
+        template <class Arg>
+        GT_META_DEFINE_ALIAS(get_field_extent, lookup_extent_map, (extent_map_t, Arg));
+
+        using field_extents_t = GT_META_CALL(meta::transform, (get_field_extent, non_tmp_placeholders_t));
+
+        // points of the compute domain closer to its border than this extent access the halos of the fields
+        using boundary_extent_t = GT_META_CALL(meta::rename, (enclosing_extent, field_extents_t));
+
+        template <class MssComponents>
+        GT_META_DEFINE_ALIAS(
+            get_mss_placeholders, extract_placeholders_from_mss, typename MssComponents::mss_descriptor_t);
+
+        // temporaries with disjoint live ranges share a buffer, the first temporary of each group owns it
+        using tmp_alias_groups_t = GT_META_CALL(tmp_alias_groups,
+            (GT_META_CALL(meta::transform, (get_mss_placeholders, mss_components_array_t)),
+                GT_META_CALL(meta::transform, (meta::first, tmp_arg_storage_pair_tuple_t))));
+
+        using tmp_buffer_arg_storage_pair_tuple_t = GT_META_CALL(meta::rename,
+            (std::tuple,
+                GT_META_CALL(meta::transform,
+                    (to_arg_storage_pair, GT_META_CALL(meta::transform, (meta::first, tmp_alias_groups_t))))));
+
         template <class MssComponents>
         GT_META_DEFINE_ALIAS(get_local_domain,
             local_domain,
@@ -159,13 +197,24 @@ namespace gridtools {
       private:
         // member fields
 
+        /// the runs started with run_async, first such that moving waits for them before the other members change
+        async_runs m_async_runs;
+
         Grid m_grid;
 
+        /// block sizes that are used to execute the stencils and to allocate the temporaries
+        tiling m_tiling;
+
+        /// present while the tiling autotuner is active
+        std::unique_ptr<tiling_tuner> m_tuner;
+
         std::unique_ptr<performance_meter_t> m_meter;
 
-        /// tuple with temporary storages
-        //
-        tmp_arg_storage_pair_tuple_t m_tmp_arg_storage_pair_tuple;
+        /// meters per multistage and mss component, see stage_meters.hpp
+        stage_meters_t m_stage_meters;
+
+        /// block sizes the temporaries are sized for (they are checked out of the tmp_storage_pool at each run)
+        tiling m_tmp_tiling;
 
         /// tuple with storages that are bound during costruction
         //  Each item holds a storage and its view
@@ -188,15 +237,56 @@ namespace gridtools {
             }
         };
 
+        struct add_field_accesses_f {
+            std::vector<field_access> &m_dst;
+
+            template <class Arg, class DataStore>
+            void operator()(arg_storage_pair<Arg, DataStore> const &src) const {
+                add_field_accesses(src.m_value, intermediate::get_arg_intent(Arg()) == intent::inout, m_dst);
+            }
+        };
+
+        static tiling effective_tiling(Grid const &grid, tiling const &requested) {
+            return {static_cast<int_t>(block_i_size(Backend{}, grid, requested)),
+                static_cast<int_t>(block_j_size(Backend{}, grid, requested))};
+        }
+
+        using tmp_buffers_t = std::vector<typename tmp_storage_pool<Backend>::handle>;
+
+        tmp_arg_storage_pair_tuple_t check_out_temporaries(tmp_buffers_t &buffers) const {
+            return _impl::alias_tmp_arg_storage_pairs<tmp_alias_groups_t, tmp_arg_storage_pair_tuple_t>(
+                _impl::check_out_tmp_arg_storage_pairs<max_extent_for_tmp_t,
+                    Backend,
+                    tmp_buffer_arg_storage_pair_tuple_t>(m_grid, m_tmp_tiling, buffers));
+        }
+
+        void count_stage_meters_run() { m_stage_meters.count_run(); }
+
+        template <class LocalDomains>
+        void execute(LocalDomains const &local_domains, Grid const &grid, tiling const &requested) {
+            fused_mss_loop<mss_components_array_t>(Backend{}, local_domains, grid, requested, m_stage_meters);
+        }
+
+        template <class LocalDomains>
+        void run_tuning_step(LocalDomains const &local_domains) {
+            tiling const current = m_tuner->current();
+            auto start = std::chrono::steady_clock::now();
+            execute(local_domains, m_grid, current);
+            m_tuner->record(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+            if (m_tuner->done()) {
+                tiling best = m_tuner->best();
+                m_tuner.reset();
+                set_tiling(best);
+            }
+        }
+
       public:
         intermediate(Grid const &grid,
             std::tuple<arg_storage_pair<BoundPlaceholders, BoundDataStores>...> arg_storage_pairs,
             bool timer_enabled = true)
             // grid just stored to the member
-            : m_grid(grid),
-              // here we create temporary storages.
-              m_tmp_arg_storage_pair_tuple(
-                  _impl::make_tmp_arg_storage_pairs<max_extent_for_tmp_t, Backend, tmp_arg_storage_pair_tuple_t>(grid)),
+            : m_grid(grid), m_tiling(effective_tiling(grid, {})), m_stage_meters(grid),
+              m_tmp_tiling(m_tiling),
               // stash bound storages
               m_bound_arg_storage_pair_tuple(wstd::move(arg_storage_pairs)) {
             if (timer_enabled)
@@ -206,6 +296,12 @@ namespace gridtools {
 #endif
         }
 
+        intermediate(intermediate &&) = default;
+        intermediate &operator=(intermediate &&) = default;
+
+        /// waits for the asynchronous runs, the computation must not be moved while they are in flight
+        ~intermediate() { m_async_runs.wait(); }
+
         // TODO(anstaf): introduce overload that takes a tuple of arg_storage_pair's. it will simplify a bit
         //               implementation of the `intermediate_expanded` and `computation` by getting rid of
         //               `boost::fusion::invoke`.
@@ -216,13 +312,103 @@ namespace gridtools {
                 "some placeholders are not used in mss descriptors");
             GT_STATIC_ASSERT(
                 meta::is_set_fast<meta::list<Args...>>::value, "free placeholders should be all different");
+            m_async_runs.wait_for_conflicts(field_accesses(srcs...));
             if (m_meter)
                 m_meter->start();
-            fused_mss_loop<mss_components_array_t>(Backend{}, local_domains(srcs...), m_grid);
+            {
+                // the temporaries are given back to the pool at the end of the scope
+                tmp_buffers_t tmp_buffers;
+                tmp_buffers.reserve(meta::length<tmp_alias_groups_t>::value);
+                auto tmps = check_out_temporaries(tmp_buffers);
+                auto const &local_domains = update_local_domains(tmps, srcs...);
+                count_stage_meters_run();
+                if (m_tuner)
+                    run_tuning_step(local_domains);
+                else
+                    execute(local_domains, m_grid, m_tiling);
+            }
             if (m_meter)
                 m_meter->pause();
         }
 
+        /**
+         * @brief Like `run`, but the computation is executed by its worker thread, after the asynchronous runs
+         * accessing the same fields in a conflicting way have finished (see async_run.hpp). The data stores are kept
+         * alive until the run has finished.
+         */
+        template <class... Args, class... DataStores>
+        enable_if_t<sizeof...(Args) == meta::length<free_placeholders_t>::value, std::shared_future<void>> run_async(
+            arg_storage_pair<Args, DataStores> const &... srcs) {
+            return m_async_runs.launch_run(*this, field_accesses(srcs...), srcs...);
+        }
+
+        /**
+         * @brief First phase of a run that is split to overlap the halo exchange of the fields with computation:
+         * computes the interior of the compute domain, i.e. the points that do not access the halos of the fields
+         * (according to the extents of the stencils). The halos can be updated while it runs, `run_boundary` with the
+         * same arguments then completes the run. The fields must not be written with an offset by the computation.
+         *
+         * Split runs count as two runs for the performance meter and are ignored by the tiling autotuner.
+         */
+        template <class... Args, class... DataStores>
+        enable_if_t<sizeof...(Args) == meta::length<free_placeholders_t>::value> run_interior(
+            arg_storage_pair<Args, DataStores> const &... srcs) {
+            count_stage_meters_run();
+            run_on_grids(_impl::interior_grids<boundary_extent_t>(m_grid), srcs...);
+        }
+
+        /**
+         * @brief `run_interior` on the worker thread, see `run_async`.
+         */
+        template <class... Args, class... DataStores>
+        enable_if_t<sizeof...(Args) == meta::length<free_placeholders_t>::value, std::shared_future<void>>
+        run_interior_async(arg_storage_pair<Args, DataStores> const &... srcs) {
+            return m_async_runs.launch(run_interior_f{this}, field_accesses(srcs...), srcs...);
+        }
+
+        /**
+         * @brief Second phase of a split run, see `run_interior`: computes the strips along the border of the compute
+         * domain that access the halos of the fields. Waits for a preceding `run_interior_async`.
+         */
+        template <class... Args, class... DataStores>
+        enable_if_t<sizeof...(Args) == meta::length<free_placeholders_t>::value> run_boundary(
+            arg_storage_pair<Args, DataStores> const &... srcs) {
+            run_on_grids(_impl::boundary_grids<boundary_extent_t>(m_grid), srcs...);
+        }
+
+        /**
+         * @brief Block sizes that are currently used. Can be stored and passed to `set_tiling` later on.
+         */
+        tiling get_tiling() const { return m_tiling; }
+
+        /**
+         * @brief Uses the given block sizes for all following runs and stops the autotuner if it is active.
+         * Backends without runtime tiling ignore the request.
+         */
+        void set_tiling(tiling const &requested) {
+            m_tuner.reset();
+            m_tiling = effective_tiling(m_grid, requested);
+            m_tmp_tiling = m_tiling;
+        }
+
+        /**
+         * @brief Times the candidate tilings of the backend during the next runs (`runs_per_candidate` runs each) and
+         * then uses the fastest one. Does nothing for backends without runtime tiling.
+         */
+        void enable_tiling_autotuner(size_t runs_per_candidate = 1) {
+            auto candidates = tiling_candidates(Backend{}, m_grid);
+            if (candidates.size() < 2)
+                return;
+            m_tuner.reset(new tiling_tuner(wstd::move(candidates), runs_per_candidate));
+            // temporaries are sized for the largest candidate, so that all candidates can use the same buffers
+            m_tmp_tiling = m_tuner->enclosing();
+        }
+
+        /**
+         * @brief True while the autotuner has not yet locked in a tiling.
+         */
+        bool is_tiling_autotuner_active() const { return !!m_tuner; }
+
         std::string print_meter() const {
             assert(m_meter);
             return m_meter->to_string();
@@ -241,6 +427,26 @@ namespace gridtools {
         void reset_meter() {
             assert(m_meter);
             m_meter->reset();
+            reset_stage_meters();
+        }
+
+        /**
+         * @brief Time, number of calls and estimated bytes moved of each multistage and mss component if the
+         * computation is compiled with GT_ENABLE_STAGE_METERS, an empty string otherwise.
+         */
+        std::string print_stage_meters() const { return m_stage_meters.to_string(); }
+
+        void reset_stage_meters() { m_stage_meters.reset(); }
+
+        /**
+         * @brief The fields accessed by a run with the given arguments, bound ones included (see async_run.hpp).
+         */
+        template <class... Args, class... DataStores>
+        std::vector<field_access> field_accesses(arg_storage_pair<Args, DataStores> const &... srcs) const {
+            std::vector<field_access> res;
+            tuple_util::for_each(add_field_accesses_f{res}, m_bound_arg_storage_pair_tuple);
+            tuple_util::for_each(add_field_accesses_f{res}, std::tie(srcs...));
+            return res;
         }
 
         template <class Placeholder,
@@ -256,11 +462,42 @@ namespace gridtools {
             return {};
         }
 
+      private:
+        struct run_interior_f {
+            intermediate *m_self;
+
+            template <class... Args>
+            void operator()(Args const &... args) const {
+                m_self->run_interior(args...);
+            }
+        };
+
+        template <class... Args, class... DataStores>
+        void run_on_grids(std::vector<Grid> const &grids, arg_storage_pair<Args, DataStores> const &... srcs) {
+            GT_STATIC_ASSERT((conjunction<meta::st_contains<free_placeholders_t, Args>...>::value),
+                "some placeholders are not used in mss descriptors");
+            GT_STATIC_ASSERT(
+                meta::is_set_fast<meta::list<Args...>>::value, "free placeholders should be all different");
+            m_async_runs.wait_for_conflicts(field_accesses(srcs...));
+            if (m_meter)
+                m_meter->start();
+            {
+                tmp_buffers_t tmp_buffers;
+                tmp_buffers.reserve(meta::length<tmp_alias_groups_t>::value);
+                auto tmps = check_out_temporaries(tmp_buffers);
+                auto const &local_domains = update_local_domains(tmps, srcs...);
+                for (auto const &grid : grids)
+                    execute(local_domains, grid, m_tiling);
+            }
+            if (m_meter)
+                m_meter->pause();
+        }
+
         template <class... Args, class... DataStores>
-        local_domains_t const &local_domains(arg_storage_pair<Args, DataStores> const &... srcs) {
+        local_domains_t const &update_local_domains(
+            tmp_arg_storage_pair_tuple_t const &tmps, arg_storage_pair<Args, DataStores> const &... srcs) {
             _impl::update_local_domains(
-                tuple_util::flatten(
-                    std::make_tuple(m_tmp_arg_storage_pair_tuple, m_bound_arg_storage_pair_tuple, std::tie(srcs...))),
+                tuple_util::flatten(std::make_tuple(tmps, m_bound_arg_storage_pair_tuple, std::tie(srcs...))),
                 m_local_domains);
             return m_local_domains;
         }
@@ -9,6 +9,8 @@
  */
 #pragma once
 
+#include <vector>
+
 #include "../common/functional.hpp"
 #include "../common/hymap.hpp"
 #include "../common/tuple_util.hpp"
@@ -19,7 +21,10 @@
 #include "local_domain.hpp"
 #include "mss_components.hpp"
 #include "sid/concept.hpp"
+#include "tiling.hpp"
+#include "tmp_aliasing.hpp"
 #include "tmp_storage.hpp"
+#include "tmp_storage_pool.hpp"
 
 namespace gridtools {
     namespace _impl {
@@ -72,10 +77,11 @@ namespace gridtools {
         struct get_tmp_arg_storage_pair_generator {
             template <class ArgStoragePair>
             struct generator {
-                template <class Grid>
-                ArgStoragePair operator()(Grid const &grid) const {
-                    return tmp_storage::make_tmp_data_store<MaxExtent>(
-                        Backend{}, typename ArgStoragePair::arg_t{}, grid);
+                template <class Grid, class Handles>
+                ArgStoragePair operator()(Grid const &grid, tiling const &requested, Handles &buffers) const {
+                    using arg_t = typename ArgStoragePair::arg_t;
+                    return make_pooled_data_store<Backend, typename arg_t::data_store_t>(
+                        tmp_storage::make_tmp_storage_info<MaxExtent>(Backend{}, arg_t{}, grid, requested), buffers);
                 }
             };
 
@@ -83,11 +89,89 @@ namespace gridtools {
             GT_META_DEFINE_ALIAS(apply, meta::id, generator<T>);
         };
 
-        template <class MaxExtent, class Backend, class Res, class Grid>
-        Res make_tmp_arg_storage_pairs(Grid const &grid) {
+        /**
+         * @brief Creates the temporaries from buffers of the temporary storage pool of the backend. The checked out
+         * buffers are added to `buffers` and are returned to the pool when it gets destroyed.
+         */
+        template <class MaxExtent, class Backend, class Res, class Grid, class Handles>
+        Res check_out_tmp_arg_storage_pairs(Grid const &grid, tiling const &requested, Handles &buffers) {
             using generators = GT_META_CALL(
                 meta::transform, (get_tmp_arg_storage_pair_generator<MaxExtent, Backend>::template apply, Res));
-            return tuple_util::generate<generators, Res>(grid);
+            return tuple_util::generate<generators, Res>(grid, requested, buffers);
+        }
+
+        template <class Groups, class Buffers>
+        struct get_tmp_alias_generator {
+            using buffer_args_t = GT_META_CALL(meta::transform, (meta::first, Groups));
+
+            template <class ArgStoragePair>
+            struct generator {
+                using representative_t = GT_META_CALL(
+                    tmp_alias_representative, (Groups, typename ArgStoragePair::arg_t));
+
+                ArgStoragePair operator()(Buffers const &buffers) const {
+                    return tuple_util::get<meta::st_position<buffer_args_t, representative_t>::value>(buffers).m_value;
+                }
+            };
+
+            template <class T>
+            GT_META_DEFINE_ALIAS(apply, meta::id, generator<T>);
+        };
+
+        /**
+         * @brief Creates all temporaries from the buffers of the first temporary of each alias group (see
+         * tmp_aliasing.hpp).
+         */
+        template <class Groups, class Res, class Buffers>
+        Res alias_tmp_arg_storage_pairs(Buffers const &buffers) {
+            using generators = GT_META_CALL(
+                meta::transform, (get_tmp_alias_generator<Groups, Buffers>::template apply, Res));
+            return tuple_util::generate<generators, Res>(buffers);
+        }
+
+        /**
+         * @brief The part of the compute domain of the grid whose points access only points of the compute domain if
+         * the fields are accessed with the given extent. Empty or a single grid.
+         */
+        template <class Extent, class Grid>
+        std::vector<Grid> interior_grids(Grid const &grid) {
+            int_t i_begin = grid.i_low_bound() - Extent::iminus::value;
+            int_t i_end = grid.i_high_bound() - Extent::iplus::value;
+            int_t j_begin = grid.j_low_bound() - Extent::jminus::value;
+            int_t j_end = grid.j_high_bound() - Extent::jplus::value;
+            if (i_begin > i_end || j_begin > j_end)
+                return {};
+            std::vector<Grid> res = {grid};
+            res.front().restrict_compute_domain(i_begin, i_end, j_begin, j_end);
+            return res;
+        }
+
+        /**
+         * @brief The rest of the compute domain: the strips at the low and high end in i over the full j range and
+         * the strips at the low and high end in j next to the interior. The full compute domain if the interior is
+         * empty.
+         */
+        template <class Extent, class Grid>
+        std::vector<Grid> boundary_grids(Grid const &grid) {
+            auto interior = interior_grids<Extent>(grid);
+            if (interior.empty())
+                return {grid};
+            int_t i_low = grid.i_low_bound(), i_high = grid.i_high_bound();
+            int_t j_low = grid.j_low_bound(), j_high = grid.j_high_bound();
+            int_t i_begin = interior.front().i_low_bound(), i_end = interior.front().i_high_bound();
+            int_t j_begin = interior.front().j_low_bound(), j_end = interior.front().j_high_bound();
+            std::vector<Grid> res;
+            auto add = [&](int_t i_first, int_t i_last, int_t j_first, int_t j_last) {
+                if (i_first > i_last || j_first > j_last)
+                    return;
+                res.push_back(grid);
+                res.back().restrict_compute_domain(i_first, i_last, j_first, j_last);
+            };
+            add(i_low, i_begin - 1, j_low, j_high);
+            add(i_end + 1, i_high, j_low, j_high);
+            add(i_begin, i_end, j_low, j_begin - 1);
+            add(i_begin, i_end, j_end + 1, j_high);
+            return res;
         }
 
         template <class MssComponentsList,
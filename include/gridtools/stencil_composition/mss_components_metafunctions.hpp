@@ -13,35 +13,71 @@
 
 #include "../common/defs.hpp"
 #include "../meta.hpp"
+#include "caches/cache_traits.hpp"
 #include "esf_metafunctions.hpp"
+#include "execution_types.hpp"
 #include "mss.hpp"
 #include "mss_components.hpp"
 
 namespace gridtools {
     namespace mss_comonents_metafunctions_impl_ {
+        template <class Arg>
+        struct accesses_f {
+            template <class Esf>
+            GT_META_DEFINE_ALIAS(apply, meta::st_contains, (typename Esf::args_t, Arg));
+        };
+
+        /**
+         * A local cache can be kept by the single esf components only if no other esf of the multistage accesses its
+         * placeholder: the components run one after the other over the whole k range, so the cached values would not
+         * survive until the other esfs read them.
+         */
+        template <class Esfs>
+        struct is_esf_private_cache_f {
+            template <class Cache,
+                class Accessors = GT_META_CALL(meta::filter, (accesses_f<typename Cache::arg_t>::template apply, Esfs))>
+            GT_META_DEFINE_ALIAS(
+                apply, bool_constant, (!is_local_cache<Cache>::value || meta::length<Accessors>::value <= 1));
+        };
+
         GT_META_LAZY_NAMESPACE {
-            template <class>
+            /**
+             * Splits a multistage into single esf components. If FuseKCached is set, vertical multistages that share
+             * a local k cache between several esfs are kept whole instead, so that the backend runs those esfs in the
+             * same k loop and the cached values survive from one esf to the next.
+             */
+            template <bool FuseKCached, class>
             struct mss_split_esfs;
-            template <class ExecutionEngine, class EsfSequence, class CacheSequence>
-            struct mss_split_esfs<mss_descriptor<ExecutionEngine, EsfSequence, CacheSequence>> {
+            template <bool FuseKCached, class ExecutionEngine, class EsfSequence, class CacheSequence>
+            struct mss_split_esfs<FuseKCached, mss_descriptor<ExecutionEngine, EsfSequence, CacheSequence>> {
                 GT_STATIC_ASSERT((meta::all_of<is_esf_descriptor, EsfSequence>::value), GT_INTERNAL_ERROR);
-                template <class Esf>
-                GT_META_DEFINE_ALIAS(
-                    make_mss, meta::id, (mss_descriptor<ExecutionEngine, std::tuple<Esf>, CacheSequence>));
                 using esfs_t = GT_META_CALL(unwrap_independent, EsfSequence);
-                using type = GT_META_CALL(meta::transform, (make_mss, esfs_t));
+                using caches_t = GT_META_CALL(
+                    meta::filter, (is_esf_private_cache_f<esfs_t>::template apply, CacheSequence));
+                template <class Esf>
+                GT_META_DEFINE_ALIAS(make_mss, meta::id, (mss_descriptor<ExecutionEngine, std::tuple<Esf>, caches_t>));
+                using type = conditional_t<FuseKCached && !execute::is_parallel<ExecutionEngine>::value &&
+                                               meta::length<caches_t>::value != meta::length<CacheSequence>::value,
+                    std::tuple<mss_descriptor<ExecutionEngine, EsfSequence, CacheSequence>>,
+                    GT_META_CALL(meta::transform, (make_mss, esfs_t))>;
             };
         }
-        GT_META_DELEGATE_TO_LAZY(mss_split_esfs, class Mss, Mss);
+        GT_META_DELEGATE_TO_LAZY(mss_split_esfs, (bool FuseKCached, class Mss), (FuseKCached, Mss));
+
+        template <bool FuseKCached>
+        struct mss_split_esfs_f {
+            template <class Mss>
+            GT_META_DEFINE_ALIAS(apply, mss_split_esfs, (FuseKCached, Mss));
+        };
 
-        template <bool Fuse, class Msses>
+        template <bool Fuse, bool FuseKCached, class Msses>
         struct split_mss_into_independent_esfs {
-            using mms_lists_t = GT_META_CALL(meta::transform, (mss_split_esfs, Msses));
+            using mms_lists_t = GT_META_CALL(meta::transform, (mss_split_esfs_f<FuseKCached>::template apply, Msses));
             using type = GT_META_CALL(meta::flatten, mms_lists_t);
         };
 
-        template <class Msses>
-        struct split_mss_into_independent_esfs<true, Msses> {
+        template <bool FuseKCached, class Msses>
+        struct split_mss_into_independent_esfs<true, FuseKCached, Msses> {
             using type = Msses;
         };
 
@@ -57,11 +93,12 @@ namespace gridtools {
      * @brief metafunction that builds the array of mss components
      */
     template <bool Fuse,
+        bool FuseKCached,
         class Msses,
         class ExtentMap,
         class Axis,
         class SplitMsses =
-            typename mss_comonents_metafunctions_impl_::split_mss_into_independent_esfs<Fuse, Msses>::type,
+            typename mss_comonents_metafunctions_impl_::split_mss_into_independent_esfs<Fuse, FuseKCached, Msses>::type,
         class Maker = mss_comonents_metafunctions_impl_::make_mms_components_f<ExtentMap, Axis>>
     GT_META_DEFINE_ALIAS(build_mss_components_array, meta::transform, (Maker::template apply, SplitMsses));
 
@@ -25,6 +25,7 @@
 #include "mss_components_metafunctions.hpp"
 #include "mss_loop.hpp"
 #include "run_functor_arguments.hpp"
+#include "stage_meters.hpp"
 
 namespace gridtools {
     /**
@@ -34,7 +35,8 @@ namespace gridtools {
         typename Backend,
         typename LocalDomains,
         typename Grid,
-        typename ExecutionInfo>
+        typename ExecutionInfo,
+        typename StageMeters>
     struct mss_functor {
         GT_STATIC_ASSERT((meta::all_of<is_local_domain, LocalDomains>::value), GT_INTERNAL_ERROR);
         GT_STATIC_ASSERT((meta::all_of<is_mss_components, MssComponentsArray>::value), GT_INTERNAL_ERROR);
@@ -43,6 +45,7 @@ namespace gridtools {
         LocalDomains const &m_local_domains;
         Grid const &m_grid;
         ExecutionInfo m_execution_info;
+        StageMeters &m_stage_meters;
 
         /**
          * \brief given the index of a functor in the functors list ,it calls a kernel on the GPU executing the
@@ -59,15 +62,29 @@ namespace gridtools {
                 typename mss_components_t::execution_engine_t>
                 run_functor_args_t;
 
+            m_stage_meters.start(Index{});
             mss_loop<run_functor_args_t>(Backend{}, std::get<Index::value>(m_local_domains), m_grid, m_execution_info);
+            m_stage_meters.pause(Index{});
         }
     };
 
-    template <class MssComponentsArray, class Backend, class LocalDomains, class Grid, class ExecutionInfo>
-    void run_mss_functors(
-        Backend, LocalDomains const &local_domains, Grid const &grid, ExecutionInfo const &execution_info) {
+    /**
+     * @brief executes all mss components on one block, each of them between the start and pause calls of the stage
+     * meters (see stage_meters.hpp)
+     */
+    template <class MssComponentsArray,
+        class Backend,
+        class LocalDomains,
+        class Grid,
+        class ExecutionInfo,
+        class StageMeters>
+    void run_mss_functors(Backend,
+        LocalDomains const &local_domains,
+        Grid const &grid,
+        ExecutionInfo const &execution_info,
+        StageMeters &stage_meters) {
         for_each<GT_META_CALL(meta::make_indices_for, MssComponentsArray)>(
-            mss_functor<MssComponentsArray, Backend, LocalDomains, Grid, ExecutionInfo>{
-                local_domains, grid, execution_info});
+            mss_functor<MssComponentsArray, Backend, LocalDomains, Grid, ExecutionInfo, StageMeters>{
+                local_domains, grid, execution_info, stage_meters});
     }
 } // namespace gridtools
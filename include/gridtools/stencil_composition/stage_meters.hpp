@@ -0,0 +1,346 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <sstream>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+#ifdef __GNUG__
+#include <cstdlib>
+#include <cxxabi.h>
+#include <memory>
+#endif
+
+#include "../common/defs.hpp"
+#include "../common/generic_metafunctions/for_each.hpp"
+#include "../common/host_device.hpp"
+#include "../common/timer/timer_traits.hpp"
+#include "../meta.hpp"
+#include "esf_metafunctions.hpp"
+#include "extract_placeholders.hpp"
+
+#if defined(GT_ENABLE_STAGE_METERS) && !defined(GT_ENABLE_METERS)
+#error "GT_ENABLE_STAGE_METERS has to be defined before timer_traits.hpp is included"
+#endif
+
+/**
+ * @file
+ *
+ * Timing breakdown of a computation by multistage and mss component.
+ *
+ * The fused loops of the backends call `start(Index)` and `pause(Index)` of a stage meters object around the execution
+ * of the mss component with the given index. The components are the multistages for the backends that fuse the stages
+ * of a multistage (cuda, naive) and mostly the single stages otherwise (x86, mc). The k-parallel loop of the mc
+ * backend executes all components on every k-level of a block, which is too fine-grained to be timed per component:
+ * it calls `start_block_loop()` and `pause_block_loop()` around the blocks executed by each thread instead.
+ *
+ * The stage meters type of a computation is selected by the stage timer of `timer_traits` (see `get_stage_meters`):
+ * `no_stage_meters`, which compiles to nothing, unless GT_ENABLE_STAGE_METERS is defined. Otherwise `stage_meters`
+ * keeps one meter per component and thread. A multistage is reported with the number of runs of the computation, the
+ * time spent in its components averaged over the threads that executed them and an estimate of the bytes moved: every
+ * field accessed by the multistage is assumed to be read once on the compute domain, and written once more if it has
+ * an inout intent. Multistages that are split into several components are followed by the same breakdown for each of
+ * their components.
+ *
+ * GT_ENABLE_STAGE_METERS implies GT_ENABLE_METERS, such that the stage meters use the timers of the backend instead of
+ * timer_dummy. Like GT_ENABLE_METERS, it has to be defined before any GridTools header is included.
+ */
+
+namespace gridtools {
+    /**
+     * @brief Stage meters that do nothing.
+     */
+    struct no_stage_meters {
+        no_stage_meters() = default;
+        template <class Grid>
+        explicit no_stage_meters(Grid const &) {}
+
+        template <class Index>
+        GT_FORCE_INLINE void start(Index) const {}
+        template <class Index>
+        GT_FORCE_INLINE void pause(Index) const {}
+        GT_FORCE_INLINE void start_block_loop() const {}
+        GT_FORCE_INLINE void pause_block_loop() const {}
+
+        void count_run() const {}
+        void reset() const {}
+        std::string to_string() const { return {}; }
+    };
+
+    namespace stage_meters_impl_ {
+        template <class T>
+        std::string type_name() {
+#ifdef __GNUG__
+            int status;
+            std::unique_ptr<char, void (*)(void *)> res{
+                abi::__cxa_demangle(typeid(T).name(), nullptr, nullptr, &status), std::free};
+            if (status == 0)
+                return res.get();
+#endif
+            return typeid(T).name();
+        }
+
+        struct add_functor_name_f {
+            std::string &m_dst;
+
+            template <class Esf>
+            void operator()() const {
+                if (!m_dst.empty())
+                    m_dst += ", ";
+                m_dst += type_name<typename Esf::esf_function_t>();
+            }
+        };
+
+        template <class Esfs>
+        struct add_arg_bytes_f {
+            std::size_t &m_dst;
+
+            template <class Arg>
+            void operator()() const {
+                using value_t = typename Arg::data_store_t::data_t;
+                using rw_args_t = GT_META_CALL(compute_readwrite_args, Esfs);
+                m_dst += (meta::st_contains<rw_args_t, Arg>::value ? 2 : 1) * sizeof(value_t);
+            }
+        };
+
+        /**
+         * Name and estimated bytes moved per run of a multistage or a component.
+         */
+        struct meter_info {
+            std::string name;
+            double bytes_per_run;
+            std::size_t esfs;
+
+            template <class Mss>
+            static meter_info make(char const *kind, std::size_t index, std::size_t points) {
+                using esfs_t = GT_META_CALL(unwrap_independent, typename Mss::esf_sequence_t);
+                std::string functors;
+                for_each_type<esfs_t>(add_functor_name_f{functors});
+                std::size_t bytes_per_point = 0;
+                for_each_type<GT_META_CALL(extract_placeholders_from_mss, Mss)>(
+                    add_arg_bytes_f<esfs_t>{bytes_per_point});
+                std::ostringstream name;
+                name << kind << ' ' << index << " (" << functors << ")";
+                return {name.str(), static_cast<double>(points) * bytes_per_point, meta::length<esfs_t>::value};
+            }
+        };
+    } // namespace stage_meters_impl_
+
+    /**
+     * @brief Meters for each multistage and mss component of a computation, see above.
+     */
+    template <class Timer, class Msses, class MssComponentsArray>
+    class stage_meters {
+        using meter_info = stage_meters_impl_::meter_info;
+
+        std::size_t m_threads;
+        std::size_t m_runs = 0;
+        std::vector<meter_info> m_msses;
+        std::vector<meter_info> m_components;
+        // per component, the index of its multistage
+        std::vector<std::size_t> m_component_msses;
+        // m_threads meters per component, followed by the ones of the block loop
+        std::vector<Timer> m_meters;
+        // per meter, the last run in which the thread executed the component
+        std::vector<std::size_t> m_last_runs;
+        // per component and for the block loop, the runs before the current one that executed it
+        std::vector<std::size_t> m_counts;
+
+        struct add_mss_f {
+            stage_meters &m_self;
+            std::size_t m_points;
+
+            template <class Mss>
+            void operator()() const {
+                m_self.m_msses.push_back(meter_info::make<Mss>("multistage", m_self.m_msses.size(), m_points));
+            }
+        };
+
+        struct add_component_f {
+            stage_meters &m_self;
+            std::size_t m_points;
+            std::size_t &m_mss;
+            std::size_t &m_mss_esfs;
+
+            template <class MssComponents>
+            void operator()() const {
+                auto info = meter_info::make<typename MssComponents::mss_descriptor_t>(
+                    "component", m_self.m_components.size(), m_points);
+                // the components of a multistage follow each other and cover all of its esfs
+                if (m_mss_esfs == m_self.m_msses[m_mss].esfs) {
+                    ++m_mss;
+                    m_mss_esfs = 0;
+                }
+                m_mss_esfs += info.esfs;
+                m_self.m_component_msses.push_back(m_mss);
+                for (std::size_t t = 0; t != m_self.m_threads; ++t)
+                    m_self.m_meters.emplace_back(info.name);
+                m_self.m_components.push_back(std::move(info));
+            }
+        };
+
+        std::size_t block_loop() const { return m_components.size(); }
+
+        std::size_t slot(std::size_t meter) const {
+            assert(omp_get_thread_num() < m_threads);
+            return meter * m_threads + omp_get_thread_num();
+        }
+
+        void start_meter(std::size_t meter) {
+            auto i = slot(meter);
+            m_last_runs[i] = m_runs;
+            m_meters[i].start();
+        }
+
+        bool executed_in_current_run(std::size_t meter) const {
+            for (std::size_t t = 0; t != m_threads; ++t)
+                if (m_runs && m_last_runs[meter * m_threads + t] == m_runs)
+                    return true;
+            return false;
+        }
+
+        std::size_t meter_count(std::size_t meter) const { return m_counts[meter] + executed_in_current_run(meter); }
+
+        double meter_time(std::size_t meter) const {
+            double sum = 0;
+            std::size_t threads = 0;
+            for (std::size_t t = 0; t != m_threads; ++t) {
+                auto const &timer = m_meters[meter * m_threads + t];
+                if (timer.count() == 0)
+                    continue;
+                sum += timer.total_time();
+                ++threads;
+            }
+            return threads ? sum / threads : 0;
+        }
+
+        static void print_line(
+            std::ostream &out, std::string const &name, double time, std::size_t count, double bytes) {
+            out << name << "\t[s]\t";
+            if (time < 0 || std::isnan(time))
+                out << "NO_TIMES_AVAILABLE";
+            else
+                out << time;
+            out << " (" << count << "x called)\t[GB]\t" << 1e-9 * bytes << '\n';
+        }
+
+      public:
+        template <class Grid>
+        explicit stage_meters(Grid const &grid) : m_threads(omp_get_max_threads()) {
+            std::size_t points = (grid.i_high_bound() - grid.i_low_bound() + 1) *
+                                 (grid.j_high_bound() - grid.j_low_bound() + 1) * grid.k_total_length();
+            for_each_type<Msses>(add_mss_f{*this, points});
+            m_meters.reserve((meta::length<MssComponentsArray>::value + 1) * m_threads);
+            std::size_t mss = 0;
+            std::size_t mss_esfs = 0;
+            for_each_type<MssComponentsArray>(add_component_f{*this, points, mss, mss_esfs});
+            for (std::size_t t = 0; t != m_threads; ++t)
+                m_meters.emplace_back("block loop");
+            m_last_runs.resize(m_meters.size(), 0);
+            m_counts.resize(size() + 1, 0);
+        }
+
+        template <class Index>
+        void start(Index) {
+            start_meter(Index::value);
+        }
+
+        template <class Index>
+        void pause(Index) {
+            m_meters[slot(Index::value)].pause();
+        }
+
+        void start_block_loop() { start_meter(block_loop()); }
+
+        void pause_block_loop() { m_meters[slot(block_loop())].pause(); }
+
+        /**
+         * @brief Has to be called once per run of the computation, before the components are executed.
+         */
+        void count_run() {
+            for (std::size_t i = 0; i != m_counts.size(); ++i)
+                if (executed_in_current_run(i))
+                    ++m_counts[i];
+            ++m_runs;
+        }
+
+        /// number of components
+        std::size_t size() const { return m_components.size(); }
+
+        std::string const &name(std::size_t i) const { return m_components[i].name; }
+
+        /// number of runs that executed the component
+        std::size_t count(std::size_t i) const { return meter_count(i); }
+
+        /// time spent in the component, averaged over the threads that executed it [s]
+        double total_time(std::size_t i) const { return meter_time(i); }
+
+        /// estimated bytes moved by the component
+        double bytes(std::size_t i) const { return m_components[i].bytes_per_run * count(i); }
+
+        void reset() {
+            m_runs = 0;
+            for (auto &meter : m_meters)
+                meter.reset();
+            std::fill(m_last_runs.begin(), m_last_runs.end(), 0);
+            std::fill(m_counts.begin(), m_counts.end(), 0);
+        }
+
+        /**
+         * @brief One line per multistage with the time, the number of runs and the estimated bytes moved, followed by
+         * an indented line per component if the multistage is split, and by a line for the block loop if it was
+         * timed instead of the components.
+         */
+        std::string to_string() const {
+            std::ostringstream out;
+            for (std::size_t m = 0; m != m_msses.size(); ++m) {
+                double time = 0;
+                std::size_t count = 0;
+                std::vector<std::size_t> components;
+                for (std::size_t i = 0; i != size(); ++i) {
+                    if (m_component_msses[i] != m)
+                        continue;
+                    time += total_time(i);
+                    count = std::max(count, this->count(i));
+                    components.push_back(i);
+                }
+                print_line(out, m_msses[m].name, time, count, m_msses[m].bytes_per_run * count);
+                if (components.size() > 1)
+                    for (std::size_t i : components)
+                        print_line(out, '\t' + name(i), total_time(i), this->count(i), bytes(i));
+            }
+            if (std::size_t count = meter_count(block_loop()))
+                print_line(out, "block loop (all multistages)", meter_time(block_loop()), count, 0);
+            return out.str();
+        }
+    };
+
+    /**
+     * @brief The stage meters of a computation: `no_stage_meters` if the backend has no stage timer.
+     */
+    template <class Backend,
+        class Msses,
+        class MssComponentsArray,
+        class Timer = typename timer_traits<Backend>::stage_timer_type>
+    struct get_stage_meters {
+        using type = stage_meters<Timer, Msses, MssComponentsArray>;
+    };
+
+    template <class Backend, class Msses, class MssComponentsArray>
+    struct get_stage_meters<Backend, Msses, MssComponentsArray, timer_dummy> {
+        using type = no_stage_meters;
+    };
+} // namespace gridtools
@@ -9,6 +9,9 @@
  */
 #pragma once
 
+#include <algorithm>
+#include <vector>
+
 #include "../../../common/defs.hpp"
 #include "../../../common/host_device.hpp"
 #include "./execinfo_mc.hpp"
@@ -22,4 +25,44 @@ namespace gridtools {
     uint_t block_j_size(backend::mc const &, Grid const &grid) {
         return execinfo_mc{grid}.j_block_size();
     }
+    template <class Grid>
+    uint_t block_i_size(backend::mc const &, Grid const &grid, tiling const &requested) {
+        return execinfo_mc{grid, requested}.i_block_size();
+    }
+    template <class Grid>
+    uint_t block_j_size(backend::mc const &, Grid const &grid, tiling const &requested) {
+        return execinfo_mc{grid, requested}.j_block_size();
+    }
+
+    /**
+     * @brief Tilings that are tried by the autotuner, the default one first.
+     *
+     * Along i the full domain and its halves down to eight points are tried, along j powers of two up to twice
+     * the default block size. Only tilings that produce at least one block per thread are kept.
+     */
+    template <class Grid>
+    std::vector<tiling> tiling_candidates(backend::mc const &, Grid const &grid) {
+        const int_t i_size = grid.i_high_bound() - grid.i_low_bound() + 1;
+        const int_t j_size = grid.j_high_bound() - grid.j_low_bound() + 1;
+        const int_t threads = omp_get_max_threads();
+        const execinfo_mc default_exinfo(grid);
+
+        std::vector<tiling> res = {{default_exinfo.i_block_size(), default_exinfo.j_block_size()}};
+        auto add = [&](int_t i_block_size, int_t j_block_size) {
+            const int_t blocks =
+                (i_size + i_block_size - 1) / i_block_size * ((j_size + j_block_size - 1) / j_block_size);
+            const tiling candidate = {i_block_size, j_block_size};
+            if (blocks >= threads && std::find(res.begin(), res.end(), candidate) == res.end())
+                res.push_back(candidate);
+        };
+        const int_t max_j_block_size = std::min(2 * default_exinfo.j_block_size(), j_size);
+        for (int_t i_block_size = i_size; i_block_size > 0; i_block_size = (i_block_size + 1) / 2) {
+            for (int_t j_block_size = 1; j_block_size <= max_j_block_size; j_block_size *= 2)
+                add(i_block_size, j_block_size);
+            add(i_block_size, default_exinfo.j_block_size());
+            if (i_block_size <= 8)
+                break;
+        }
+        return res;
+    }
 } // namespace gridtools
@@ -10,8 +10,11 @@
 
 #pragma once
 
+#include <algorithm>
+
 #include "../../../common/defs.hpp"
 #include "../../../common/host_device.hpp"
+#include "../../tiling.hpp"
 
 namespace gridtools {
 
@@ -65,6 +68,22 @@ namespace gridtools {
             assert(m_i_block_size > 0 && m_j_block_size > 0);
         }
 
+        /**
+         * @brief Uses the block sizes of the given tiling (clamped to the grid size) instead of the default ones.
+         * Zero block sizes in the tiling fall back to the defaults.
+         */
+        template <class Grid>
+        execinfo_mc(const Grid &grid, tiling const &requested) : execinfo_mc(grid) {
+            if (requested.i_block_size > 0) {
+                m_i_block_size = std::min(requested.i_block_size, m_i_grid_size);
+                m_i_blocks = (m_i_grid_size + m_i_block_size - 1) / m_i_block_size;
+            }
+            if (requested.j_block_size > 0) {
+                m_j_block_size = std::min(requested.j_block_size, m_j_grid_size);
+                m_j_blocks = (m_j_grid_size + m_j_block_size - 1) / m_j_block_size;
+            }
+        }
+
         /**
          * @brief Computes the effective (clamped) block size and position for k-serial stencils.
          *
@@ -10,9 +10,11 @@
 #pragma once
 
 #include <cmath>
+#include <type_traits>
 
 #include "../../../common/generic_metafunctions/for_each.hpp"
 #include "../../../common/hymap.hpp"
+#include "../../../common/tuple_util.hpp"
 #include "../../../meta.hpp"
 #include "../../iterate_domain_aux.hpp"
 #include "../../iterate_domain_fwd.hpp"
@@ -66,68 +68,183 @@ namespace gridtools {
                 sid::shift(ptr, sid::get_stride<dim::j>(strides), m_j_block_base);
             }
         };
+
+        template <class LocalDomain, class Dim, class Offset>
+        struct shift_ptr_f {
+            typename LocalDomain::strides_map_t const &m_strides_map;
+            typename LocalDomain::ptr_map_t &m_ptr_map;
+            Offset m_offset;
+
+            template <class Arg>
+            GT_FORCE_INLINE void operator()() const {
+                using sid_t = GT_META_CALL(storage_from_arg, (LocalDomain, Arg));
+                using strides_kind_t = GT_META_CALL(sid::strides_kind, sid_t);
+                auto const &strides = at_key<strides_kind_t>(m_strides_map);
+                sid::shift(at_key<Arg>(m_ptr_map), sid::get_stride<Dim>(strides), m_offset);
+            }
+        };
+
+        struct get_i_stride_f {
+            template <class Strides, class Stride = decay_t<decltype(sid::get_stride<dim::i>(std::declval<Strides>()))>>
+            GT_FORCE_INLINE Stride operator()(Strides const &strides) const {
+                return sid::get_stride<dim::i>(strides);
+            }
+        };
+
+        template <class LocalDomain>
+        struct check_i_contiguous_f {
+            typename LocalDomain::strides_map_t const &m_strides_map;
+            bool &m_res;
+
+            template <class Arg,
+                class Data = typename GT_META_CALL(storage_from_arg, (LocalDomain, Arg))::data_t,
+                enable_if_t<std::is_arithmetic<Data>::value, int> = 0>
+            GT_FORCE_INLINE void operator()() const {
+                using sid_t = GT_META_CALL(storage_from_arg, (LocalDomain, Arg));
+                using strides_kind_t = GT_META_CALL(sid::strides_kind, sid_t);
+                m_res = m_res && sid::get_stride<dim::i>(at_key<strides_kind_t>(m_strides_map)) == 1;
+            }
+
+            template <class Arg,
+                class Data = typename GT_META_CALL(storage_from_arg, (LocalDomain, Arg))::data_t,
+                enable_if_t<!std::is_arithmetic<Data>::value, int> = 0>
+            GT_FORCE_INLINE void operator()() const {}
+        };
     } // namespace iterate_domain_mc_impl_
 
     /**
      * @brief Iterate domain class for the MC backend.
+     *
+     * The iterate domain keeps a running pointer per placeholder, which points to the current (i, j, k)-position.
+     * Moving along an axis costs one add per placeholder (multiplied by the distance if it is not a compile-time one)
+     * and dereferencing adds the accessor offset only.
+     *
+     * @tparam IJCachedArgs Temporaries that are accessed only at the k = 0 plane (ij caches, k-parallel execution).
+     * @tparam KCacheExtents Map from temporaries to the extent of their k caches. The accesses to these temporaries
+     * are wrapped around a ring of (kplus - kminus + 1) k-planes, which requires the k-loop to be the outermost loop
+     * of the multistage.
      */
-    template <class LocalDomain, class IJCachedArgs>
+    template <class LocalDomain, class IJCachedArgs, class KCacheExtents = meta::list<>>
     class iterate_domain_mc {
         GT_STATIC_ASSERT(is_local_domain<LocalDomain>::value, GT_INTERNAL_ERROR);
 
+        using i_strides_map_t = decltype(tuple_util::host::transform(
+            iterate_domain_mc_impl_::get_i_stride_f{}, std::declval<typename LocalDomain::strides_map_t const &>()));
+
         typename LocalDomain::strides_map_t const &m_strides_map;
-        typename LocalDomain::ptr_map_t m_ptr_map;
-        int_t m_i_block_index; /** Local i-index inside block. */
-        int_t m_j_block_index; /** Local j-index inside block. */
-        int_t m_k_block_index; /** Local/global k-index (no blocking along k-axis). */
-        int_t m_i_block_base;  /** Global block start index along i-axis. */
-        int_t m_j_block_base;  /** Global block start index along j-axis. */
+        i_strides_map_t m_i_strides;               /** Strides along the i-axis, for the points of the i-loop. */
+        typename LocalDomain::ptr_map_t m_ptr_map; /** Pointers to the current position. */
+        int_t m_i_block_index;                     /** Local i-index inside block. */
+        int_t m_j_block_index;                     /** Local j-index inside block. */
+        int_t m_k_block_index;                     /** Local/global k-index (no blocking along k-axis). */
+        int_t m_i_block_base;                      /** Global block start index along i-axis. */
+        int_t m_j_block_base;                      /** Global block start index along j-axis. */
+
+        using k_cached_args_t = GT_META_CALL(meta::transform, (meta::first, KCacheExtents));
+
+        template <class Arg>
+        GT_META_DEFINE_ALIAS(is_memory_arg,
+            bool_constant,
+            (!meta::st_contains<IJCachedArgs, Arg>::value && !meta::st_contains<k_cached_args_t, Arg>::value));
+
+        // ij-cached and ring-buffered placeholders don't move along k, their k-plane is resolved in deref
+        using k_moving_args_t = GT_META_CALL(meta::filter, (is_memory_arg, typename LocalDomain::esf_args_t));
+
+        template <class Dim, class Args, class Offset>
+        GT_FORCE_INLINE void shift_ptrs(Offset offset) {
+            gridtools::for_each_type<Args>(
+                iterate_domain_mc_impl_::shift_ptr_f<LocalDomain, Dim, Offset>{m_strides_map, m_ptr_map, offset});
+        }
 
       public:
         GT_FORCE_INLINE
         iterate_domain_mc(LocalDomain const &local_domain, int_t i_block_base = 0, int_t j_block_base = 0)
-            : m_strides_map(local_domain.m_strides_map), m_ptr_map(local_domain.make_ptr_map()), m_i_block_index(0),
+            : m_strides_map(local_domain.m_strides_map),
+              m_i_strides(tuple_util::host::transform(iterate_domain_mc_impl_::get_i_stride_f{}, m_strides_map)),
+              m_ptr_map(local_domain.make_ptr_map()), m_i_block_index(0),
               m_j_block_index(0), m_k_block_index(0), m_i_block_base(i_block_base), m_j_block_base(j_block_base) {
             gridtools::for_each_type<typename LocalDomain::esf_args_t>(
                 iterate_domain_mc_impl_::set_base_offset_f<LocalDomain>{
                     local_domain, i_block_base, j_block_base, m_ptr_map});
         }
 
+        /** @brief Moves the current position along the i-axis. */
+        template <class Offset = integral_constant<int_t, 1>>
+        GT_FORCE_INLINE void increment_i(Offset offset = {}) {
+            m_i_block_index += offset;
+            shift_ptrs<dim::i, typename LocalDomain::esf_args_t>(offset);
+        }
+        /** @brief Moves the current position along the j-axis. */
+        template <class Offset = integral_constant<int_t, 1>>
+        GT_FORCE_INLINE void increment_j(Offset offset = {}) {
+            m_j_block_index += offset;
+            shift_ptrs<dim::j, typename LocalDomain::esf_args_t>(offset);
+        }
+        /** @brief Moves the current position along the k-axis. */
+        template <class Offset = integral_constant<int_t, 1>>
+        GT_FORCE_INLINE void increment_k(Offset offset = {}) {
+            m_k_block_index += offset;
+            shift_ptrs<dim::k, k_moving_args_t>(offset);
+        }
+
         /** @brief Sets the local block index along the i-axis. */
-        GT_FORCE_INLINE void set_i_block_index(int_t i) { m_i_block_index = i; }
+        GT_FORCE_INLINE void set_i_block_index(int_t i) { increment_i(i - m_i_block_index); }
         /** @brief Sets the local block index along the j-axis. */
-        GT_FORCE_INLINE void set_j_block_index(int_t j) { m_j_block_index = j; }
+        GT_FORCE_INLINE void set_j_block_index(int_t j) { increment_j(j - m_j_block_index); }
         /** @brief Sets the local block index along the k-axis. */
-        GT_FORCE_INLINE void set_k_block_index(int_t k) { m_k_block_index = k; }
+        GT_FORCE_INLINE void set_k_block_index(int_t k) { increment_k(k - m_k_block_index); }
 
         /**
-         * @brief Returns the value pointed by an accessor.
+         * @brief Returns the value pointed by an accessor, optionally at a distance along the i-axis from the current
+         * position.
          */
-        template <class Arg, class Accessor, enable_if_t<!meta::st_contains<IJCachedArgs, Arg>::value, int> = 0>
-        GT_FORCE_INLINE auto deref(Accessor const &accessor) const -> decltype(*at_key<Arg>(m_ptr_map)) {
+        template <class Arg,
+            class Accessor,
+            class IOffset = integral_constant<int_t, 0>,
+            enable_if_t<!meta::st_contains<k_cached_args_t, Arg>::value, int> = 0>
+        GT_FORCE_INLINE auto deref(Accessor const &accessor, IOffset i_offset = {}) const
+            -> decltype(*at_key<Arg>(m_ptr_map)) {
             using sid_t = GT_META_CALL(storage_from_arg, (LocalDomain, Arg));
             using strides_kind_t = GT_META_CALL(sid::strides_kind, sid_t);
-            auto const &strides = at_key<strides_kind_t>(m_strides_map);
             GT_META_CALL(sid::ptr_diff_type, sid_t) ptr_offset{};
-            sid::shift(ptr_offset, sid::get_stride<dim::i>(strides), m_i_block_index);
-            sid::shift(ptr_offset, sid::get_stride<dim::j>(strides), m_j_block_index);
-            sid::shift(ptr_offset, sid::get_stride<dim::k>(strides), m_k_block_index);
-            sid::multi_shift(ptr_offset, strides, accessor);
+            sid::shift(ptr_offset, at_key<strides_kind_t>(m_i_strides), i_offset);
+            sid::multi_shift(ptr_offset, at_key<strides_kind_t>(m_strides_map), accessor);
             return *(at_key<Arg>(m_ptr_map) + ptr_offset);
         }
 
-        template <class Arg, class Accessor, enable_if_t<meta::st_contains<IJCachedArgs, Arg>::value, int> = 0>
-        GT_FORCE_INLINE auto deref(Accessor const &accessor) const -> decltype(*at_key<Arg>(m_ptr_map)) {
+        template <class Arg,
+            class Accessor,
+            class IOffset = integral_constant<int_t, 0>,
+            enable_if_t<meta::st_contains<k_cached_args_t, Arg>::value, int> = 0>
+        GT_FORCE_INLINE auto deref(Accessor const &accessor, IOffset i_offset = {}) const
+            -> decltype(*at_key<Arg>(m_ptr_map)) {
             using sid_t = GT_META_CALL(storage_from_arg, (LocalDomain, Arg));
             using strides_kind_t = GT_META_CALL(sid::strides_kind, sid_t);
+            using extent_t = GT_META_CALL(meta::second, (GT_META_CALL(meta::mp_find, (KCacheExtents, Arg))));
+            constexpr int_t kminus = extent_t::kminus::value;
+            constexpr int_t planes = extent_t::kplus::value - kminus + 1;
             auto const &strides = at_key<strides_kind_t>(m_strides_map);
+            const int_t k_offset = host_device::at_key_with_default<dim::k, integral_constant<int_t, 0>>(accessor);
             GT_META_CALL(sid::ptr_diff_type, sid_t) ptr_offset{};
-            sid::shift(ptr_offset, sid::get_stride<dim::i>(strides), m_i_block_index);
-            sid::shift(ptr_offset, sid::get_stride<dim::j>(strides), m_j_block_index);
+            sid::shift(ptr_offset, at_key<strides_kind_t>(m_i_strides), i_offset);
+            sid::shift(ptr_offset, sid::get_stride<dim::k>(strides), (m_k_block_index + k_offset - kminus) % planes);
             sid::multi_shift(ptr_offset, strides, accessor);
+            sid::shift(ptr_offset, sid::get_stride<dim::k>(strides), -k_offset);
             return *(at_key<Arg>(m_ptr_map) + ptr_offset);
         }
 
+        /**
+         * @brief Returns true if the fields of all the given placeholders with arithmetic value types are contiguous
+         * along the i-axis, which is required by the explicit SIMD evaluation.
+         */
+        template <class Args>
+        GT_FORCE_INLINE bool is_i_contiguous() const {
+            bool res = true;
+            gridtools::for_each_type<Args>(
+                iterate_domain_mc_impl_::check_i_contiguous_f<LocalDomain>{m_strides_map, res});
+            return res;
+        }
+
         /** @brief Global i-index. */
         GT_FORCE_INLINE
         int_t i() const { return m_i_block_base + m_i_block_index; }
@@ -141,6 +258,33 @@ namespace gridtools {
         int_t k() const { return m_k_block_index; }
     };
 
-    template <class LocalDomain, class IJCachedArgs>
-    struct is_iterate_domain<iterate_domain_mc<LocalDomain, IJCachedArgs>> : std::true_type {};
+    template <class LocalDomain, class IJCachedArgs, class KCacheExtents>
+    struct is_iterate_domain<iterate_domain_mc<LocalDomain, IJCachedArgs, KCacheExtents>> : std::true_type {};
+
+    /**
+     * @brief A point at a distance along the i-axis from the current position of an MC iterate domain.
+     *
+     * Dereferencing adds the distance times the i-stride of the field to the running pointer, so the points of an
+     * i-loop share the iterate domain and don't depend on each other.
+     */
+    template <class ItDomain>
+    class iterate_domain_mc_i_point {
+        ItDomain const &m_it_domain;
+        int_t m_i_offset;
+
+      public:
+        GT_FORCE_INLINE iterate_domain_mc_i_point(ItDomain const &it_domain, int_t i_offset)
+            : m_it_domain(it_domain), m_i_offset(i_offset) {}
+
+        template <class Arg, class Accessor>
+        GT_FORCE_INLINE auto deref(Accessor const &accessor) const
+            GT_AUTO_RETURN(m_it_domain.template deref<Arg>(accessor, m_i_offset));
+
+        GT_FORCE_INLINE int_t i() const { return m_it_domain.i() + m_i_offset; }
+        GT_FORCE_INLINE int_t j() const { return m_it_domain.j(); }
+        GT_FORCE_INLINE int_t k() const { return m_it_domain.k(); }
+    };
+
+    template <class ItDomain>
+    struct is_iterate_domain<iterate_domain_mc_i_point<ItDomain>> : std::true_type {};
 } // namespace gridtools
@@ -17,6 +17,7 @@
 #include "../../run_functor_arguments.hpp"
 #include "execinfo_mc.hpp"
 #include "iterate_domain_mc.hpp"
+#include "simd_mc.hpp"
 
 /**@file
  * @brief mss loop implementations for the mc backend
@@ -52,36 +53,31 @@ namespace gridtools {
                 const int_t k_first = m_grid.template value_at<From>();
                 const int_t k_last = m_grid.template value_at<To>();
 
+                m_it_domain.set_j_block_index(j_first);
                 for (int_t j = j_first; j < j_last; ++j) {
-                    m_it_domain.set_j_block_index(j);
+                    m_it_domain.set_k_block_index(k_first);
                     for (int_t k = k_first; iteration_policy_t::condition(k, k_last);
                          iteration_policy_t::increment(k)) {
-                        m_it_domain.set_k_block_index(k);
-#ifdef NDEBUG
-#pragma ivdep
-#pragma omp simd
-#endif
-                        for (int_t i = i_first; i < i_last; ++i) {
-                            m_it_domain.set_i_block_index(i);
-                            Stage::exec(m_it_domain);
-                        }
+                        exec_stage_along_i_mc<Stage>(m_it_domain, i_first, i_last);
+                        iteration_policy_t::increment(m_it_domain);
                     }
+                    m_it_domain.increment_j();
                 }
             }
         };
 
         /**
          * @brief Class for inner (block-level) looping.
-         * Specialization for stencils with parallel execution along k-axis.
+         * Specialization for stencils with parallel execution along k-axis and for k-cached stencils, where the
+         * k-loop is the outermost loop.
          *
-         * @tparam RunFunctorArgs Run functor arguments.
-         * @tparam From K-axis level to start with.
-         * @tparam To the last K-axis level to process.
+         * @tparam ItDomain Iterate domain.
+         * @tparam ExecutionInfo Block execution info.
          */
-        template <typename ItDomain>
+        template <typename ItDomain, typename ExecutionInfo = execinfo_block_kparallel_mc>
         struct inner_functor_mc_kparallel {
             ItDomain &m_it_domain;
-            const execinfo_block_kparallel_mc &m_execution_info;
+            const ExecutionInfo &m_execution_info;
 
             /**
              * @brief Executes the corresponding functor on a single k-level inside the block.
@@ -97,16 +93,10 @@ namespace gridtools {
                 const int_t j_first = extent_t::jminus::value;
                 const int_t j_last = m_execution_info.j_block_size + extent_t::jplus::value;
 
+                m_it_domain.set_j_block_index(j_first);
                 for (int_t j = j_first; j < j_last; ++j) {
-                    m_it_domain.set_j_block_index(j);
-#ifdef NDEBUG
-#pragma ivdep
-#pragma omp simd
-#endif
-                    for (int_t i = i_first; i < i_last; ++i) {
-                        m_it_domain.set_i_block_index(i);
-                        Stage::exec(m_it_domain);
-                    }
+                    exec_stage_along_i_mc<Stage>(m_it_domain, i_first, i_last);
+                    m_it_domain.increment_j();
                 }
             }
         };
@@ -135,6 +125,67 @@ namespace gridtools {
             }
         };
 
+        /**
+         * @brief Class for per-block looping on a single interval of a k-cached stencil with serial execution
+         * along k-axis. All stages are executed on a k-level before moving to the next one, so that the k caches only
+         * have to hold a few k-levels of the block.
+         */
+        template <typename ExecutionType, typename ItDomain, typename Grid>
+        struct interval_functor_mc_k_cached {
+            ItDomain &m_it_domain;
+            Grid const &m_grid;
+            execinfo_block_kserial_mc const &m_execution_info;
+
+            template <class From, class To, class StageGroups>
+            GT_FORCE_INLINE void operator()(loop_interval<From, To, StageGroups>) const {
+                using iteration_policy_t = iteration_policy<From, To, ExecutionType>;
+                const int_t k_first = m_grid.template value_at<From>();
+                const int_t k_last = m_grid.template value_at<To>();
+
+                m_it_domain.set_k_block_index(k_first);
+                for (int_t k = k_first; iteration_policy_t::condition(k, k_last); iteration_policy_t::increment(k)) {
+                    gridtools::for_each<GT_META_CALL(meta::flatten, StageGroups)>(
+                        inner_functor_mc_kparallel<ItDomain, execinfo_block_kserial_mc>{
+                            m_it_domain, m_execution_info});
+                    iteration_policy_t::increment(m_it_domain);
+                }
+            }
+        };
+
+        template <class Esfs>
+        struct k_cache_extent_f {
+            template <class Cache, class Arg = typename Cache::arg_t>
+            GT_META_DEFINE_ALIAS(apply, meta::list, (Arg, GT_META_CALL(extract_k_extent_for_cache, (Arg, Esfs))));
+        };
+
+        template <class Cache>
+        GT_META_DEFINE_ALIAS(is_ring_buffered_k_cache,
+            bool_constant,
+            (is_local_cache<Cache>::value && is_tmp_arg<typename Cache::arg_t>::value));
+
+        /**
+         * Map from the k-cached temporaries, that live only within the multistage, to their k extents.
+         * Only those get folded to a ring of k-planes; filling and flushing caches of the other placeholders are
+         * served directly from the main memory, which is hot after the loop reordering. Vertical multistages whose esfs
+         * share a local k cache are not split into single esf components (see build_mss_components_array), so the
+         * ring is kept across those esfs as well.
+         */
+        template <class Caches, class Esfs>
+        GT_META_DEFINE_ALIAS(get_k_cache_extents,
+            meta::transform,
+            (k_cache_extent_f<Esfs>::template apply,
+                GT_META_CALL(meta::filter, (is_ring_buffered_k_cache, GT_META_CALL(k_caches, Caches)))));
+
+        template <typename ExecutionType, typename ItDomain, typename Grid, typename ExecutionInfo, bool HasKCaches>
+        struct get_interval_functor_mc {
+            using type = interval_functor_mc<ExecutionType, ItDomain, Grid, ExecutionInfo>;
+        };
+
+        template <typename ExecutionType, typename ItDomain, typename Grid>
+        struct get_interval_functor_mc<ExecutionType, ItDomain, Grid, execinfo_block_kserial_mc, true> {
+            using type = interval_functor_mc_k_cached<ExecutionType, ItDomain, Grid>;
+        };
+
         /**
          * @brief Class for per-block looping on a single interval.
          * Specialization for stencils with parallel execution along k-axis.
@@ -176,16 +227,26 @@ namespace gridtools {
         GT_STATIC_ASSERT(is_run_functor_arguments<RunFunctorArgs>::value, GT_INTERNAL_ERROR);
         GT_STATIC_ASSERT(is_local_domain<LocalDomain>::value, GT_INTERNAL_ERROR);
         GT_STATIC_ASSERT(is_grid<Grid>::value, GT_INTERNAL_ERROR);
-        using ij_cached_args_t = conditional_t<std::is_same<ExecutionInfo, execinfo_block_kparallel_mc>::value,
-            GT_META_CALL(ij_cache_args, typename LocalDomain::cache_sequence_t),
-            meta::list<>>;
+        using caches_t = typename LocalDomain::cache_sequence_t;
+        static constexpr bool is_kparallel = std::is_same<ExecutionInfo, execinfo_block_kparallel_mc>::value;
+        static constexpr bool has_k_caches = !meta::is_empty<GT_META_CALL(k_caches, caches_t)>::value;
 
-        using iterate_domain_t = iterate_domain_mc<LocalDomain, ij_cached_args_t>;
+        using ij_cached_args_t = conditional_t<is_kparallel, GT_META_CALL(ij_cache_args, caches_t), meta::list<>>;
+        using k_cache_extents_t = conditional_t<is_kparallel,
+            meta::list<>,
+            GT_META_CALL(_impl_mss_loop_mc::get_k_cache_extents, (caches_t, typename RunFunctorArgs::esf_sequence_t))>;
+
+        using iterate_domain_t = iterate_domain_mc<LocalDomain, ij_cached_args_t, k_cache_extents_t>;
 
         iterate_domain_t it_domain(local_domain, execution_info.i_first, execution_info.j_first);
 
-        host::for_each<typename RunFunctorArgs::loop_intervals_t>(_impl_mss_loop_mc::
-                interval_functor_mc<typename RunFunctorArgs::execution_type_t, iterate_domain_t, Grid, ExecutionInfo>{
-                    it_domain, grid, execution_info});
+        using interval_functor_t = typename _impl_mss_loop_mc::get_interval_functor_mc<
+            typename RunFunctorArgs::execution_type_t,
+            iterate_domain_t,
+            Grid,
+            ExecutionInfo,
+            has_k_caches>::type;
+
+        host::for_each<typename RunFunctorArgs::loop_intervals_t>(interval_functor_t{it_domain, grid, execution_info});
     }
 } // namespace gridtools
@@ -0,0 +1,236 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <type_traits>
+
+#include "../../../common/defs.hpp"
+#include "../../../common/host_device.hpp"
+#include "../../../meta.hpp"
+#include "../../accessor_intent.hpp"
+#include "../../bind_functor_with_interval.hpp"
+#include "../../expressions/expr_base.hpp"
+#include "../stage.hpp"
+#include "iterate_domain_mc.hpp"
+
+/**
+ * @file
+ *
+ * Explicit SIMD evaluation of stages in the mc backend.
+ *
+ * A functor opts in by declaring the nested type `using vectorizable = std::true_type;`. The mc backend then evaluates
+ * the stage on as many consecutive points along i at once as one vector holds values of the widest arithmetic field
+ * type of the stage (see `simd_lanes_mc`): accessors to arithmetic fields return compiler vector types (GCC/Clang
+ * vector extensions) that alias the storage, so arithmetic, comparisons and the conditional operator act lane-wise.
+ * Scalars have to be combined with an accessor value before being assigned, e.g. `eval(out()) = 0 * eval(in())`, and
+ * `eval.i()` is not available. The points that do not fill a complete vector, as well as all stages containing a
+ * functor that does not opt in, are evaluated with the regular scalar path.
+ *
+ * The vector width in bytes can be set with GT_MC_SIMD_BYTES; it defaults to the widest vector unit enabled at
+ * compile time. A width of zero disables the explicit SIMD path.
+ */
+
+#ifndef GT_MC_SIMD_BYTES
+#if !defined(__GNUC__)
+#define GT_MC_SIMD_BYTES 0
+#elif defined(__AVX512F__)
+#define GT_MC_SIMD_BYTES 64
+#elif defined(__AVX__)
+#define GT_MC_SIMD_BYTES 32
+#elif defined(__SSE2__) || defined(__ARM_NEON)
+#define GT_MC_SIMD_BYTES 16
+#else
+#define GT_MC_SIMD_BYTES 0
+#endif
+#endif
+
+namespace gridtools {
+    /**
+     * @brief Number of values of type T held by one vector of the explicit SIMD path.
+     */
+    template <class T>
+    struct simd_lanes_mc
+        : integral_constant<int_t, (GT_MC_SIMD_BYTES / sizeof(T) > 1 ? GT_MC_SIMD_BYTES / sizeof(T) : 1)> {};
+
+    /**
+     * @brief Trait testing if a functor opted in the explicit SIMD evaluation.
+     */
+    template <class Functor, class = void>
+    struct is_vectorizable_functor : std::false_type {};
+
+    template <class Functor>
+    struct is_vectorizable_functor<Functor, enable_if_t<Functor::vectorizable::value>> : std::true_type {};
+
+    template <class Functor, class Interval>
+    struct is_vectorizable_functor<_impl::bound_functor<Functor, Interval>> : is_vectorizable_functor<Functor> {};
+
+    namespace simd_mc_impl_ {
+        template <class T>
+        struct is_simd_value : bool_constant<std::is_arithmetic<T>::value && !std::is_same<T, bool>::value> {};
+
+#if GT_MC_SIMD_BYTES > 0
+        template <class T, int_t Lanes>
+        struct arithmetic_vector_type {
+            typedef T type __attribute__((vector_size(Lanes * sizeof(T)), aligned(sizeof(T)), may_alias));
+        };
+
+        template <class T, int_t Lanes>
+        struct vector_type
+            : conditional_t<is_simd_value<T>::value, arithmetic_vector_type<T, Lanes>, meta::lazy::id<T>> {};
+
+        template <class T, int_t Lanes>
+        struct vector_type<T const, Lanes> {
+            using type = typename vector_type<T, Lanes>::type const;
+        };
+#else
+        template <class T, int_t Lanes>
+        struct vector_type {
+            using type = T;
+        };
+#endif
+
+        /**
+         * Vector value type of the field with value type T: the points i, i + 1, ..., i + Lanes - 1 are represented by
+         * one value. Non-arithmetic types (like the ones of global parameters) are not vectorized.
+         */
+        template <class T, int_t Lanes>
+        using vector_t = typename vector_type<T, Lanes>::type;
+
+        template <int_t Lanes, class T>
+        GT_FORCE_INLINE enable_if_t<is_simd_value<T>::value, vector_t<T, Lanes> &> as_vector(T &ref) {
+            return *reinterpret_cast<vector_t<T, Lanes> *>(&ref);
+        }
+
+        template <int_t Lanes, class T>
+        GT_FORCE_INLINE enable_if_t<!is_simd_value<T>::value, T &> as_vector(T &ref) {
+            return ref;
+        }
+
+        /**
+         * Number of lanes required by the field of the placeholder Arg, or zero if its values are not vectorized.
+         */
+        template <class Arg, class = void>
+        struct arg_lanes : integral_constant<int_t, 0> {};
+
+        template <class Arg>
+        struct arg_lanes<Arg, enable_if_t<is_simd_value<typename Arg::data_store_t::data_t>::value>>
+            : simd_lanes_mc<typename Arg::data_store_t::data_t> {};
+
+        // the smaller non-zero number of lanes, zero standing for no requirement
+        constexpr int_t merge_lanes(int_t lhs, int_t rhs) { return lhs == 0 || (rhs != 0 && rhs < lhs) ? rhs : lhs; }
+
+        constexpr int_t merge_lanes(int_t lanes) { return lanes; }
+
+        template <class... Ts>
+        constexpr int_t merge_lanes(int_t lhs, int_t rhs, Ts... rest) {
+            return merge_lanes(merge_lanes(lhs, rhs), rest...);
+        }
+
+        template <class Args>
+        struct args_lanes;
+
+        template <template <class...> class L, class... Args>
+        struct args_lanes<L<Args...>> : integral_constant<int_t, merge_lanes(0, arg_lanes<Args>::value...)> {};
+
+        template <int_t Lanes, class ItDomain, class Args>
+        struct simd_evaluator {
+            ItDomain const &m_it_domain;
+
+            template <class Accessor, class Arg = GT_META_CALL(meta::at_c, (Args, Accessor::index_t::value))>
+            GT_FORCE_INLINE auto operator()(Accessor const &arg) const GT_AUTO_RETURN(
+                apply_intent<Accessor::intent_v>(as_vector<Lanes>(m_it_domain.template deref<Arg>(arg))));
+
+            template <class Op, class... Ts>
+            GT_FORCE_INLINE auto operator()(expr<Op, Ts...> const &arg) const
+                GT_AUTO_RETURN(expressions::evaluation::value(*this, arg));
+
+            GT_FORCE_INLINE int_t j() const { return m_it_domain.j(); }
+            GT_FORCE_INLINE int_t k() const { return m_it_domain.k(); }
+        };
+
+        /**
+         * A stage is evaluated with `lanes` points per vector, given by the widest arithmetic field type it accesses.
+         */
+        template <class Stage>
+        struct simd_stage {
+            static constexpr bool value = false;
+            static constexpr int_t lanes = 0;
+            using args_t = meta::list<>;
+        };
+
+        template <class Functor, class Extent, class Args>
+        struct simd_stage<regular_stage<Functor, Extent, Args>> {
+            static constexpr bool value = is_vectorizable_functor<Functor>::value;
+            static constexpr int_t lanes = args_lanes<Args>::value;
+            using args_t = Args;
+
+            template <int_t Lanes, class ItDomain>
+            static GT_FORCE_INLINE void exec(ItDomain const &it_domain) {
+                simd_evaluator<Lanes, ItDomain, Args> eval{it_domain};
+                Functor::apply(eval);
+            }
+        };
+
+        template <class... Stages>
+        struct simd_stage<compound_stage<Stages...>> {
+            static constexpr bool value = conjunction<bool_constant<simd_stage<Stages>::value>...>::value;
+            static constexpr int_t lanes = merge_lanes(0, simd_stage<Stages>::lanes...);
+            using args_t = GT_META_CALL(meta::concat, typename simd_stage<Stages>::args_t...);
+
+            template <int_t Lanes, class ItDomain>
+            static GT_FORCE_INLINE void exec(ItDomain const &it_domain) {
+                (void)(int[]){((void)simd_stage<Stages>::template exec<Lanes>(it_domain), 0)...};
+            }
+        };
+
+        template <class Stage>
+        struct is_simd_stage : bool_constant<simd_stage<Stage>::value && (simd_stage<Stage>::lanes > 1)> {};
+
+        template <class Stage, class ItDomain, enable_if_t<is_simd_stage<Stage>::value, int> = 0>
+        GT_FORCE_INLINE int_t exec_vectorized(ItDomain &it_domain, int_t i_first, int_t i_last) {
+            constexpr int_t lanes = simd_stage<Stage>::lanes;
+            if (!it_domain.template is_i_contiguous<typename simd_stage<Stage>::args_t>())
+                return i_first;
+            int_t i = i_first;
+            for (; i + lanes <= i_last; i += lanes) {
+                simd_stage<Stage>::template exec<lanes>(it_domain);
+                it_domain.increment_i(integral_constant<int_t, lanes>{});
+            }
+            return i;
+        }
+
+        template <class Stage, class ItDomain, enable_if_t<!is_simd_stage<Stage>::value, int> = 0>
+        GT_FORCE_INLINE int_t exec_vectorized(ItDomain &, int_t i_first, int_t) {
+            return i_first;
+        }
+    } // namespace simd_mc_impl_
+
+    /**
+     * @brief Executes a stage on the points [i_first, i_last) of the current j- and k-position of the iterate domain.
+     *
+     * Vectorizable stages are evaluated with explicit SIMD vectors as long as complete vectors fit. The remaining
+     * points and the non-vectorizable stages are evaluated point-wise by a loop left to the auto-vectorizer: every
+     * point indexes the fields at its distance from the first point times their i-strides, so the iterations don't
+     * depend on each other through the running pointers.
+     */
+    template <class Stage, class ItDomain>
+    GT_FORCE_INLINE void exec_stage_along_i_mc(ItDomain &it_domain, int_t i_first, int_t i_last) {
+        it_domain.set_i_block_index(i_first);
+        const int_t i_rest = simd_mc_impl_::exec_vectorized<Stage>(it_domain, i_first, i_last);
+        const int_t i_size = i_last - i_rest;
+#ifdef NDEBUG
+#pragma ivdep
+#pragma omp simd
+#endif
+        for (int_t i = 0; i < i_size; ++i)
+            Stage::exec(iterate_domain_mc_i_point<ItDomain>(it_domain, i));
+        it_domain.set_i_block_index(i_last);
+    }
+} // namespace gridtools
@@ -11,20 +11,135 @@
 
 #include <utility>
 
+#include <boost/fusion/include/as_map.hpp>
+#include <boost/fusion/include/at_key.hpp>
+#include <boost/fusion/include/std_tuple.hpp>
+
 #include "../../../common/defs.hpp"
 #include "../../../common/host_device.hpp"
+#include "../../../meta.hpp"
+#include "../../arg.hpp"
+#include "../../caches/cache_metafunctions.hpp"
+#include "../../caches/iterate_domain_cache_aux.hpp"
+#include "../../esf_metafunctions.hpp"
 #include "../../iterate_domain_fwd.hpp"
+#include "../../iteration_policy.hpp"
+#include "../../sid/concept.hpp"
+#include "../dim.hpp"
 #include "../iterate_domain.hpp"
 
 namespace gridtools {
+    namespace iterate_domain_x86_impl_ {
+        template <class Args>
+        struct contains_arg_f {
+            template <class Cache>
+            GT_META_DEFINE_ALIAS(apply, meta::st_contains, (Args, typename Cache::arg_t));
+        };
+
+        template <class Cache>
+        GT_META_DEFINE_ALIAS(is_synced_k_cache,
+            bool_constant,
+            (!is_local_cache<Cache>::value || !is_tmp_arg<typename Cache::arg_t>::value));
+    } // namespace iterate_domain_x86_impl_
+
     /**
      * @brief iterate domain class for the X86 backend
+     *
+     * The x86 backend executes every stage as a separate multistage, column by column. k caches are therefore kept
+     * coherent with the main memory independently of their io policy: a ring buffer is filled for every k cached
+     * placeholder of the stage and flushed if the stage writes to it. This keeps the semantics of the multistage
+     * intact and saves the repeated loads of the vertical neighbours. Only local caches of temporaries skip the main
+     * memory: those that are shared with other stages are dropped when the multistage is split (see
+     * build_mss_components_array), so the remaining ones are never accessed outside of the stage.
      */
     template <typename IterateDomainArguments>
     struct iterate_domain_x86 : iterate_domain<IterateDomainArguments> {
-        using iterate_domain<IterateDomainArguments>::iterate_domain;
+      private:
+        using base_t = iterate_domain<IterateDomainArguments>;
+        using local_domain_t = typename IterateDomainArguments::local_domain_t;
+        using esf_sequence_t = typename IterateDomainArguments::esf_sequence_t;
+
+        using k_caches_t = GT_META_CALL(meta::filter,
+            (iterate_domain_x86_impl_::contains_arg_f<typename local_domain_t::esf_args_t>::template apply,
+                GT_META_CALL(k_caches, typename local_domain_t::cache_sequence_t)));
+        using k_cache_args_t = GT_META_CALL(meta::transform, (cache_parameter, k_caches_t));
+        using synced_k_cache_args_t = GT_META_CALL(meta::transform,
+            (cache_parameter,
+                GT_META_CALL(meta::filter, (iterate_domain_x86_impl_::is_synced_k_cache, k_caches_t))));
+        using flushing_k_cache_args_t = GT_META_CALL(meta::filter,
+            (meta::curry<meta::st_contains, GT_META_CALL(compute_readwrite_args, esf_sequence_t)>::template apply,
+                synced_k_cache_args_t));
+
+        using k_caches_tuple_t = typename boost::fusion::result_of::as_map<
+            typename get_k_cache_storage_tuple<k_caches_t, esf_sequence_t>::type>::type;
+
+        mutable k_caches_tuple_t m_k_caches_tuple;
+
+      public:
+        static constexpr bool has_k_caches = !meta::is_empty<k_caches_t>::value;
+
+        using base_t::base_t;
+
+        /**
+         * @brief all the points visited by the x86 mss loop are within the extent of the stage
+         */
+        template <typename Extent>
+        GT_FORCE_INLINE bool is_thread_in_domain() const {
+            return true;
+        }
+
+        template <typename IterationPolicy>
+        GT_FORCE_INLINE void slide_caches() {
+            GT_STATIC_ASSERT(is_iteration_policy<IterationPolicy>::value, GT_INTERNAL_ERROR);
+            _impl::slide_caches<k_cache_args_t, typename IterationPolicy::execution_type>(m_k_caches_tuple);
+        }
+
+        /**
+         * fill next k level from main memory for all k caches. The position of the kcache being filled
+         * depends on the iteration policy
+         * \tparam IterationPolicy forward: backward
+         */
+        template <typename IterationPolicy>
+        GT_FORCE_INLINE void fill_caches(bool first_level) {
+            GT_STATIC_ASSERT(is_iteration_policy<IterationPolicy>::value, GT_INTERNAL_ERROR);
+            _impl::sync_caches<synced_k_cache_args_t, typename IterationPolicy::execution_type, sync_type::fill>(
+                *this, m_k_caches_tuple, first_level);
+        }
+
+        /**
+         * flush the last k level of the ring buffer into main memory. The position of the kcache being flushed
+         * depends on the iteration policy
+         * \tparam IterationPolicy forward: backward
+         */
+        template <typename IterationPolicy>
+        GT_FORCE_INLINE void flush_caches(bool last_level) {
+            GT_STATIC_ASSERT(is_iteration_policy<IterationPolicy>::value, GT_INTERNAL_ERROR);
+            _impl::sync_caches<flushing_k_cache_args_t, typename IterationPolicy::execution_type, sync_type::flush>(
+                *this, m_k_caches_tuple, last_level);
+        }
+
+        template <class Arg, class DataStore = typename Arg::data_store_t, class Data = typename DataStore::data_t>
+        GT_FORCE_INLINE Data *deref_for_k_cache(int_t k_offset) const {
+            using storage_info_t = typename DataStore::storage_info_t;
+            static constexpr auto storage_info_index =
+                meta::st_position<typename local_domain_t::strides_kinds_t, storage_info_t>::value;
+
+            auto offset = this->m_index[storage_info_index];
+            sid::shift(offset,
+                sid::get_stride<dim::k>(host_device::at_key<storage_info_t>(this->m_local_domain.m_strides_map)),
+                k_offset);
+
+            return offset < host_device::at_key<storage_info_t>(this->m_local_domain.m_total_length_map) && offset >= 0
+                       ? host_device::at_key<Arg>(this->m_ptr_map) + offset
+                       : nullptr;
+        }
+
+        template <class Arg, class Accessor, enable_if_t<meta::st_contains<k_cache_args_t, Arg>::value, int> = 0>
+        GT_FORCE_INLINE typename Arg::data_store_t::data_t &deref(Accessor const &acc) const {
+            return boost::fusion::at_key<Arg>(m_k_caches_tuple).at(acc);
+        }
 
-        template <class Arg, class Accessor>
+        template <class Arg, class Accessor, enable_if_t<!meta::st_contains<k_cache_args_t, Arg>::value, int> = 0>
         GT_FORCE_INLINE auto deref(Accessor const &acc) const GT_AUTO_RETURN(*this->template get_ptr<Arg>(acc));
     };
 
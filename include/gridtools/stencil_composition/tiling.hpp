@@ -0,0 +1,96 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <vector>
+
+#include "../common/defs.hpp"
+
+/**
+ * @file
+ *
+ * Runtime tiling of the horizontal iteration space and its autotuner.
+ *
+ * Backends with a runtime block size (currently mc) provide the overloads
+ *   - uint_t block_i_size(Backend, Grid, tiling)
+ *   - uint_t block_j_size(Backend, Grid, tiling)
+ *   - std::vector<tiling> tiling_candidates(Backend, Grid)
+ * The fallbacks in block.hpp ignore the requested tiling and return no candidates, which makes tuning a no-op.
+ */
+namespace gridtools {
+
+    /**
+     * @brief Block sizes along i and j. A zero block size requests the backend default.
+     */
+    struct tiling {
+        int_t i_block_size;
+        int_t j_block_size;
+    };
+
+    inline bool operator==(tiling const &lhs, tiling const &rhs) {
+        return lhs.i_block_size == rhs.i_block_size && lhs.j_block_size == rhs.j_block_size;
+    }
+    inline bool operator!=(tiling const &lhs, tiling const &rhs) { return !(lhs == rhs); }
+
+    /**
+     * @brief Times every candidate tiling for a fixed number of runs and selects the fastest one.
+     *
+     * The minimum over the runs of a candidate is taken as its cost, which filters out first-touch and warm-up noise
+     * if more than one run per candidate is requested.
+     */
+    class tiling_tuner {
+        std::vector<tiling> m_candidates;
+        std::vector<double> m_times;
+        size_t m_runs_per_candidate;
+        size_t m_runs = 0;
+
+      public:
+        tiling_tuner(std::vector<tiling> candidates, size_t runs_per_candidate)
+            : m_candidates(std::move(candidates)),
+              m_times(m_candidates.size(), std::numeric_limits<double>::infinity()),
+              m_runs_per_candidate(std::max(runs_per_candidate, size_t(1))) {}
+
+        /** @brief True when all candidates have been timed (or if there is nothing to tune). */
+        bool done() const { return m_runs >= m_candidates.size() * m_runs_per_candidate; }
+
+        /** @brief The candidate that should be used for the next run. */
+        tiling const &current() const {
+            assert(!done());
+            return m_candidates[m_runs / m_runs_per_candidate];
+        }
+
+        /** @brief Records the time of a run with the current candidate and advances to the next run. */
+        void record(double time) {
+            assert(!done());
+            double &dst = m_times[m_runs / m_runs_per_candidate];
+            dst = std::min(dst, time);
+            ++m_runs;
+        }
+
+        /** @brief The fastest candidate seen so far. */
+        tiling best() const {
+            assert(!m_candidates.empty());
+            return m_candidates[std::min_element(m_times.begin(), m_times.end()) - m_times.begin()];
+        }
+
+        /** @brief The largest block sizes over all candidates, used to size temporaries during tuning. */
+        tiling enclosing() const {
+            tiling res{1, 1};
+            for (auto const &candidate : m_candidates) {
+                res.i_block_size = std::max(res.i_block_size, candidate.i_block_size);
+                res.j_block_size = std::max(res.j_block_size, candidate.j_block_size);
+            }
+            return res;
+        }
+    };
+} // namespace gridtools
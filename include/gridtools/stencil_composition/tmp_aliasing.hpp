@@ -0,0 +1,131 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+
+#include "../common/defs.hpp"
+#include "../meta.hpp"
+
+/**
+ * @file
+ *
+ * Compile-time liveness analysis of temporaries.
+ *
+ * The multistages of a computation are executed one after another (within a block, for the backends that block the
+ * domain). A temporary is live from the first to the last multistage that accesses it. Temporaries with the same data
+ * store type (and thus the same size, as all temporaries are allocated with the same maximal extent) whose live
+ * ranges do not overlap can share their memory.
+ *
+ * Facade API:
+ *   tmp_alias_groups<Msses, TmpArgs>: list of groups (lists) of temporaries that can share one buffer, where Msses is a
+ *   list with the list of placeholders accessed by each multistage, in execution order, and TmpArgs are the
+ *   temporaries that need memory
+ *   tmp_alias_representative<Groups, Arg>: the first temporary of the group containing Arg
+ */
+namespace gridtools {
+    namespace tmp_aliasing_impl_ {
+        template <class Msses, class Arg>
+        struct uses_arg_f {
+            template <class I>
+            GT_META_DEFINE_ALIAS(apply, meta::st_contains, (GT_META_CALL(meta::at, (Msses, I)), Arg));
+        };
+
+        // indices of the multistages accessing Arg
+        template <class Msses, class Arg>
+        GT_META_DEFINE_ALIAS(live_multistages,
+            meta::filter,
+            (uses_arg_f<Msses, Arg>::template apply, GT_META_CALL(meta::make_indices_for, Msses)));
+
+        template <class Msses, class Arg>
+        GT_META_DEFINE_ALIAS(first_use, meta::first, (GT_META_CALL(live_multistages, (Msses, Arg))));
+
+        template <class Msses, class Arg>
+        GT_META_DEFINE_ALIAS(last_use, meta::last, (GT_META_CALL(live_multistages, (Msses, Arg))));
+
+        /// temporaries sharing one buffer, LastUse is the last multistage accessing one of them
+        template <class DataStore, class LastUse, class Args>
+        struct group {
+            using data_store_t = DataStore;
+            using last_use_t = LastUse;
+            using args_t = Args;
+        };
+
+        template <class Msses, class Arg>
+        struct fits_f {
+            template <class Group>
+            GT_META_DEFINE_ALIAS(apply,
+                bool_constant,
+                (std::is_same<typename Group::data_store_t, typename Arg::data_store_t>::value &&
+                    Group::last_use_t::value < GT_META_CALL(first_use, (Msses, Arg))::value));
+        };
+
+        template <class Msses, class Arg>
+        GT_META_DEFINE_ALIAS(new_group,
+            meta::id,
+            (group<typename Arg::data_store_t, GT_META_CALL(last_use, (Msses, Arg)), meta::list<Arg>>));
+
+        template <class Msses,
+            class Groups,
+            class Arg,
+            std::size_t Pos =
+                meta::find<GT_META_CALL(meta::transform, (fits_f<Msses, Arg>::template apply, Groups)),
+                    std::true_type>::value,
+            bool Found = (Pos < meta::length<Groups>::value)>
+        struct add_arg;
+
+        template <class Msses, class Groups, class Arg, std::size_t Pos>
+        struct add_arg<Msses, Groups, Arg, Pos, false> {
+            using type = GT_META_CALL(meta::push_back, (Groups, GT_META_CALL(new_group, (Msses, Arg))));
+        };
+
+        template <class Msses, class Groups, class Arg, std::size_t Pos>
+        struct add_arg<Msses, Groups, Arg, Pos, true> {
+            using old_t = GT_META_CALL(meta::at_c, (Groups, Pos));
+            using new_t = group<typename old_t::data_store_t,
+                GT_META_CALL(last_use, (Msses, Arg)),
+                GT_META_CALL(meta::push_back, (typename old_t::args_t, Arg))>;
+            using type = GT_META_CALL(meta::replace, (Groups, old_t, new_t));
+        };
+
+        template <class Msses>
+        struct add_arg_f {
+            template <class Groups, class Arg>
+            GT_META_DEFINE_ALIAS(apply, meta::id, (typename add_arg<Msses, Groups, Arg>::type));
+        };
+
+        template <class Group>
+        GT_META_DEFINE_ALIAS(get_args, meta::id, typename Group::args_t);
+
+        template <class Arg>
+        struct contains_f {
+            template <class Args>
+            GT_META_DEFINE_ALIAS(apply, meta::st_contains, (Args, Arg));
+        };
+    } // namespace tmp_aliasing_impl_
+
+    /**
+     * Greedy assignment of the temporaries (in order) to groups whose members are all dead before the temporary is
+     * first accessed.
+     */
+    template <class Msses, class TmpArgs>
+    GT_META_DEFINE_ALIAS(tmp_alias_groups,
+        meta::transform,
+        (tmp_aliasing_impl_::get_args,
+            GT_META_CALL(
+                meta::lfold, (tmp_aliasing_impl_::add_arg_f<Msses>::template apply, meta::list<>, TmpArgs))));
+
+    template <class Groups, class Arg>
+    GT_META_DEFINE_ALIAS(tmp_alias_representative,
+        meta::first,
+        (GT_META_CALL(meta::first,
+            (GT_META_CALL(meta::filter, (tmp_aliasing_impl_::contains_f<Arg>::template apply, Groups))))));
+} // namespace gridtools
@@ -14,7 +14,8 @@
  *  API for the temporary storage allocation/offsets
  *
  *  Facade API:
- *    1. DataStore make_tmp_data_store<MaxExtent>(Backend, Arg, Grid);
+ *    1. DataStore make_tmp_data_store<MaxExtent>(Backend, Arg, Grid[, Tiling]);
+ *       StorageInfo tmp_storage::make_tmp_storage_info<MaxExtent>(Backend, Arg, Grid[, Tiling]);
  *    2. int_t get_tmp_storage_offset<StorageInfo, MaxExtent>(Backend, Strides, BlockIds, PositionsInBlock);
  *  where:
  *    MaxExtent - integral_constant with maximal absolute extent in I direction.
@@ -22,6 +23,7 @@
  *    Backend  - instantiation of backend
  *    Arg      - instantiation of arg
  *    Grid     - instantiation of grid
+ *    Tiling   - runtime block sizes the temporary should accommodate (the backend default if omitted)
  *    Strides  - 3D struct with the strides that are taken from the DataStore, returned by make_tmp_data_store
  *    BlockIds - 3D struct that specifies the position of the block in the i,j,k directions
  *    PositionsInBlock - 3D struct that specifies the position of the target point within the block
@@ -76,30 +78,42 @@ namespace gridtools {
         }
 
         template <class MaxExtent, class ArgTag, class DataStore, int_t I, uint_t NColors, class Backend, class Grid>
-        DataStore make_tmp_data_store(
-            Backend backend, plh<ArgTag, DataStore, location_type<I, NColors>, true>, Grid const &grid) {
+        typename DataStore::storage_info_t make_tmp_storage_info(Backend backend,
+            plh<ArgTag, DataStore, location_type<I, NColors>, true>,
+            Grid const &grid,
+            tiling const &requested = {}) {
             GT_STATIC_ASSERT(is_grid<Grid>::value, GT_INTERNAL_ERROR);
             using storage_info_t = typename DataStore::storage_info_t;
-            return {make_storage_info<storage_info_t, NColors>(backend,
+            return make_storage_info<storage_info_t, NColors>(backend,
                 get_i_size<storage_info_t, MaxExtent>(
-                    backend, block_i_size(backend, grid), grid.i_high_bound() - grid.i_low_bound() + 1),
+                    backend, block_i_size(backend, grid, requested), grid.i_high_bound() - grid.i_low_bound() + 1),
                 get_j_size<storage_info_t, MaxExtent>(
-                    backend, block_j_size(backend, grid), grid.j_high_bound() - grid.j_low_bound() + 1),
-                get_k_size<storage_info_t, MaxExtent>(backend, block_k_size(backend, grid), grid.k_total_length()))};
+                    backend, block_j_size(backend, grid, requested), grid.j_high_bound() - grid.j_low_bound() + 1),
+                get_k_size<storage_info_t, MaxExtent>(backend, block_k_size(backend, grid), grid.k_total_length()));
+        }
+
+        template <class MaxExtent, class ArgTag, class DataStore, int_t I, uint_t NColors, class Backend, class Grid>
+        DataStore make_tmp_data_store(Backend backend,
+            plh<ArgTag, DataStore, location_type<I, NColors>, true> arg,
+            Grid const &grid,
+            tiling const &requested = {}) {
+            return {make_tmp_storage_info<MaxExtent>(backend, arg, grid, requested)};
         }
     } // namespace tmp_storage
 
     template <class MaxExtent, class ArgTag, class DataStore, int_t I, uint_t NColors, class Backend, class Grid>
-    DataStore make_tmp_data_store(
-        Backend backend, plh<ArgTag, DataStore, location_type<I, NColors>, true>, Grid const &grid) {
+    DataStore make_tmp_data_store(Backend backend,
+        plh<ArgTag, DataStore, location_type<I, NColors>, true>,
+        Grid const &grid,
+        tiling const &requested = {}) {
         GT_STATIC_ASSERT(is_grid<Grid>::value, GT_INTERNAL_ERROR);
         using namespace tmp_storage;
         using storage_info_t = typename DataStore::storage_info_t;
         return {make_storage_info<storage_info_t, NColors>(backend,
             get_i_size<storage_info_t, MaxExtent>(
-                backend, block_i_size(backend, grid), grid.i_high_bound() - grid.i_low_bound() + 1),
+                backend, block_i_size(backend, grid, requested), grid.i_high_bound() - grid.i_low_bound() + 1),
             get_j_size<storage_info_t, MaxExtent>(
-                backend, block_j_size(backend, grid), grid.j_high_bound() - grid.j_low_bound() + 1),
+                backend, block_j_size(backend, grid, requested), grid.j_high_bound() - grid.j_low_bound() + 1),
             get_k_size<storage_info_t, MaxExtent>(backend, block_k_size(backend, grid), grid.k_total_length()))};
     }
 
@@ -0,0 +1,201 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+#include "../common/defs.hpp"
+#include "../storage/common/definitions.hpp"
+
+#include "./backend_cuda/tmp_storage_pool.hpp"
+#include "./backend_mc/tmp_storage_pool.hpp"
+
+/**
+ * @file
+ *
+ * Process-wide pool of the memory of temporaries.
+ *
+ * Computations check out the buffers for their temporaries at the beginning of each run and return them at the end.
+ * Computations that run one after another therefore share the same memory, and the memory held by the pool is bounded
+ * by the largest single computation instead of the sum over all computations. The data stores wrapping the buffers
+ * are kept with them and reused by the next checkout that creates the same temporary, such that a run does not
+ * allocate anything once the pool is warm.
+ *
+ * Backend API (the fallbacks use the global operator new and delete and host memory):
+ *   void *tmp_pool_allocate(Backend, std::size_t bytes);
+ *   void tmp_pool_free(Backend, void *ptr);
+ *   ownership tmp_pool_ownership(Backend);
+ */
+namespace gridtools {
+    template <class Backend>
+    void *tmp_pool_allocate(Backend const &, std::size_t bytes) {
+        return ::operator new(bytes);
+    }
+
+    template <class Backend>
+    void tmp_pool_free(Backend const &, void *ptr) {
+        ::operator delete(ptr);
+    }
+
+    template <class Backend>
+    constexpr ownership tmp_pool_ownership(Backend const &) {
+        return ownership::external_cpu;
+    }
+
+    /**
+     * @brief Pool of temporary buffers of a backend.
+     *
+     * A checkout returns the smallest idle buffer that is large enough. If there is none, a new buffer is allocated
+     * and the largest idle buffer that was too small is freed, so that the pool adapts to growing requests without
+     * accumulating memory.
+     */
+    template <class Backend>
+    class tmp_storage_pool {
+        struct deleter_f {
+            void operator()(void *ptr) const { tmp_pool_free(Backend{}, ptr); }
+        };
+
+        struct buffer {
+            std::size_t size;
+            std::unique_ptr<void, deleter_f> ptr;
+            // object wrapping the buffer, destroyed before the buffer is freed
+            std::type_info const *cached_type;
+            std::shared_ptr<void> cached;
+        };
+
+        std::mutex m_mutex;
+        std::vector<buffer> m_idle;
+        std::size_t m_allocated = 0;
+
+        tmp_storage_pool() = default;
+
+        void give_back(buffer &&src) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_idle.push_back(std::move(src));
+        }
+
+      public:
+        /**
+         * @brief A checked out buffer. It is returned to the pool on destruction.
+         */
+        class handle {
+            tmp_storage_pool *m_pool;
+            buffer m_buffer;
+
+          public:
+            handle(tmp_storage_pool &pool, buffer &&src) : m_pool(&pool), m_buffer(std::move(src)) {}
+            handle(handle &&) = default;
+            handle &operator=(handle &&) = delete;
+            ~handle() {
+                if (m_buffer.ptr)
+                    m_pool->give_back(std::move(m_buffer));
+            }
+
+            void *get() const { return m_buffer.ptr.get(); }
+            std::size_t size() const { return m_buffer.size; }
+
+            /**
+             * @brief An object of type T kept with the buffer across checkouts. The object kept by the previous
+             * checkout is reused if it is a T for which `reusable` returns true, otherwise it is replaced by `make()`.
+             */
+            template <class T, class Reusable, class Make>
+            T const &cached(Reusable &&reusable, Make &&make) {
+                if (!m_buffer.cached || *m_buffer.cached_type != typeid(T) ||
+                    !reusable(*static_cast<T const *>(m_buffer.cached.get()))) {
+                    m_buffer.cached = std::make_shared<T>(make());
+                    m_buffer.cached_type = &typeid(T);
+                }
+                return *static_cast<T const *>(m_buffer.cached.get());
+            }
+        };
+
+        tmp_storage_pool(tmp_storage_pool const &) = delete;
+        tmp_storage_pool &operator=(tmp_storage_pool const &) = delete;
+
+        static tmp_storage_pool &instance() {
+            static tmp_storage_pool res;
+            return res;
+        }
+
+        /** @brief Checks out a buffer of at least the given size in bytes. */
+        handle check_out(std::size_t bytes) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto best = m_idle.end();
+            auto largest_too_small = m_idle.end();
+            for (auto it = m_idle.begin(); it != m_idle.end(); ++it) {
+                if (it->size >= bytes) {
+                    if (best == m_idle.end() || it->size < best->size)
+                        best = it;
+                } else if (largest_too_small == m_idle.end() || it->size > largest_too_small->size) {
+                    largest_too_small = it;
+                }
+            }
+            if (best != m_idle.end()) {
+                buffer res = std::move(*best);
+                m_idle.erase(best);
+                return {*this, std::move(res)};
+            }
+            if (largest_too_small != m_idle.end()) {
+                m_allocated -= largest_too_small->size;
+                m_idle.erase(largest_too_small);
+            }
+            buffer res{bytes, std::unique_ptr<void, deleter_f>(tmp_pool_allocate(Backend{}, bytes)), nullptr, {}};
+            m_allocated += bytes;
+            return {*this, std::move(res)};
+        }
+
+        /** @brief Frees all buffers that are not checked out. */
+        void release() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (auto const &buf : m_idle)
+                m_allocated -= buf.size;
+            m_idle.clear();
+        }
+
+        /** @brief Total size in bytes of the buffers owned by the pool, checked out or not. */
+        std::size_t allocated_bytes() {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_allocated;
+        }
+    };
+
+    /**
+     * @brief Creates a data store using pooled memory. The buffer is added to `buffers` and has to outlive the data
+     * store. The data store is cached with the buffer, such that the next checkout of the buffer for a temporary with
+     * the same storage info returns a copy of it instead of a new one.
+     */
+    template <class Backend, class DataStore, class Handles>
+    DataStore make_pooled_data_store(typename DataStore::storage_info_t const &info, Handles &buffers) {
+        using data_t = typename DataStore::data_t;
+        constexpr std::size_t align = DataStore::storage_info_t::alignment_t::value
+                                          ? DataStore::storage_info_t::alignment_t::value * sizeof(data_t)
+                                          : sizeof(data_t);
+        buffers.push_back(
+            tmp_storage_pool<Backend>::instance().check_out((info.padded_total_length() + align) * sizeof(data_t)));
+        // align the first element of the inner region like the owning storages do
+        auto first = reinterpret_cast<std::uintptr_t>(buffers.back().get()) +
+                     info.first_index_of_inner_region() * sizeof(data_t);
+        auto *ptr = reinterpret_cast<data_t *>(buffers.back().get()) + (align - first % align) % align / sizeof(data_t);
+        return buffers.back().template cached<DataStore>(
+            [&](DataStore const &ds) {
+                return ds.valid() && *ds.get_storage_info_ptr() == info &&
+                       ds.get_storage_ptr()->get_target_ptr() == ptr;
+            },
+            [&] { return DataStore(info, ptr, tmp_pool_ownership(Backend{})); });
+    }
+} // namespace gridtools
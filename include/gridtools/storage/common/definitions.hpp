@@ -18,7 +18,12 @@ namespace gridtools {
      * @{
      */
 
-    enum class ownership { external_gpu, external_cpu };
+    /**
+     * @brief Memory of data stores created from an external pointer: external_gpu and external_cpu storages
+     * allocate the copy on the other side, external_gpu_only storages (device memory that is never accessed from the
+     * host, like the one of temporaries) have no host copy.
+     */
+    enum class ownership { external_gpu, external_cpu, external_gpu_only };
     enum class access_mode { read_write = 0, read_only = 1 };
 
     /**
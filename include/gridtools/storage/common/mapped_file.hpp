@@ -0,0 +1,136 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#pragma once
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace gridtools {
+
+    /** \ingroup storage
+     * @{
+     */
+
+    /**
+     * @brief How a file-backed storage treats its file.
+     */
+    enum class file_mode {
+        create, // the file is created, or truncated if it exists, and zero-initialized
+        open    // the file must exist and have the size of the storage, its contents are the initial data
+    };
+
+    /**
+     * @brief Size in bytes of the file of a storage of `size` elements of type T whose inner region is aligned to
+     * `align` elements. It leaves room for the alignment of every host storage, such that their files can be
+     * exchanged.
+     */
+    template <class T>
+    constexpr std::size_t storage_file_size(std::size_t size, std::size_t align) {
+        return (size + align) * sizeof(T);
+    }
+
+    /**
+     * @brief A file mapped into memory, shared such that writes to the memory end up in the file, or private.
+     *
+     * The pages of the file are only read when touched, thus a mapping may be larger than the physical memory.
+     */
+    class mapped_file {
+        void *m_data = nullptr;
+        std::size_t m_size;
+
+        // closes the file, if open, and throws an error with the reason of the failure
+        static void fail(int fd, std::string const &what, std::string const &path) {
+            std::string reason = std::strerror(errno);
+            if (fd >= 0)
+                ::close(fd);
+            throw std::runtime_error(what + " " + path + ": " + reason);
+        }
+
+      public:
+        /**
+         * @param path Path of the file
+         * @param size Size of the mapping in bytes
+         * @param mode Whether the file is created or opened
+         */
+        mapped_file(std::string const &path, std::size_t size, file_mode mode) : m_size(size) {
+            int fd = ::open(path.c_str(), mode == file_mode::create ? O_RDWR | O_CREAT | O_TRUNC : O_RDWR, 0644);
+            if (fd < 0)
+                fail(fd, "cannot open", path);
+            struct stat st;
+            if (mode == file_mode::create ? ftruncate(fd, size) != 0 : fstat(fd, &st) != 0)
+                fail(fd, "cannot size", path);
+            if (mode == file_mode::open && std::size_t(st.st_size) != size) {
+                ::close(fd);
+                throw std::runtime_error("size of " + path + " is " + std::to_string(st.st_size) +
+                                         " bytes instead of " + std::to_string(size));
+            }
+            if (size) {
+                m_data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+                if (m_data == MAP_FAILED)
+                    fail(fd, "cannot map", path);
+            }
+            // the mapping keeps the file referenced
+            ::close(fd);
+        }
+
+        /**
+         * @brief Maps an existing file as a whole and privately: modifications of the memory are not written to the
+         * file (copy-on-write).
+         * @param path Path of the file
+         */
+        explicit mapped_file(std::string const &path) {
+            int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0)
+                fail(fd, "cannot open", path);
+            struct stat st;
+            if (fstat(fd, &st) != 0)
+                fail(fd, "cannot size", path);
+            m_size = st.st_size;
+            if (m_size) {
+                m_data = mmap(nullptr, m_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+                if (m_data == MAP_FAILED)
+                    fail(fd, "cannot map", path);
+            }
+            ::close(fd);
+        }
+
+        mapped_file(mapped_file const &) = delete;
+        mapped_file &operator=(mapped_file const &) = delete;
+
+        ~mapped_file() {
+            if (m_data)
+                munmap(m_data, m_size);
+        }
+
+        void *data() const { return m_data; }
+        std::size_t size() const { return m_size; }
+
+        /**
+         * @brief Writes the modified pages back to the file and waits for completion.
+         */
+        void sync() const {
+            if (m_data && msync(m_data, m_size, MS_SYNC) != 0)
+                throw std::runtime_error(std::string("cannot sync mapped file: ") + std::strerror(errno));
+        }
+    };
+
+    /**
+     * @}
+     */
+} // namespace gridtools
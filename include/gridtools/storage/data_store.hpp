@@ -21,6 +21,7 @@
 #include "../meta/type_traits.hpp"
 #include "../meta/utility.hpp"
 #include "./common/definitions.hpp"
+#include "./common/mapped_file.hpp"
 #include "./common/storage_info.hpp"
 #include "./common/storage_interface.hpp"
 
@@ -192,6 +193,26 @@ namespace gridtools {
                   (info.length() == 0) ? nullptr : (new storage_t(info.padded_total_length(), external_ptr, own))),
               m_shared_storage_info((info.length() == 0) ? nullptr : (new storage_info_t(info))), m_name(name) {}
 
+        /**
+         * @brief data_store constructor. This constructor maps the given file and uses it as the memory of the
+         * data_store, with the same alignment and padding as an allocated one. A data_store created with
+         * file_mode::create thus leaves a file that can be opened with file_mode::open by a data_store with the same
+         * storage info type and instance, also of another host storage. Only supported by host storages. Like with an
+         * external pointer, no file is used if the storage info is empty.
+         * @param info storage info instance
+         * @param path path of the file
+         * @param mode whether the file is created (zero-initialized) or opened
+         * @param name Human readable name for the data_store
+         */
+        data_store(StorageInfo const &info, std::string const &path, file_mode mode, std::string const &name = "")
+            : m_shared_storage((info.length() == 0) ? nullptr
+                                                    : new storage_t(info.padded_total_length(),
+                                                          path,
+                                                          mode,
+                                                          info.first_index_of_inner_region(),
+                                                          typename StorageInfo::alignment_t{})),
+              m_shared_storage_info((info.length() == 0) ? nullptr : (new storage_info_t(info))), m_name(name) {}
+
         // Explicit defaulting prevents nvcc to implicitly generate them with __device__
         data_store(data_store &&other) = default;
         data_store(data_store const &other) = default;
@@ -323,6 +344,11 @@ namespace gridtools {
          */
         void sync() const { this->m_shared_storage->sync(); }
 
+        /**
+         * @brief write the data of a file-backed data_store back to its file (msync), no-op for other data_stores
+         */
+        void sync_file() const { this->m_shared_storage->sync_file(); }
+
         /**
          * @brief reactivate all device read write views to storage
          */
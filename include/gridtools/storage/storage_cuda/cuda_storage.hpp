@@ -51,6 +51,7 @@ namespace gridtools {
         DataType *m_cpu_ptr;
         state_machine m_state;
         uint_t m_size;
+        bool m_device_only = false;
 
       public:
         /*
@@ -74,15 +75,17 @@ namespace gridtools {
          * Allocates memory either on Host or Device.
          * @param size defines the size of the storage and the allocated space.
          * @param external_ptr a pointer to the external data
-         * @param own ownership information (external CPU pointer, or external GPU pointer)
+         * @param own ownership information (external CPU pointer, external GPU pointer, or external GPU pointer
+         * without host copy)
          */
         explicit cuda_storage(uint_t size, DataType *external_ptr, ownership own)
-            : m_gpu_ptr_holder(own != ownership::external_gpu ? cuda_util::cuda_malloc<DataType>(size)
+            : m_gpu_ptr_holder(own == ownership::external_cpu ? cuda_util::cuda_malloc<DataType>(size)
                                                               : cuda_util::unique_cuda_ptr<DataType>()),
-              m_cpu_ptr_holder(own == ownership::external_cpu ? nullptr : new DataType[size]),
-              m_gpu_ptr(own == ownership::external_gpu ? external_ptr : m_gpu_ptr_holder.get()),
+              m_cpu_ptr_holder(own == ownership::external_gpu ? new DataType[size] : nullptr),
+              m_gpu_ptr(own == ownership::external_cpu ? m_gpu_ptr_holder.get() : external_ptr),
               m_cpu_ptr(own == ownership::external_cpu ? external_ptr : m_cpu_ptr_holder.get()),
-              m_state{own != ownership::external_cpu, own != ownership::external_gpu}, m_size{size} {
+              m_state{own == ownership::external_gpu, own == ownership::external_cpu}, m_size{size},
+              m_device_only(own == ownership::external_gpu_only) {
             assert(external_ptr);
         }
 
@@ -115,6 +118,7 @@ namespace gridtools {
             swap(m_cpu_ptr, other.m_cpu_ptr);
             swap(m_state, other.m_state);
             swap(m_size, other.m_size);
+            swap(m_device_only, other.m_device_only);
         }
 
         /*
@@ -155,6 +159,7 @@ namespace gridtools {
          * @brief clone_from_device implementation for cuda_storage.
          */
         void clone_from_device_impl() {
+            GT_ASSERT_OR_THROW(m_cpu_ptr, "CPU pointer seems not initialized.");
             GT_CUDA_CHECK(cudaMemcpy(m_cpu_ptr, m_gpu_ptr, m_size * sizeof(DataType), cudaMemcpyDeviceToHost));
             m_state = {};
         }
@@ -163,8 +168,8 @@ namespace gridtools {
          * @brief synchronization implementation for cuda_storage.
          */
         void sync_impl() {
-            // check if we can avoid syncing (in case neither host or device needs an update)
-            if (!m_state.m_hnu && !m_state.m_dnu)
+            // check if we can avoid syncing (in case neither host or device needs an update, or there is no host copy)
+            if (m_device_only || (!m_state.m_hnu && !m_state.m_dnu))
                 return;
             // invalid state occurs when both host and device would need an update.
             GT_ASSERT_OR_THROW((m_state.m_hnu ^ m_state.m_dnu), "invalid state detected.");
@@ -210,7 +215,7 @@ namespace gridtools {
         /*
          * @brief valid implementation for cuda_storage.
          */
-        bool valid_impl() const { return m_cpu_ptr && m_gpu_ptr; }
+        bool valid_impl() const { return (m_cpu_ptr || m_device_only) && m_gpu_ptr; }
     };
 
     // simple metafunction to check if a type is a cuda storage
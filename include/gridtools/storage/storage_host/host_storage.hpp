@@ -12,13 +12,46 @@
 
 #include <cassert>
 #include <cstddef>
+#include <memory>
+#include <new>
+#include <string>
+#include <type_traits>
 #include <utility>
 
+#include "../../common/gt_assert.hpp"
+#include "../../common/hugepage_arena.hpp"
 #include "../common/alignment.hpp"
+#include "../common/mapped_file.hpp"
 #include "../common/state_machine.hpp"
 #include "../common/storage_interface.hpp"
 
 namespace gridtools {
+    namespace host_storage_impl_ {
+        /*
+         * @brief Default constructs size elements in memory taken from the default_hugepage_arena.
+         */
+        template <typename DataType>
+        DataType *allocate(uint_t size) {
+            auto *ptr = static_cast<DataType *>(hugepage_arena_alloc(size * sizeof(DataType)));
+            for (uint_t i = 0; i < size; ++i)
+                new (ptr + i) DataType;
+            return ptr;
+        }
+
+        /*
+         * @brief Destroys and frees the elements allocated by allocate.
+         */
+        template <typename DataType>
+        struct deleter {
+            uint_t size;
+
+            void operator()(DataType *ptr) const {
+                for (uint_t i = 0; i < size; ++i)
+                    ptr[i].~DataType();
+                hugepage_arena_free(ptr);
+            }
+        };
+    } // namespace host_storage_impl_
 
     /** \ingroup storage
      * @{
@@ -42,23 +75,52 @@ namespace gridtools {
         typedef state_machine state_machine_t;
 
       private:
-        std::unique_ptr<DataType[]> m_holder;
+        std::unique_ptr<DataType, host_storage_impl_::deleter<DataType>> m_holder;
+        std::shared_ptr<mapped_file> m_file;
         DataType *m_ptr;
 
+        template <uint_t Align>
+        void align(DataType *allocated_ptr, uint_t offset_to_align) {
+            // The arena and mmap align addresses to 64 bytes, thus according to the size(DataType)
+            auto delta =
+                (reinterpret_cast<std::uintptr_t>(allocated_ptr + offset_to_align) % (Align * sizeof(DataType))) /
+                sizeof(DataType);
+            m_ptr = delta == 0 ? allocated_ptr : allocated_ptr + (Align - delta);
+        }
+
       public:
         /*
-         * @brief host_storage constructor. Just allocates enough memory on the Host.
+         * @brief host_storage constructor. Just allocates enough memory on the Host, sharing huge-page slabs with
+         * other storages (see hugepage_arena).
          * @param size defines the size of the storage and the allocated space.
          */
         template <uint_t Align = 1>
         host_storage(uint_t size, uint_t offset_to_align = 0u, alignment<Align> = alignment<1u>{})
-            : m_holder(new DataType[size + Align - 1]), m_ptr(nullptr) {
-            auto *allocated_ptr = m_holder.get();
-            // New will align addresses according to the size(DataType)
-            auto delta =
-                (reinterpret_cast<std::uintptr_t>(allocated_ptr + offset_to_align) % (Align * sizeof(DataType))) /
-                sizeof(DataType);
-            m_ptr = delta == 0 ? allocated_ptr : allocated_ptr + (Align - delta);
+            : m_holder(host_storage_impl_::allocate<DataType>(size + Align - 1),
+                  host_storage_impl_::deleter<DataType>{size + Align - 1}),
+              m_ptr(nullptr) {
+            align<Align>(m_holder.get(), offset_to_align);
+        }
+
+        /*
+         * @brief host_storage constructor. Maps the given file and uses it as memory, with the same alignment as
+         * the allocating constructor. Thus the data is only read from the file when touched and modifications can be
+         * written back to the file with sync_file.
+         * @param size defines the size of the storage and the mapped space.
+         * @param path path of the file
+         * @param mode whether the file is created or opened
+         */
+        template <uint_t Align = 1>
+        host_storage(uint_t size,
+            std::string const &path,
+            file_mode mode,
+            uint_t offset_to_align = 0u,
+            alignment<Align> = alignment<1u>{})
+            : m_file(std::make_shared<mapped_file>(path, storage_file_size<DataType>(size, Align), mode)),
+              m_ptr(nullptr) {
+            GT_STATIC_ASSERT(std::is_trivially_copyable<DataType>::value,
+                "file-backed storages require a trivially copyable data type");
+            align<Align>(static_cast<DataType *>(m_file->data()), offset_to_align);
         }
 
         /*
@@ -96,6 +158,7 @@ namespace gridtools {
         void swap_impl(host_storage &other) {
             using std::swap;
             swap(m_holder, other.m_holder);
+            swap(m_file, other.m_file);
             swap(m_ptr, other.m_ptr);
         }
 
@@ -106,6 +169,15 @@ namespace gridtools {
         DataType *get_cpu_ptr() const { return m_ptr; }
 
         DataType *get_target_ptr() const { return m_ptr; }
+
+        /*
+         * @brief writes the data of a file-backed storage back to its file, no-op for other storages.
+         */
+        void sync_file() const {
+            if (m_file)
+                m_file->sync();
+        }
+
         /*
          * @brief valid implementation for host_storage.
          */
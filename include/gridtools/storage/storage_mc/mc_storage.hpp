@@ -11,14 +11,72 @@
 #pragma once
 
 #include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <type_traits>
 #include <utility>
 
+#include "../../common/defs.hpp"
 #include "../../common/gt_assert.hpp"
-#include "../../common/hugepage_alloc.hpp"
+#include "../../common/hugepage_arena.hpp"
+#include "../common/alignment.hpp"
+#include "../common/mapped_file.hpp"
 #include "../common/state_machine.hpp"
 #include "../common/storage_interface.hpp"
 
 namespace gridtools {
+    namespace mc_storage_impl_ {
+        /*
+         * @brief First-touches the pages of the given memory range in parallel, thread t touching the t-th of
+         * omp_get_num_threads() contiguous, equally sized parts.
+         *
+         * This matches the static partitioning of the block loop in the mc backend (the j-axis is the outermost in
+         * memory) and the per-thread slices of the mc temporaries, so that the pages get mapped to the NUMA node of
+         * the thread that computes on them. The placement persists only if the threads are pinned (OMP_PROC_BIND).
+         */
+        inline void first_touch(void *ptr, std::size_t bytes) {
+            constexpr std::size_t page_size = 4096;
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+            {
+                const std::size_t threads = omp_get_num_threads();
+                const std::size_t thread = omp_get_thread_num();
+                const std::size_t first = bytes * thread / threads;
+                const std::size_t last = bytes * (thread + 1) / threads;
+                for (std::size_t offset = first; offset < last; offset = (offset / page_size + 1) * page_size)
+                    static_cast<volatile char *>(ptr)[offset] = 0;
+            }
+        }
+
+        /*
+         * @brief Frees the memory of an mc_storage, see allocate.
+         */
+        struct deleter {
+            bool dedicated;
+
+            void operator()(void *ptr) const {
+                if (dedicated)
+                    hugepage_free(ptr);
+                else
+                    hugepage_arena_free(ptr);
+            }
+        };
+
+        /*
+         * @brief Allocates the memory of an mc_storage.
+         *
+         * Storages of at least a huge page get a dedicated mapping, whose pages are not resident yet, such that
+         * first_touch decides their NUMA placement. Smaller storages are carved out of the default_hugepage_arena:
+         * they may share huge pages with other storages or reuse pages of freed ones, which are placed already.
+         */
+        inline std::unique_ptr<void, deleter> allocate(std::size_t bytes) {
+            bool dedicated = bytes >= hugepage_alloc_impl_::hugepage_size;
+            return {dedicated ? hugepage_alloc(bytes) : hugepage_arena_alloc(bytes), deleter{dedicated}};
+        }
+    } // namespace mc_storage_impl_
 
     /*
      * @brief The Mic storage implementation. This class owns the pointer
@@ -38,24 +96,60 @@ namespace gridtools {
         typedef state_machine state_machine_t;
 
       private:
-        std::unique_ptr<void, std::integral_constant<decltype(&hugepage_free), &hugepage_free>> m_holder;
+        std::unique_ptr<void, mc_storage_impl_::deleter> m_holder;
+        std::shared_ptr<mapped_file> m_file;
         DataType *m_ptr;
 
+        template <uint_t Align>
+        void align(void *allocated_ptr, uint_t offset_to_align) {
+            constexpr auto byte_alignment = Align * sizeof(DataType);
+            auto byte_offset = offset_to_align * sizeof(DataType);
+            auto address_to_align = reinterpret_cast<std::uintptr_t>(allocated_ptr) + byte_offset;
+            m_ptr = reinterpret_cast<DataType *>(
+                (address_to_align + byte_alignment - 1) / byte_alignment * byte_alignment - byte_offset);
+        }
+
+        // allocates without touching the memory
+        template <uint_t Align>
+        mc_storage(uint_t size, uint_t offset_to_align, alignment<Align>, int)
+            : m_holder(mc_storage_impl_::allocate((size + Align) * sizeof(DataType))) {
+            align<Align>(m_holder.get(), offset_to_align);
+        }
+
       public:
         /*
          * @brief mc_storage constructor. Allocates data aligned to 2MB pages (to encourage the system to use
-         * transparent huge pages) and adds an additional samll offset which changes for every allocation to reduce the
-         * risk of L1 cache set conflicts.
+         * transparent huge pages) and adds an additional small offset which changes for every allocation to reduce
+         * the risk of L1 cache set conflicts. The memory is first-touched in parallel (see
+         * mc_storage_impl_::first_touch). Storages smaller than a huge page share slabs with other storages (see
+         * hugepage_arena) and trade the NUMA placement by the first touch for less memory and fewer mappings, see
+         * mc_storage_impl_::allocate.
          * @param size defines the size of the storage and the allocated space.
          */
         template <uint_t Align = 1>
-        mc_storage(uint_t size, uint_t offset_to_align = 0u, alignment<Align> = alignment<1u>{})
-            : m_holder(hugepage_alloc((size + Align) * sizeof(DataType))) {
-            constexpr auto byte_alignment = Align * sizeof(DataType);
-            auto byte_offset = offset_to_align * sizeof(DataType);
-            auto address_to_align = reinterpret_cast<std::uintptr_t>(m_holder.get()) + byte_offset;
-            m_ptr = reinterpret_cast<DataType *>(
-                (address_to_align + byte_alignment - 1) / byte_alignment * byte_alignment - byte_offset);
+        mc_storage(uint_t size, uint_t offset_to_align = 0u, alignment<Align> a = alignment<1u>{})
+            : mc_storage(size, offset_to_align, a, 0) {
+            mc_storage_impl_::first_touch(m_ptr, size * sizeof(DataType));
+        }
+
+        /*
+         * @brief mc_storage constructor. Maps the given file and uses it as memory, with the same alignment as the
+         * allocating constructor. The memory is not first-touched, thus the data is only read from the file when
+         * touched and modifications can be written back to the file with sync_file.
+         * @param size defines the size of the storage and the mapped space.
+         * @param path path of the file
+         * @param mode whether the file is created or opened
+         */
+        template <uint_t Align = 1>
+        mc_storage(uint_t size,
+            std::string const &path,
+            file_mode mode,
+            uint_t offset_to_align = 0u,
+            alignment<Align> = alignment<1u>{})
+            : m_file(std::make_shared<mapped_file>(path, storage_file_size<DataType>(size, Align), mode)) {
+            GT_STATIC_ASSERT(std::is_trivially_copyable<DataType>::value,
+                "file-backed storages require a trivially copyable data type");
+            align<Align>(m_file->data(), offset_to_align);
         }
 
         /*
@@ -77,10 +171,10 @@ namespace gridtools {
          */
         template <typename Fun, uint_t Align = 1>
         mc_storage(uint_t size, Fun &&initializer, uint_t offset_to_align = 0u, alignment<Align> a = alignment<1u>{})
-            : mc_storage(size, offset_to_align, a) {
+            : mc_storage(size, offset_to_align, a, 0) {
 #pragma ivdep
 #ifdef _OPENMP
-#pragma omp parallel for simd
+#pragma omp parallel for simd schedule(static)
 #endif
             for (uint_t i = 0; i < size; ++i)
                 m_ptr[i] = initializer(i);
@@ -92,6 +186,7 @@ namespace gridtools {
         void swap_impl(mc_storage &other) {
             using std::swap;
             swap(m_holder, other.m_holder);
+            swap(m_file, other.m_file);
             swap(m_ptr, other.m_ptr);
         }
 
@@ -102,6 +197,15 @@ namespace gridtools {
         DataType *get_cpu_ptr() const { return m_ptr; }
 
         DataType *get_target_ptr() const { return m_ptr; }
+
+        /*
+         * @brief writes the data of a file-backed storage back to its file, no-op for other storages.
+         */
+        void sync_file() const {
+            if (m_file)
+                m_file->sync();
+        }
+
         /*
          * @brief valid implementation for mc_storage.
          */
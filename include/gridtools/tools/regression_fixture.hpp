@@ -44,6 +44,10 @@ namespace gridtools {
                 comp.run();
             }
             std::cout << comp.print_meter() << std::endl;
+            std::cout << comp.print_stage_meters();
         }
+
+        /** @brief The number of timed runs of benchmark(). */
+        static uint_t benchmark_steps() { return s_steps; }
     };
 } // namespace gridtools
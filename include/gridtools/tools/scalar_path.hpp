@@ -0,0 +1,23 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#pragma once
+
+#include <type_traits>
+
+namespace gridtools {
+    /**
+     * @brief Evaluates Functor with the scalar path of the mc backend, as a reference for the explicit SIMD evaluation
+     * of a vectorizable functor (see simd_mc.hpp).
+     */
+    template <class Functor>
+    struct scalar_path : Functor {
+        using vectorizable = std::false_type;
+    };
+} // namespace gridtools
@@ -0,0 +1,166 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include "gtest/gtest.h"
+#include <gridtools/communication/halo_exchange.hpp>
+#include <iostream>
+#include <mpi.h>
+#include <stdlib.h>
+#include <vector>
+
+/*
+ * Measures the bandwidth of the host pack and unpack of halo_exchange_generic: a number of fields of doubles is
+ * exchanged on a periodic process grid, so that all 26 neighbors are present, and the bytes moved by pack and unpack
+ * are reported in GB/s, together with the time of the exchange itself. The result of the exchange is checked before
+ * and after measuring. The exchange can use persistent MPI requests.
+ */
+namespace pack_unpack_benchmark {
+    typedef double value_type;
+    // the first dimension has stride 1
+    typedef gridtools::layout_map<2, 1, 0> layoutmap;
+    typedef gridtools::halo_exchange_generic<gridtools::layout_map<0, 1, 2>, gridtools::gcl_cpu> pattern_type;
+    typedef gridtools::field_on_the_fly<value_type, layoutmap, pattern_type::traits> field_type;
+
+    bool run(
+        std::ostream &out, int DIM1, int DIM2, int DIM3, int H, int n_fields, int n_iterations, bool persistent) {
+        int pid;
+        int nprocs;
+        MPI_Comm_rank(MPI_COMM_WORLD, &pid);
+        MPI_Comm_size(MPI_COMM_WORLD, &nprocs);
+        int dims[3] = {0, 0, 0};
+        int period[3] = {1, 1, 1};
+        int coords[3] = {0, 0, 0};
+        MPI_Dims_create(nprocs, 3, dims);
+        MPI_Comm CartComm;
+        MPI_Cart_create(MPI_COMM_WORLD, 3, dims, period, false, &CartComm);
+        MPI_Cart_get(CartComm, 3, dims, period, coords);
+
+        pattern_type he(pattern_type::grid_type::period_type(true, true, true), CartComm);
+        he.set_persistent_requests(persistent);
+
+        const int sizes[3] = {DIM1, DIM2, DIM3};
+        gridtools::array<gridtools::halo_descriptor, 3> halos;
+        for (int d = 0; d < 3; ++d)
+            halos[d] = gridtools::halo_descriptor(H, H, H, sizes[d] + H - 1, sizes[d] + 2 * H);
+
+        he.setup(n_fields, field_type(nullptr, halos), sizeof(value_type));
+
+        const int N1 = DIM1 + 2 * H;
+        const int N2 = DIM2 + 2 * H;
+        const int N3 = DIM3 + 2 * H;
+
+        // value of a point of a field, identified by its periodic global coordinates
+        auto value = [&](int f, int i, int j, int k) {
+            const int gi = ((coords[0] * DIM1 + i - H) % (dims[0] * DIM1) + dims[0] * DIM1) % (dims[0] * DIM1);
+            const int gj = ((coords[1] * DIM2 + j - H) % (dims[1] * DIM2) + dims[1] * DIM2) % (dims[1] * DIM2);
+            const int gk = ((coords[2] * DIM3 + k - H) % (dims[2] * DIM3) + dims[2] * DIM3) % (dims[2] * DIM3);
+            return f + n_fields * (gi + dims[0] * DIM1 * (gj + dims[1] * DIM2 * static_cast<value_type>(gk)));
+        };
+
+        std::vector<std::vector<value_type>> data(n_fields, std::vector<value_type>(N1 * N2 * N3, -1));
+        std::vector<field_type> fields;
+        for (int f = 0; f < n_fields; ++f) {
+            for (int k = H; k < DIM3 + H; ++k)
+                for (int j = H; j < DIM2 + H; ++j)
+                    for (int i = H; i < DIM1 + H; ++i)
+                        data[f][i + N1 * (j + N2 * k)] = value(f, i, j, k);
+            fields.emplace_back(data[f].data(), halos);
+        }
+
+        auto check = [&] {
+            bool res = true;
+            for (int f = 0; f < n_fields; ++f)
+                for (int k = 0; k < N3; ++k)
+                    for (int j = 0; j < N2; ++j)
+                        for (int i = 0; i < N1; ++i)
+                            res = res && data[f][i + N1 * (j + N2 * k)] == value(f, i, j, k);
+            return res;
+        };
+
+        he.pack(fields);
+        he.exchange();
+        he.unpack(fields);
+        bool passed = check();
+
+        double bytes = 0;
+        for (int ii = -1; ii <= 1; ++ii)
+            for (int jj = -1; jj <= 1; ++jj)
+                for (int kk = -1; kk <= 1; ++kk)
+                    if (ii != 0 || jj != 0 || kk != 0)
+                        bytes += fields[0].send_buffer_size(gridtools::make_array(ii, jj, kk));
+        // each element is read and written once
+        bytes *= 2. * n_fields * sizeof(value_type) * n_iterations;
+
+        double time_pack = 0;
+        double time_exchange = 0;
+        double time_unpack = 0;
+        for (int it = 0; it < n_iterations; ++it) {
+            double start = MPI_Wtime();
+            he.pack(fields);
+            time_pack += MPI_Wtime() - start;
+            start = MPI_Wtime();
+            he.exchange();
+            time_exchange += MPI_Wtime() - start;
+            start = MPI_Wtime();
+            he.unpack(fields);
+            time_unpack += MPI_Wtime() - start;
+        }
+        passed = passed && check();
+
+        int res = passed;
+        MPI_Allreduce(MPI_IN_PLACE, &res, 1, MPI_INT, MPI_LAND, MPI_COMM_WORLD);
+
+        if (pid == 0) {
+            out << "Fields: " << n_fields << " of " << DIM1 << "x" << DIM2 << "x" << DIM3 << " with halo " << H
+                << (persistent ? ", persistent requests" : "") << "\n";
+            out << "PACK   [GB/s]: " << 1e-9 * bytes / time_pack << "\n";
+            out << "EXCH   [us]:   " << 1e6 * time_exchange / n_iterations << "\n";
+            out << "UNPACK [GB/s]: " << 1e-9 * bytes / time_unpack << "\n";
+            out << (res ? "PASSED" : "FAILED") << std::endl;
+        }
+        return res;
+    }
+} // namespace pack_unpack_benchmark
+
+#ifdef STANDALONE
+int main(int argc, char **argv) {
+    MPI_Init(&argc, &argv);
+    gridtools::GCL_Init(argc, argv);
+
+    if (argc != 7 && argc != 8) {
+        std::cout << "Usage: benchmark_pack_unpack dimx dimy dimz halo fields iterations [persistent]\n where dimx, "
+                     "dimy, dimz are the sizes of the fields without halos, halo is the halo width and persistent is 1 "
+                     "to use persistent MPI requests"
+                  << std::endl;
+        return 1;
+    }
+
+    bool passed = pack_unpack_benchmark::run(std::cout,
+        atoi(argv[1]),
+        atoi(argv[2]),
+        atoi(argv[3]),
+        atoi(argv[4]),
+        atoi(argv[5]),
+        atoi(argv[6]),
+        argc == 8 && atoi(argv[7]));
+
+    MPI_Finalize();
+    return passed ? 0 : 1;
+}
+#else
+TEST(Communication, benchmark_pack_unpack) {
+    bool passed = pack_unpack_benchmark::run(std::cout, 64, 48, 40, 3, 4, 10, false);
+    EXPECT_TRUE(passed);
+}
+
+TEST(Communication, benchmark_pack_unpack_persistent) {
+    bool passed = pack_unpack_benchmark::run(std::cout, 64, 48, 40, 3, 4, 10, true);
+    EXPECT_TRUE(passed);
+}
+#endif
@@ -108,6 +108,15 @@ namespace halo_exchange_3D_all {
            GCL can deal with any periodicity easily.
         */
         pattern_type he(typename pattern_type::grid_type::period_type(per0, per1, per2), CartComm);
+#ifdef FACE_EXCHANGE
+        he.set_face_exchange(true);
+#endif
+#ifdef SHARED_MEMORY
+        he.set_shared_memory(true);
+#endif
+#ifdef ZERO_COPY
+        he.set_zero_copy(true);
+#endif
 
         /* Next we need to describe the data arrays in terms of halo
            descriptors (see the manual). The 'order' of registration, that
@@ -12,6 +12,7 @@
 
 #include <gridtools/stencil_composition/stencil_composition.hpp>
 #include <gridtools/tools/regression_fixture.hpp>
+#include <gridtools/tools/scalar_path.hpp>
 
 #include "horizontal_diffusion_repository.hpp"
 
@@ -22,6 +23,7 @@ struct lap_function {
     using in = in_accessor<1, extent<-1, 1, -1, 1>>;
 
     using param_list = make_param_list<out, in>;
+    using vectorizable = std::true_type;
 
     template <typename Evaluation>
     GT_FUNCTION static void apply(Evaluation eval) {
@@ -36,6 +38,7 @@ struct flx_function {
     using lap = in_accessor<2, extent<0, 1, 0, 0>>;
 
     using param_list = make_param_list<out, in, lap>;
+    using vectorizable = std::true_type;
 
     template <typename Evaluation>
     GT_FUNCTION static void apply(Evaluation eval) {
@@ -50,6 +53,7 @@ struct fly_function {
     using lap = in_accessor<2, extent<0, 0, 0, 1>>;
 
     using param_list = make_param_list<out, in, lap>;
+    using vectorizable = std::true_type;
 
     template <typename Evaluation>
     GT_FUNCTION static void apply(Evaluation eval) {
@@ -66,6 +70,7 @@ struct out_function {
     using coeff = in_accessor<4>;
 
     using param_list = make_param_list<out, in, flx, fly, coeff>;
+    using vectorizable = std::true_type;
 
     template <typename Evaluation>
     GT_FUNCTION static void apply(Evaluation eval) {
@@ -101,3 +106,43 @@ TEST_F(horizontal_diffusion, test) {
     verify(make_storage(repo.out), out);
     benchmark(comp);
 }
+
+TEST_F(horizontal_diffusion, simd_matches_scalar_path) {
+    tmp_arg<0> p_lap;
+    tmp_arg<1> p_flx;
+    tmp_arg<2> p_fly;
+    arg<3> p_coeff;
+    arg<4> p_in;
+    arg<5> p_out;
+
+    auto out = make_storage();
+    auto ref = make_storage();
+
+    horizontal_diffusion_repository repo(d1(), d2(), d3());
+    auto in = make_storage(repo.in);
+    auto coeff = make_storage(repo.coeff);
+
+    make_computation(p_in = in,
+        p_out = out,
+        p_coeff = coeff,
+        make_multistage(execute::parallel(),
+            define_caches(cache<cache_type::ij, cache_io_policy::local>(p_lap, p_flx, p_fly)),
+            make_stage<lap_function>(p_lap, p_in),
+            make_independent(
+                make_stage<flx_function>(p_flx, p_in, p_lap), make_stage<fly_function>(p_fly, p_in, p_lap)),
+            make_stage<out_function>(p_out, p_in, p_flx, p_fly, p_coeff)))
+        .run();
+
+    make_computation(p_in = in,
+        p_out = ref,
+        p_coeff = coeff,
+        make_multistage(execute::parallel(),
+            define_caches(cache<cache_type::ij, cache_io_policy::local>(p_lap, p_flx, p_fly)),
+            make_stage<scalar_path<lap_function>>(p_lap, p_in),
+            make_independent(make_stage<scalar_path<flx_function>>(p_flx, p_in, p_lap),
+                make_stage<scalar_path<fly_function>>(p_fly, p_in, p_lap)),
+            make_stage<scalar_path<out_function>>(p_out, p_in, p_flx, p_fly, p_coeff)))
+        .run();
+
+    verify(ref, out);
+}
@@ -11,6 +11,7 @@
 
 #include <gridtools/stencil_composition/stencil_composition.hpp>
 #include <gridtools/tools/regression_fixture.hpp>
+#include <gridtools/tools/scalar_path.hpp>
 
 using namespace gridtools;
 
@@ -18,6 +19,7 @@ struct lap {
     using out = inout_accessor<0>;
     using in = in_accessor<1, extent<-1, 1, -1, 1>>;
     using param_list = make_param_list<out, in>;
+    using vectorizable = std::true_type;
 
     template <typename Evaluation>
     GT_FUNCTION static void apply(Evaluation eval) {
@@ -39,3 +41,16 @@ TEST_F(laplacian, test) {
 
     verify(make_storage(ref), out);
 }
+
+TEST_F(laplacian, simd_matches_scalar_path) {
+    auto in = make_storage([](int_t i, int_t j, int_t k) { return (i * i * j + k) % 7 - 3.; });
+    auto out = make_storage(-7.3);
+    auto ref = make_storage(-7.3);
+
+    make_computation(p_0 = out, p_1 = in, make_multistage(execute::forward(), make_stage<lap>(p_0, p_1))).run();
+    make_computation(
+        p_0 = ref, p_1 = in, make_multistage(execute::forward(), make_stage<scalar_path<lap>>(p_0, p_1)))
+        .run();
+
+    verify(ref, out);
+}
@@ -0,0 +1,70 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+/**
+ * @file
+ *
+ * Memory bandwidth of a STREAM-like triad for storages whose pages are first-touched by a single thread (as it
+ * happens with a serial initialization) and for storages first-touched by the threads that compute on them. On
+ * multi-socket nodes, the difference shows the cost of remote memory accesses; run with bound threads, e.g.
+ * OMP_PROC_BIND=close OMP_PLACES=cores.
+ */
+
+#include <iostream>
+
+#include <gtest/gtest.h>
+
+#include <gridtools/stencil_composition/stencil_composition.hpp>
+#include <gridtools/tools/regression_fixture.hpp>
+
+using namespace gridtools;
+
+struct triad_functor {
+    using a = inout_accessor<0>;
+    using b = in_accessor<1>;
+    using c = in_accessor<2>;
+
+    using param_list = make_param_list<a, b, c>;
+
+    template <typename Evaluation>
+    GT_FUNCTION static void apply(Evaluation eval) {
+        eval(a()) = eval(b()) + 3 * eval(c());
+    }
+};
+
+struct numa_first_touch : regression_fixture<> {
+    void run_triad(int touching_threads, std::string const &label) {
+        int threads = omp_get_max_threads();
+#ifdef _OPENMP
+        omp_set_num_threads(touching_threads);
+#endif
+        storage_type a = make_storage();
+        storage_type b = make_storage([](int i, int j, int) { return i + j; });
+        storage_type c = make_storage([](int, int, int k) { return k; });
+#ifdef _OPENMP
+        omp_set_num_threads(threads);
+#endif
+
+        auto comp = make_computation(
+            p_0 = a, p_1 = b, p_2 = c, make_multistage(execute::parallel(), make_stage<triad_functor>(p_0, p_1, p_2)));
+
+        comp.run();
+        verify(make_storage([](int i, int j, int k) { return i + j + 3 * k; }), a);
+        benchmark(comp);
+        if (benchmark_steps() != 0 && comp.get_time() > 0)
+            std::cout << label << ": "
+                      << 3e-9 * sizeof(float_type) * a.total_length() * benchmark_steps() / comp.get_time() << " GB/s"
+                      << std::endl;
+    }
+};
+
+TEST_F(numa_first_touch, serial) { run_triad(1, "serial first touch"); }
+
+TEST_F(numa_first_touch, parallel) { run_triad(omp_get_max_threads(), "parallel first touch"); }
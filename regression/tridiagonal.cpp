@@ -7,6 +7,10 @@
  * Please, refer to the LICENSE file in the root directory.
  * SPDX-License-Identifier: BSD-3-Clause
  */
+#include <map>
+#include <mutex>
+#include <set>
+
 #include <gtest/gtest.h>
 
 #include <gridtools/stencil_composition/stencil_composition.hpp>
@@ -74,6 +78,61 @@ struct backward_thomas {
     }
 };
 
+// k levels stored at each address of the modified upper diagonal, as seen by the second esf of the cached sweep
+std::mutex sup_levels_mutex;
+std::map<float_type const *, std::set<int>> sup_levels;
+
+GT_FUNCTION void record_sup_level(float_type const &sup, int k) {
+#ifndef __CUDA_ARCH__
+    std::lock_guard<std::mutex> lock(sup_levels_mutex);
+    sup_levels[&sup].insert(k);
+#endif
+}
+
+/*
+  The forward sweep split into two esfs that share the modified upper diagonal through a local k cache.
+ */
+struct forward_thomas_sup {
+    using inf = in_accessor<0>;
+    using diag = in_accessor<1>;
+    using sup = in_accessor<2>;
+    using sup_tmp = inout_accessor<3, extent<0, 0, 0, 0, -1, 0>>;
+    using param_list = make_param_list<inf, diag, sup, sup_tmp>;
+
+    template <typename Evaluation>
+    GT_FUNCTION static void apply(Evaluation eval, full_t::modify<1, 0>) {
+        eval(sup_tmp{}) = eval(sup{} / (diag{} - sup_tmp{0, 0, -1} * inf{}));
+    }
+
+    template <typename Evaluation>
+    GT_FUNCTION static void apply(Evaluation eval, full_t::first_level) {
+        eval(sup_tmp{}) = eval(sup{}) / eval(diag{});
+    }
+};
+
+struct forward_thomas_rhs {
+    using inf = in_accessor<0>;
+    using diag = in_accessor<1>;
+    using sup = inout_accessor<2>;
+    using rhs = inout_accessor<3, extent<0, 0, 0, 0, -1, 0>>;
+    using sup_tmp = in_accessor<4, extent<0, 0, 0, 0, -1, 0>>;
+    using param_list = make_param_list<inf, diag, sup, rhs, sup_tmp>;
+
+    template <typename Evaluation>
+    GT_FUNCTION static void apply(Evaluation eval, full_t::modify<1, 0>) {
+        eval(rhs{}) = eval((rhs{} - inf{} * rhs{0, 0, -1}) / (diag{} - sup_tmp{0, 0, -1} * inf{}));
+        eval(sup{}) = eval(sup_tmp{});
+        record_sup_level(eval(sup_tmp{}), eval.k());
+    }
+
+    template <typename Evaluation>
+    GT_FUNCTION static void apply(Evaluation eval, full_t::first_level) {
+        eval(rhs{}) = eval(rhs{}) / eval(diag{});
+        eval(sup{}) = eval(sup_tmp{});
+        record_sup_level(eval(sup_tmp{}), eval.k());
+    }
+};
+
 using tridiagonal = regression_fixture<>;
 
 TEST_F(tridiagonal, test) {
@@ -100,3 +159,40 @@ TEST_F(tridiagonal, test) {
 
     verify(make_storage(1.), out);
 }
+
+TEST_F(tridiagonal, cached_sup) {
+    d3() = 6;
+
+    auto out = make_storage();
+    auto sup = make_storage(1.);
+    auto rhs = make_storage([](int_t, int_t, int_t k) { return k == 0 ? 4. : k == 5 ? 2. : 3.; });
+
+    arg<0> p_inf;
+    arg<1> p_diag;
+    arg<2> p_sup;
+    arg<3> p_rhs;
+    arg<4> p_out;
+    tmp_arg<0> p_sup_tmp;
+
+    sup_levels.clear();
+    make_positional_computation<backend_t>(make_grid(),
+        p_inf = make_storage(-1.),
+        p_diag = make_storage(3.),
+        p_sup = sup,
+        p_rhs = rhs,
+        p_out = out,
+        make_multistage(execute::forward(),
+            define_caches(cache<cache_type::k, cache_io_policy::local>(p_sup_tmp)),
+            make_stage<forward_thomas_sup>(p_inf, p_diag, p_sup, p_sup_tmp),
+            make_stage<forward_thomas_rhs>(p_inf, p_diag, p_sup, p_rhs, p_sup_tmp)),
+        make_multistage(execute::backward(), make_stage<backward_thomas>(p_out, p_inf, p_diag, p_sup, p_rhs)))
+        .run();
+
+    verify(make_storage(1.), out);
+
+    // the mc backend runs both esfs in the same k loop and keeps the temporary in a ring of two k-planes
+    std::size_t levels_per_address = std::is_same<backend_t, backend::mc>::value ? 3 : 1;
+    EXPECT_FALSE(sup_levels.empty());
+    for (auto &&address_levels : sup_levels)
+        EXPECT_EQ(levels_per_address, address_levels.second.size());
+}
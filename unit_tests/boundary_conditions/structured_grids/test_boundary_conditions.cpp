@@ -1005,6 +1005,72 @@ bool usingcopy_3() {
     return result;
 }
 
+#ifndef __CUDACC__
+struct bc_count {
+    template <typename Direction, typename DataField0, typename DataField1>
+    void operator()(Direction, DataField0 &count, DataField1 &dir, uint_t i, uint_t j, uint_t k) const {
+        count(i, j, k) += 1;
+        dir(i, j, k) = (Direction::i + 1) * 9 + (Direction::j + 1) * 3 + Direction::k + 1;
+    }
+};
+
+struct not_plus_j_predicate {
+    template <typename Direction>
+    bool operator()(Direction) const {
+        return Direction::j != plus_;
+    }
+};
+
+// every point of the selected halo regions is visited exactly once, in its direction, whatever the layout
+template <typename Layout>
+bool regions_visited_once() {
+    const int d1 = 13;
+    const int d2 = 9;
+    const int d3 = 6;
+
+    using storage_info_t = storage_info<0, Layout>;
+    using storage_t = data_store<host_storage<int_t>, storage_info_t>;
+
+    storage_info_t meta_(d1, d2, d3);
+    storage_t count(meta_, 0);
+    storage_t dir(meta_, -1);
+    auto countv = make_host_view(count);
+    auto dirv = make_host_view(dir);
+
+    // asymmetric halos, empty on the plus side of k
+    gridtools::array<gridtools::halo_descriptor, 3> halos;
+    halos[0] = gridtools::halo_descriptor(2, 3, 2, d1 - 4, d1);
+    halos[1] = gridtools::halo_descriptor(1, 2, 1, d2 - 3, d2);
+    halos[2] = gridtools::halo_descriptor(1, 0, 1, d3 - 1, d3);
+
+    gridtools::boundary_apply<bc_count, not_plus_j_predicate>(halos).apply(countv, dirv);
+
+    auto side = [](int x, halo_descriptor const &h) {
+        return x < (int)h.begin() ? -1 : x > (int)h.end() ? 1 : 0;
+    };
+
+    bool result = true;
+    for (int i = 0; i < d1; ++i)
+        for (int j = 0; j < d2; ++j)
+            for (int k = 0; k < d3; ++k) {
+                const int si = side(i, halos[0]);
+                const int sj = side(j, halos[1]);
+                const int sk = side(k, halos[2]);
+                const bool selected = (si != 0 || sj != 0 || sk != 0) && sj != 1;
+                result = result && countv(i, j, k) == (selected ? 1 : 0);
+                if (selected)
+                    result = result && dirv(i, j, k) == (si + 1) * 9 + (sj + 1) * 3 + sk + 1;
+            }
+    return result;
+}
+
+TEST(boundaryconditions, regions_visited_once) {
+    EXPECT_TRUE((regions_visited_once<layout_map<0, 1, 2>>()));
+    EXPECT_TRUE((regions_visited_once<layout_map<2, 1, 0>>()));
+    EXPECT_TRUE((regions_visited_once<layout_map<1, 2, 0>>()));
+}
+#endif
+
 TEST(boundaryconditions, predicate) { EXPECT_EQ(predicate(), true); }
 
 TEST(boundaryconditions, twosurfaces) { EXPECT_EQ(twosurfaces(), true); }
@@ -0,0 +1,161 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <gtest/gtest.h>
+
+#include <set>
+#include <vector>
+
+#include <gridtools/common/hugepage_arena.hpp>
+
+namespace gridtools {
+    namespace {
+
+        constexpr std::size_t page = 2 * 1024 * 1024;
+
+        TEST(hugepage_arena, alloc_free) {
+            hugepage_arena arena;
+            std::size_t n = 100;
+
+            int *ptr = static_cast<int *>(arena.allocate(n * sizeof(int)));
+            EXPECT_EQ(reinterpret_cast<std::uintptr_t>(ptr) % 64, 0);
+
+            for (std::size_t i = 0; i < n; ++i) {
+                ptr[i] = 0;
+                EXPECT_EQ(ptr[i], 0);
+            }
+            EXPECT_EQ(arena.stats().requested, n * sizeof(int));
+
+            hugepage_arena::free(ptr);
+            EXPECT_EQ(arena.stats().requested, 0);
+        }
+
+        TEST(hugepage_arena, offsets) {
+            // the allocations carved from the same slab have different last 12 bits, like those of hugepage_alloc
+            hugepage_arena arena;
+            std::set<std::uintptr_t> offsets;
+            std::vector<void *> ptrs;
+            std::size_t checks = 7;
+            for (std::size_t i = 0; i < checks; ++i) {
+                ptrs.push_back(arena.allocate(sizeof(double)));
+                offsets.insert(reinterpret_cast<std::uintptr_t>(ptrs.back()) & 0xfff);
+            }
+            EXPECT_EQ(offsets.size(), checks);
+            EXPECT_EQ(arena.stats().slabs, 1);
+            for (void *ptr : ptrs)
+                hugepage_arena::free(ptr);
+        }
+
+        TEST(hugepage_arena, shared_slabs) {
+            hugepage_arena arena(2 * page);
+            std::vector<void *> ptrs;
+            for (int i = 0; i < 3; ++i)
+                ptrs.push_back(arena.allocate(page / 2));
+
+            auto stats = arena.stats();
+            EXPECT_EQ(stats.requested, 3 * page / 2);
+            EXPECT_EQ(stats.reserved, 2 * page);
+            EXPECT_EQ(stats.slabs, 1);
+            EXPECT_EQ(stats.hugepage_coverage(), 1.);
+
+            // does not fit in the remaining space of the first slab
+            ptrs.push_back(arena.allocate(3 * page / 4));
+            stats = arena.stats();
+            EXPECT_EQ(stats.reserved, 4 * page);
+            EXPECT_EQ(stats.slabs, 2);
+
+            // the first slab is released as soon as it is empty
+            for (int i = 0; i < 3; ++i)
+                hugepage_arena::free(ptrs[i]);
+            stats = arena.stats();
+            EXPECT_EQ(stats.requested, 3 * page / 4);
+            EXPECT_EQ(stats.reserved, 2 * page);
+            EXPECT_EQ(stats.slabs, 1);
+
+            // and so is the second one
+            hugepage_arena::free(ptrs[3]);
+            stats = arena.stats();
+            EXPECT_EQ(stats.reserved, 0);
+            EXPECT_EQ(stats.slabs, 0);
+        }
+
+        TEST(hugepage_arena, reuse) {
+            hugepage_arena arena(2 * page);
+            void *first = arena.allocate(page / 2);
+            void *second = arena.allocate(page / 2);
+            void *third = arena.allocate(page / 2);
+
+            // the space of the freed allocations is taken again, merged with its neighbors
+            hugepage_arena::free(first);
+            hugepage_arena::free(second);
+            void *large = arena.allocate(page - page / 8);
+            auto stats = arena.stats();
+            EXPECT_EQ(stats.slabs, 1);
+            EXPECT_EQ(stats.reserved, 2 * page);
+            EXPECT_LT(large, third);
+
+            hugepage_arena::free(third);
+            hugepage_arena::free(large);
+            EXPECT_EQ(arena.stats().slabs, 0);
+        }
+
+        TEST(hugepage_arena, mixed_lifetimes) {
+            // long-lived allocations scattered over the slab don't make it grow when short-lived ones come and go
+            hugepage_arena arena(2 * page);
+            std::vector<void *> long_lived;
+            for (int i = 0; i < 1000; ++i) {
+                long_lived.push_back(arena.allocate(64 + i % 7 * 100));
+                void *short_lived = arena.allocate(page / 8 + i % 5 * 4096);
+                hugepage_arena::free(short_lived);
+                EXPECT_LE(arena.stats().reserved, 2 * page);
+            }
+            for (void *ptr : long_lived)
+                hugepage_arena::free(ptr);
+            EXPECT_EQ(arena.stats().slabs, 0);
+        }
+
+        TEST(hugepage_arena, dedicated_slabs) {
+            hugepage_arena arena(page);
+            void *small = arena.allocate(64);
+            void *large = arena.allocate(2 * page + page / 2);
+
+            auto stats = arena.stats();
+            EXPECT_EQ(stats.slabs, 2);
+            EXPECT_GT(stats.reserved, 3 * page + page / 2);
+            EXPECT_LT(stats.reserved, 4 * page);
+            EXPECT_EQ(stats.hugepage_bytes, 3 * page);
+            EXPECT_LT(stats.hugepage_coverage(), 1.);
+
+            // the small allocation is still carved from the shared slab
+            void *next = arena.allocate(64);
+            EXPECT_EQ(arena.stats().slabs, 2);
+
+            // allocations larger than half a slab get their own mapping
+            void *half = arena.allocate(page / 2 + 64);
+            EXPECT_EQ(arena.stats().slabs, 3);
+            hugepage_arena::free(half);
+
+            hugepage_arena::free(large);
+            stats = arena.stats();
+            EXPECT_EQ(stats.slabs, 1);
+            EXPECT_EQ(stats.reserved, page);
+            hugepage_arena::free(next);
+            hugepage_arena::free(small);
+        }
+
+        TEST(hugepage_arena, default_arena) {
+            auto before = default_hugepage_arena().stats().requested;
+            void *ptr = hugepage_arena_alloc(1000);
+            EXPECT_EQ(default_hugepage_arena().stats().requested, before + 1000);
+            hugepage_arena_free(ptr);
+            EXPECT_EQ(default_hugepage_arena().stats().requested, before);
+        }
+
+    } // namespace
+} // namespace gridtools
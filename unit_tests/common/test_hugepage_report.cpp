@@ -0,0 +1,88 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <sstream>
+
+#include <gridtools/common/hugepage_arena.hpp>
+#include <gridtools/common/hugepage_report.hpp>
+
+namespace gridtools {
+    namespace {
+
+        constexpr std::size_t page = 2 * 1024 * 1024;
+
+        hugepage_usage const *find_usage(std::vector<hugepage_usage> const &report, void const *ptr) {
+            auto address = reinterpret_cast<std::uintptr_t>(ptr);
+            for (auto const &usage : report)
+                if (usage.address <= address && address < usage.address + usage.size)
+                    return &usage;
+            return nullptr;
+        }
+
+        TEST(hugepage_report, disabled) {
+            // declared first, as the report cannot be disabled again
+            if (hugepage_alloc_impl_::registry::get().enabled)
+                return;
+            void *ptr = hugepage_alloc(page);
+            EXPECT_FALSE(find_usage(hugepage_usage_report(), ptr));
+            hugepage_free(ptr);
+        }
+
+        TEST(hugepage_report, hugepage_alloc) {
+            enable_hugepage_report();
+            std::size_t size = 8 * page;
+            char *ptr = static_cast<char *>(hugepage_alloc(size));
+            std::memset(ptr, 1, size);
+
+            auto report = hugepage_usage_report();
+            auto usage = find_usage(report, ptr);
+            ASSERT_TRUE(usage);
+            EXPECT_EQ(usage->address % page, 0);
+            EXPECT_GE(usage->size, size);
+            EXPECT_LE(usage->huge_bytes, usage->size);
+            EXPECT_LE(usage->coverage(), 1.);
+            // the advised area ends at the page following the range, it is attributed exactly
+            if (!usage->hugetlbfs && usage->huge_bytes) {
+                EXPECT_FALSE(usage->estimated);
+            }
+
+            hugepage_free(ptr);
+            EXPECT_FALSE(find_usage(hugepage_usage_report(), ptr));
+        }
+
+        TEST(hugepage_report, arena_slabs) {
+            enable_hugepage_report();
+            hugepage_arena arena(page);
+            void *first = arena.allocate(64);
+            void *second = arena.allocate(64);
+
+            auto report = hugepage_usage_report();
+            auto usage = find_usage(report, first);
+            ASSERT_TRUE(usage);
+            EXPECT_EQ(usage, find_usage(report, second));
+            EXPECT_EQ(usage->size, page);
+
+            hugepage_arena::free(first);
+            hugepage_arena::free(second);
+        }
+
+        TEST(hugepage_report, print) {
+            enable_hugepage_report();
+            void *ptr = hugepage_alloc(page);
+            std::ostringstream out;
+            print_hugepage_report(out);
+            EXPECT_NE(out.str().find("gridtools huge pages: "), std::string::npos);
+            hugepage_free(ptr);
+        }
+
+    } // namespace
+} // namespace gridtools
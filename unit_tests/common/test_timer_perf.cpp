@@ -0,0 +1,113 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+#include <gridtools/common/timer/timer_perf.hpp>
+
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace gridtools {
+    namespace {
+        double work(std::vector<double> &data) {
+            double sum = 0;
+#pragma omp parallel for reduction(+ : sum)
+            for (std::size_t i = 0; i < data.size(); ++i) {
+                data[i] = data[i] * 0.5 + i;
+                sum += data[i];
+            }
+            return sum;
+        }
+
+        TEST(timer_perf, measure) {
+            std::vector<double> data(1 << 20, 1.);
+            timer_perf testee("perf");
+
+            testee.start();
+            EXPECT_GT(work(data), 0);
+            testee.pause();
+
+            EXPECT_EQ(1, testee.count());
+            EXPECT_GE(testee.total_time(), 0);
+            EXPECT_EQ(0, testee.to_string().find("perf\t[s]\t"));
+            if (testee.counters_available()) {
+                EXPECT_GT(testee.cycles(), 0);
+                EXPECT_GE(testee.instructions(), static_cast<std::int64_t>(data.size()));
+                EXPECT_GE(testee.llc_misses(), 0);
+                EXPECT_EQ(64 * testee.llc_misses(), testee.memory_bytes());
+                EXPECT_NE(std::string::npos, testee.to_string().find("cycles: "));
+            } else {
+                // wall time only
+                EXPECT_EQ(0, testee.cycles());
+                EXPECT_EQ(std::string::npos, testee.to_string().find("cycles: "));
+            }
+
+            testee.reset();
+            EXPECT_EQ(0, testee.count());
+            EXPECT_EQ(0, testee.cycles());
+            EXPECT_EQ(0, testee.total_time());
+        }
+
+        void measure(timer_perf &testee, std::vector<double> &data) {
+            testee.start();
+            EXPECT_GT(work(data), 0);
+            testee.pause();
+        }
+
+        void expect_measured(timer_perf const &testee, std::size_t instructions) {
+            EXPECT_EQ(1, testee.count());
+            EXPECT_GE(testee.total_time(), 0);
+            if (testee.counters_available())
+                EXPECT_GE(testee.instructions(), static_cast<std::int64_t>(instructions));
+            else
+                EXPECT_EQ(0, testee.cycles());
+        }
+
+        TEST(timer_perf, other_threads) {
+            // every thread measures its own OpenMP team
+            std::vector<double> data(1 << 20, 1.), other_data(1 << 20, 1.);
+            timer_perf testee("perf");
+            measure(testee, data);
+            timer_perf other("other");
+            std::thread thread([&] { measure(other, other_data); });
+            thread.join();
+            expect_measured(testee, data.size());
+            expect_measured(other, other_data.size());
+
+            // the main thread still measures its own team after the other thread exited
+            testee.reset();
+            measure(testee, data);
+            expect_measured(testee, data.size());
+        }
+
+        TEST(timer_perf, per_thread) {
+            // like the stage meters, every thread measures itself from within the parallel region
+            std::vector<double> data(1 << 20, 1.);
+            std::vector<timer_perf> testees(omp_get_max_threads(), timer_perf("perf"));
+#pragma omp parallel
+            {
+                auto &testee = testees[omp_get_thread_num()];
+                testee.start();
+#pragma omp for
+                for (std::size_t i = 0; i < data.size(); ++i)
+                    data[i] = data[i] * 0.5 + i;
+                testee.pause();
+            }
+            for (auto const &testee : testees) {
+                EXPECT_EQ(1, testee.count());
+                EXPECT_GE(testee.total_time(), 0);
+                if (testee.counters_available())
+                    EXPECT_GT(testee.instructions(), 0);
+                else
+                    EXPECT_EQ(0, testee.cycles());
+            }
+        }
+    } // namespace
+} // namespace gridtools
@@ -69,7 +69,7 @@ struct pgrid<T4> {
     }
 };
 
-TEST(Communication, Halo_Exchange_3D) {
+void test_halo_exchange_3D(bool persistent) {
 
     // 6
     int iminus;
@@ -137,6 +137,7 @@ TEST(Communication, Halo_Exchange_3D) {
     test_type::grid_type pg = test_type::instantiate(MPI_COMM_WORLD);
 
     gridtools::Halo_Exchange_3D<test_type::grid_type> he(pg);
+    he.set_persistent_requests(persistent);
 
     // std::cout << "@" << gridtools::PID << "@ SEND " << &iminus << " - " << &iplus << " - " << &jminus << " - " <<
     // &jplus
@@ -297,6 +298,9 @@ TEST(Communication, Halo_Exchange_3D) {
     //     gridtools::PID);
 
     he.exchange();
+    // the persistent requests are restarted by the following exchanges
+    if (persistent)
+        he.exchange();
 
     // printf("@%3d@ ----------------\n@%3d@ |%3d |%3d |%3d |\n@%3d@ |%3d |%3d |%3d |\n@%3d@ |%3d |%3d |%3d |\n@%3d@ "
     //        "----------------\n\n",
@@ -394,5 +398,10 @@ TEST(Communication, Halo_Exchange_3D) {
     //         std::cout << "@" << gridtools::PID << "@ PASSED!\n";
     // }
 
+    EXPECT_TRUE(res);
     EXPECT_TRUE(final);
 }
+
+TEST(Communication, Halo_Exchange_3D) { test_halo_exchange_3D(false); }
+
+TEST(Communication, Halo_Exchange_3D_persistent) { test_halo_exchange_3D(true); }
@@ -118,3 +118,40 @@ TEST(DistributedBoundaries, BoundBC) {
 
     EXPECT_EQ(b, std::get<0>(y));
 }
+
+TEST(DistributedBoundaries, WithHalos) {
+    typedef gt::storage_info<0, gt::layout_map<0, 1, 2>> storage_info_t;
+    using ds = gt::data_store<gt::host_storage<double>, storage_info_t>;
+
+    ds a(storage_info_t{3, 3, 3}, "a");
+    ds b(storage_info_t{3, 3, 3}, "b");
+
+    gt::array<gt::halo_descriptor, 3> halos{gt::halo_descriptor{1, 0, 1, 1, 3},
+        gt::halo_descriptor{0, 1, 0, 1, 3},
+        gt::halo_descriptor{0, 0, 0, 2, 3}};
+
+    auto bbc = gt::bind_bc(gt::zero_boundary{}, a, _1).with_halos(halos).associate(b);
+    EXPECT_TRUE(bbc.has_halos());
+    EXPECT_EQ(halos[0], bbc.halos()[0]);
+    EXPECT_EQ(halos[1], bbc.halos()[1]);
+    EXPECT_FALSE(gt::bind_bc(gt::zero_boundary{}, a).has_halos());
+
+    auto swh = gt::with_halos(a, halos);
+    EXPECT_TRUE(gt::is_store_with_halos<decltype(swh)>::value);
+    EXPECT_FALSE(gt::is_store_with_halos<ds>::value);
+    EXPECT_EQ(a, swh.store);
+    EXPECT_EQ(halos[2], swh.halos[2]);
+}
+
+TEST(DistributedBoundaries, ExtentHalos) {
+    gt::array<gt::halo_descriptor, 3> halos{gt::halo_descriptor{3, 3, 3, 12, 16},
+        gt::halo_descriptor{2, 2, 2, 9, 12},
+        gt::halo_descriptor{0, 0, 0, 9, 10}};
+
+    // upwind in i, reading beyond the halos in j and in k
+    auto res = gt::extent_halos(gt::rt_extent{-2, 0, -1, 4, -1, 1}, halos);
+
+    EXPECT_EQ(gt::halo_descriptor(2, 0, 3, 12, 16), res[0]);
+    EXPECT_EQ(gt::halo_descriptor(1, 2, 2, 9, 12), res[1]);
+    EXPECT_EQ(gt::halo_descriptor(0, 0, 0, 9, 10), res[2]);
+}
@@ -20,6 +20,7 @@
 #include <gridtools/boundary_conditions/value.hpp>
 #include <gridtools/distributed_boundaries/comm_traits.hpp>
 #include <gridtools/distributed_boundaries/distributed_boundaries.hpp>
+#include <gridtools/stencil_composition/arg.hpp>
 #include <gridtools/storage/storage_facility.hpp>
 #include <gridtools/tools/backend_select.hpp>
 #include <gridtools/tools/mpi_unit_test_driver/device_binding.hpp>
@@ -298,7 +299,7 @@ TEST(DistributedBoundaries, AvoidCommunicationOnlyBoundary) {
     cabc.boundary_only(a, b, c, d);
 }
 
-TEST(DistributedBoundaries, Test) {
+void test_exchange(bool split_phase) {
 
 #ifdef __CUDACC__
     using comm_arch = gridtools::gcl_gpu;
@@ -387,8 +388,17 @@ TEST(DistributedBoundaries, Test) {
 
     using namespace std::placeholders;
 
-    cabc.exchange(
-        bind_bc(value_boundary<triplet>{triplet{42, 42, 42}}, a), bind_bc(copy_boundary{}, b, _1).associate(c), d);
+    if (split_phase) {
+        cabc.start_exchange(
+            bind_bc(value_boundary<triplet>{triplet{42, 42, 42}}, a), bind_bc(copy_boundary{}, b, _1).associate(c), d);
+        cabc.wait(
+            bind_bc(value_boundary<triplet>{triplet{42, 42, 42}}, a), bind_bc(copy_boundary{}, b, _1).associate(c), d);
+        EXPECT_THROW(cabc.wait(a), std::runtime_error);
+    } else {
+        cabc.exchange(
+            bind_bc(value_boundary<triplet>{triplet{42, 42, 42}}, a), bind_bc(copy_boundary{}, b, _1).associate(c), d);
+    }
+    EXPECT_EQ(1, cabc.get_count_exchange());
 
     a.sync();
     b.sync();
@@ -520,3 +530,209 @@ TEST(DistributedBoundaries, Test) {
 
     EXPECT_THROW(cabc.exchange(a, b, c, d), std::runtime_error);
 }
+
+TEST(DistributedBoundaries, Test) { test_exchange(false); }
+
+TEST(DistributedBoundaries, SplitPhase) { test_exchange(true); }
+
+TEST(DistributedBoundaries, JobHalos) {
+
+#ifdef __CUDACC__
+    using comm_arch = gridtools::gcl_gpu;
+#else
+    using comm_arch = gridtools::gcl_cpu;
+#endif
+    using storage_tr = gridtools::storage_traits<backend_t>;
+
+    using namespace gridtools;
+
+    using storage_info_t = storage_tr::storage_info_t<0, 3, halo<2, 2, 0>>;
+    using storage_type = storage_tr::data_store_t<triplet, storage_info_t>;
+
+    const int halo_size = 2;
+    const int d1 = 6;
+    const int d2 = 7;
+    const int d3 = 2;
+
+    storage_info_t storage_info(d1, d2, d3);
+
+    using cabc_t = distributed_boundaries<comm_traits<storage_type, comm_arch>>;
+
+    auto make_halos = [&](uint_t width) {
+        return array<halo_descriptor, 3>{
+            halo_descriptor{width, width, halo_size, d1 - halo_size - 1, (uint_t)storage_info.padded_length<0>()},
+            halo_descriptor{width, width, halo_size, d2 - halo_size - 1, (uint_t)storage_info.padded_length<1>()},
+            halo_descriptor{0, 0, 0, d3 - 1, (uint_t)storage_info.total_length<2>()}};
+    };
+
+#ifdef GCL_MPI
+    int dims[3] = {0, 0, 0};
+
+    MPI_Dims_create(PROCS, 3, dims);
+
+    int period[3] = {1, 1, 1};
+
+    MPI_Comm CartComm;
+
+    MPI_Cart_create(GCL_WORLD, 3, dims, period, false, &CartComm);
+#else
+    MPI_Comm CartComm = GCL_WORLD;
+#endif
+
+    cabc_t cabc{make_halos(halo_size), {false, false, false}, 3, CartComm};
+
+    int pi, pj, pk;
+    cabc.proc_grid().coords(pi, pj, pk);
+
+    auto value = [=](int i, int j, int k, int base) {
+        return triplet{i + pi * (d1 - 2 * halo_size) + base, j + pj * (d2 - 2 * halo_size) + base, k + base};
+    };
+    auto inner = [=](int i, int j) {
+        return i >= halo_size and j >= halo_size and i < d1 - halo_size and j < d2 - halo_size;
+    };
+
+    storage_type a(
+        storage_info, [=](int i, int j, int k) { return inner(i, j) ? value(i, j, k, 100) : triplet{0, 0, 0}; }, "a");
+    storage_type d(
+        storage_info, [=](int i, int j, int k) { return inner(i, j) ? value(i, j, k, 1000) : triplet{0, 0, 0}; }, "d");
+
+    // a is exchanged, and has the boundary condition applied, with a halo of 1, d with the halo of 2 of the pattern
+    cabc.exchange(bind_bc(value_boundary<triplet>{triplet{42, 42, 42}}, a).with_halos(make_halos(1)), d);
+
+    EXPECT_THROW(cabc.exchange(bind_bc(value_boundary<triplet>{triplet{42, 42, 42}}, a).with_halos(make_halos(3))),
+        std::runtime_error);
+
+    a.sync();
+    d.sync();
+
+    auto distance = [](int i, int size) {
+        return i < halo_size ? halo_size - i : i >= size - halo_size ? i - (size - halo_size) + 1 : 0;
+    };
+
+    bool ok = true;
+    for (int i = 0; i < d1; ++i) {
+        for (int j = 0; j < d2; ++j) {
+            for (int k = 0; k < d3; ++k) {
+                const bool from_nb =
+                    from_neighbor(region(i, d1, halo_size), region(j, d2, halo_size), 0, cabc.proc_grid());
+                const int di = distance(i, d1);
+                const int dj = distance(j, d2);
+
+                if (di == 0 and dj == 0) {
+                    ok = ok and make_host_view(a)(i, j, k) == value(i, j, k, 100);
+                } else if (di <= 1 and dj <= 1) {
+                    ok = ok and make_host_view(a)(i, j, k) == (from_nb ? value(i, j, k, 100) : triplet{42, 42, 42});
+                } else {
+#ifndef __CUDACC__
+                    // the GPU exchange sends the halos of the pattern for all the data stores
+                    ok = ok and make_host_view(a)(i, j, k) == triplet{0, 0, 0};
+#endif
+                }
+
+                if (di != 0 or dj != 0)
+                    ok = ok and make_host_view(d)(i, j, k) == (from_nb ? value(i, j, k, 1000) : triplet{0, 0, 0});
+                else
+                    ok = ok and make_host_view(d)(i, j, k) == value(i, j, k, 1000);
+            }
+        }
+    }
+
+    EXPECT_TRUE(ok);
+}
+
+namespace {
+    // a computation reading its argument upwind in i and downwind in j
+    struct upwind_computation {
+        template <typename Arg>
+        gridtools::rt_extent get_arg_extent(Arg) const {
+            return {-1, 0, 0, 2, -1, 1};
+        }
+    };
+} // namespace
+
+TEST(DistributedBoundaries, ExchangeFor) {
+
+#ifdef __CUDACC__
+    using comm_arch = gridtools::gcl_gpu;
+#else
+    using comm_arch = gridtools::gcl_cpu;
+#endif
+    using storage_tr = gridtools::storage_traits<backend_t>;
+
+    using namespace gridtools;
+
+    using storage_info_t = storage_tr::storage_info_t<0, 3, halo<2, 2, 0>>;
+    using storage_type = storage_tr::data_store_t<triplet, storage_info_t>;
+
+    const int halo_size = 2;
+    const int d1 = 6;
+    const int d2 = 7;
+    const int d3 = 2;
+
+    storage_info_t storage_info(d1, d2, d3);
+
+    using cabc_t = distributed_boundaries<comm_traits<storage_type, comm_arch>>;
+
+    halo_descriptor di{halo_size, halo_size, halo_size, d1 - halo_size - 1, (uint_t)storage_info.padded_length<0>()};
+    halo_descriptor dj{halo_size, halo_size, halo_size, d2 - halo_size - 1, (uint_t)storage_info.padded_length<1>()};
+    halo_descriptor dk{0, 0, 0, d3 - 1, (uint_t)storage_info.total_length<2>()};
+
+#ifdef GCL_MPI
+    int dims[3] = {0, 0, 0};
+
+    MPI_Dims_create(PROCS, 3, dims);
+
+    int period[3] = {1, 1, 1};
+
+    MPI_Comm CartComm;
+
+    MPI_Cart_create(GCL_WORLD, 3, dims, period, false, &CartComm);
+#else
+    MPI_Comm CartComm = GCL_WORLD;
+#endif
+
+    cabc_t cabc{array<halo_descriptor, 3>{di, dj, dk}, {false, false, false}, 3, CartComm};
+
+    int pi, pj, pk;
+    cabc.proc_grid().coords(pi, pj, pk);
+
+    auto value = [=](int i, int j, int k) {
+        return triplet{i + pi * (d1 - 2 * halo_size), j + pj * (d2 - 2 * halo_size), k + 1};
+    };
+    // the points read by upwind_computation: one in minus i, two in plus j
+    auto is_read = [=](int i, int j) {
+        return i >= halo_size - 1 and i < d1 - halo_size and j >= halo_size and j < d2;
+    };
+    auto inner = [=](int i, int j) {
+        return i >= halo_size and j >= halo_size and i < d1 - halo_size and j < d2 - halo_size;
+    };
+
+    storage_type a(
+        storage_info, [=](int i, int j, int k) { return inner(i, j) ? value(i, j, k) : triplet{0, 0, 0}; }, "a");
+
+    using p_a = arg<0, storage_type>;
+    cabc.exchange_for(upwind_computation{}, p_a() = a);
+
+    a.sync();
+
+    bool ok = true;
+    for (int i = 0; i < d1; ++i) {
+        for (int j = 0; j < d2; ++j) {
+            for (int k = 0; k < d3; ++k) {
+                const bool from_nb =
+                    from_neighbor(region(i, d1, halo_size), region(j, d2, halo_size), 0, cabc.proc_grid());
+                if (inner(i, j))
+                    ok = ok and make_host_view(a)(i, j, k) == value(i, j, k);
+                else if (is_read(i, j) and from_nb)
+                    ok = ok and make_host_view(a)(i, j, k) == value(i, j, k);
+#ifndef __CUDACC__
+                // the GPU exchange sends the halos of the pattern for all the data stores
+                else
+                    ok = ok and make_host_view(a)(i, j, k) == triplet{0, 0, 0};
+#endif
+            }
+        }
+    }
+
+    EXPECT_TRUE(ok);
+}
@@ -0,0 +1,125 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <cstdio>
+
+#include <gtest/gtest.h>
+
+#include "exported_repository.hpp"
+#include <gridtools/interface/repository/checkpoint.hpp>
+#include <gridtools/interface/repository/repository.hpp>
+#include <gridtools/storage/storage_facility.hpp>
+
+using namespace gridtools;
+
+#define MY_FIELDTYPES (IJKDataStore)(IJDataStore)
+#define MY_FIELDS (IJKDataStore, u)(IJKDataStore, v)(IJDataStore, crlat)
+GT_MAKE_REPOSITORY(checkpoint_repository, MY_FIELDTYPES, MY_FIELDS)
+#undef MY_FIELDTYPES
+#undef MY_FIELDS
+
+class checkpoint : public ::testing::Test {
+  protected:
+    std::string path = "test_checkpoint.gtckpt";
+    checkpoint_repository repo;
+
+    checkpoint() : repo(IJKStorageInfo(10, 20, 30), IJStorageInfo(11, 22, 33)) {
+        auto u = make_host_view(repo.u());
+        auto v = make_host_view(repo.v());
+        for (int i = 0; i < 10; ++i)
+            for (int j = 0; j < 20; ++j)
+                for (int k = 0; k < 30; ++k) {
+                    u(i, j, k) = i + 100 * j + 10000 * k;
+                    v(i, j, k) = -u(i, j, k);
+                }
+        auto crlat = make_host_view(repo.crlat());
+        for (int i = 0; i < 11; ++i)
+            for (int j = 0; j < 22; ++j)
+                crlat(i, j, 0) = i * j;
+    }
+
+    ~checkpoint() { std::remove(path.c_str()); }
+};
+
+TEST_F(checkpoint, write_read) {
+    write_checkpoint(repo, path);
+
+    checkpoint_repository other(IJKStorageInfo(10, 20, 30), IJStorageInfo(11, 22, 33));
+    read_checkpoint(other, path);
+
+    auto u = make_host_view(repo.u());
+    auto v = make_host_view(repo.v());
+    auto other_u = make_host_view(other.u());
+    auto other_v = make_host_view(other.v());
+    for (int i = 0; i < 10; ++i)
+        for (int j = 0; j < 20; ++j)
+            for (int k = 0; k < 30; ++k) {
+                EXPECT_EQ(u(i, j, k), other_u(i, j, k));
+                EXPECT_EQ(v(i, j, k), other_v(i, j, k));
+            }
+    auto crlat = make_host_view(repo.crlat());
+    auto other_crlat = make_host_view(other.crlat());
+    for (int i = 0; i < 11; ++i)
+        for (int j = 0; j < 22; ++j)
+            EXPECT_EQ(crlat(i, j, 0), other_crlat(i, j, 0));
+}
+
+TEST_F(checkpoint, header) {
+    write_checkpoint(repo, path);
+    checkpoint_file file(path);
+
+    auto const &fields = file.fields();
+    ASSERT_EQ(3, fields.size());
+    EXPECT_EQ("crlat", fields[0].name);
+    EXPECT_EQ("u", fields[1].name);
+    EXPECT_EQ("v", fields[2].name);
+
+    auto info = make_storage_info_rt(repo.u().info());
+    auto const &u = file.field("u");
+    EXPECT_EQ(sizeof(float_type), u.element_size);
+    EXPECT_EQ(info.total_lengths(), u.total_lengths);
+    EXPECT_EQ(info.padded_lengths(), u.padded_lengths);
+    EXPECT_EQ(info.strides(), u.strides);
+    EXPECT_EQ(repo.u().padded_total_length() * sizeof(float_type), u.size);
+    for (auto const &field : fields)
+        EXPECT_EQ(0, field.offset % checkpoint_page_size);
+
+    EXPECT_THROW(file.field("w"), std::runtime_error);
+}
+
+TEST_F(checkpoint, map) {
+    write_checkpoint(repo, path);
+    checkpoint_file file(path);
+
+    auto mapped = file.map<IJKDataStore>("u", repo.u().info());
+    EXPECT_EQ("u", mapped.name());
+    auto u = make_host_view(repo.u());
+    auto mapped_u = make_host_view(mapped);
+    for (int i = 0; i < 10; ++i)
+        for (int j = 0; j < 20; ++j)
+            for (int k = 0; k < 30; ++k)
+                EXPECT_EQ(u(i, j, k), mapped_u(i, j, k));
+
+    // the mapping is private
+    mapped_u(1, 2, 3) = -1;
+    checkpoint_repository other(IJKStorageInfo(10, 20, 30), IJStorageInfo(11, 22, 33));
+    read_checkpoint(other, path);
+    EXPECT_EQ(u(1, 2, 3), make_host_view(other.u())(1, 2, 3));
+
+    // the storage info must match
+    EXPECT_THROW(file.map<IJKDataStore>("u", IJKStorageInfo(10, 20, 31)), std::runtime_error);
+}
+
+TEST_F(checkpoint, mismatch) {
+    write_checkpoint(repo, path);
+    checkpoint_repository other(IJKStorageInfo(10, 20, 31), IJStorageInfo(11, 22, 33));
+    EXPECT_THROW(read_checkpoint(other, path), std::runtime_error);
+    EXPECT_THROW(read_checkpoint(other, "does_not_exist.gtckpt"), std::runtime_error);
+}
@@ -0,0 +1,157 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <gridtools/interface/async_output.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <gridtools/storage/storage_facility.hpp>
+
+using namespace gridtools;
+
+namespace {
+    using storage_info_t = storage_traits<backend::x86>::storage_info_t<0, 3>;
+    using data_store_t = storage_traits<backend::x86>::data_store_t<double, storage_info_t>;
+
+    void fill(data_store_t &ds, double value) {
+        auto view = make_host_view(ds);
+        for (int i = 0; i < 4; ++i)
+            for (int j = 0; j < 5; ++j)
+                for (int k = 0; k < 6; ++k)
+                    view(i, j, k) = value + i + 10 * j + 100 * k;
+    }
+} // namespace
+
+TEST(async_output, snapshot) {
+    storage_info_t info(4, 5, 6);
+    data_store_t u(info, "u"), v(info, "v");
+    std::map<std::string, std::vector<double>> written;
+    {
+        async_output out(
+            [&](output_field const &field) {
+                EXPECT_EQ(typeid(double).name(), field.type);
+                EXPECT_EQ(sizeof(double), field.element_size);
+                EXPECT_EQ(info.padded_total_length() * sizeof(double), field.size);
+                std::vector<double> values;
+                for (int i = 0; i < 4; ++i)
+                    for (int j = 0; j < 5; ++j)
+                        for (int k = 0; k < 6; ++k)
+                            values.push_back(static_cast<double const *>(field.data)[info.index(i, j, k)]);
+                written[field.name + std::to_string(field.step)] = values;
+            },
+            1 << 20);
+        for (std::size_t step = 0; step < 3; ++step) {
+            fill(u, step);
+            fill(v, -1. * step);
+            out.snapshot(step, u, v);
+            // the staging buffers of the previous step are reused
+            out.flush();
+        }
+        EXPECT_LE(out.reserved(), 2 * info.padded_total_length() * sizeof(double));
+    }
+    ASSERT_EQ(6, written.size());
+    for (std::size_t step = 0; step < 3; ++step) {
+        auto const &values = written["u" + std::to_string(step)];
+        auto const &other = written["v" + std::to_string(step)];
+        for (int i = 0; i < 4; ++i)
+            for (int j = 0; j < 5; ++j)
+                for (int k = 0; k < 6; ++k) {
+                    EXPECT_EQ(step + i + 10 * j + 100 * k, values[(i * 5 + j) * 6 + k]);
+                    EXPECT_EQ(-1. * step + i + 10 * j + 100 * k, other[(i * 5 + j) * 6 + k]);
+                }
+    }
+}
+
+TEST(async_output, back_pressure) {
+    storage_info_t info(4, 5, 6);
+    data_store_t u(info, "u");
+    std::size_t size = info.padded_total_length() * sizeof(double);
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool release = false;
+    async_output out(
+        [&](output_field const &) {
+            std::unique_lock<std::mutex> lock(mutex);
+            cv.wait(lock, [&] { return release; });
+        },
+        2 * size);
+
+    // two snapshots fit into the pool
+    out.snapshot(0, u);
+    out.snapshot(1, u);
+
+    // the third waits until the first is written
+    std::atomic<bool> done(false);
+    std::thread producer([&] {
+        out.snapshot(2, u);
+        done = true;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(done);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        release = true;
+    }
+    cv.notify_all();
+    producer.join();
+    EXPECT_TRUE(done);
+    out.flush();
+    EXPECT_LE(out.reserved(), 2 * size);
+}
+
+TEST(async_output, error) {
+    storage_info_t info(4, 5, 6);
+    data_store_t u(info, "u");
+    async_output out([](output_field const &) { throw std::runtime_error("failed"); }, 1 << 20);
+    out.snapshot(0, u);
+    EXPECT_THROW(out.flush(), std::runtime_error);
+    // the error is reported once
+    out.flush();
+}
+
+TEST(async_output, error_at_destruction) {
+    storage_info_t info(4, 5, 6);
+    data_store_t u(info, "u");
+    testing::internal::CaptureStderr();
+    {
+        async_output out([](output_field const &) { throw std::runtime_error("failed"); }, 1 << 20);
+        out.snapshot(0, u);
+    }
+    // the error of the last snapshot is not lost without a flush
+    EXPECT_NE(std::string::npos, testing::internal::GetCapturedStderr().find("failed"));
+}
+
+TEST(async_output, raw_file_writer) {
+    storage_info_t info(4, 5, 6);
+    data_store_t u(info, "u");
+    fill(u, 0);
+    {
+        async_output out(raw_file_writer{"test_async_output_"}, 1 << 20);
+        out.snapshot(7, u);
+    }
+    std::string path = "test_async_output_u.7";
+    std::ifstream in(path, std::ios::binary);
+    std::vector<double> values(info.padded_total_length());
+    in.read(reinterpret_cast<char *>(values.data()), values.size() * sizeof(double));
+    EXPECT_TRUE(in);
+    EXPECT_EQ(1 + 10 * 2 + 100 * 3, values[info.index(1, 2, 3)]);
+    std::remove(path.c_str());
+}
@@ -160,3 +160,15 @@ TEST_F(expandable_parameters, caches) {
             make_stage<copy_functor>(p_out, p_tmp)));
     verify({in, in, in, in, in}, out);
 }
+
+TEST_F(expandable_parameters_copy, split_run) {
+    arg<0, storages_t> p_out;
+    arg<1, storages_t> p_in;
+    auto comp = gridtools::make_expandable_computation<backend_t>(expand_factor<2>(),
+        make_grid(),
+        p_in = in,
+        p_out = out,
+        make_multistage(execute::forward(), make_stage<copy_functor>(p_out, p_in)));
+    comp.run_interior_async().wait();
+    comp.run_boundary();
+}
@@ -0,0 +1,148 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <atomic>
+
+#include <gtest/gtest.h>
+
+#include <gridtools/stencil_composition/stencil_composition.hpp>
+#include <gridtools/stencil_composition/structured_grids/backend_mc/simd_mc.hpp>
+#include <gridtools/storage/storage_facility.hpp>
+#include <gridtools/tools/backend_select.hpp>
+
+namespace gridtools {
+    namespace {
+        // the widest evaluation seen so far, in number of points along i
+        std::atomic<int> g_lanes{0};
+
+        template <class T>
+        void record_lanes(T const &) {
+            int lanes = sizeof(T) / sizeof(float_type);
+            int current = g_lanes;
+            while (current < lanes && !g_lanes.compare_exchange_weak(current, lanes)) {
+            }
+        }
+
+        struct lap {
+            using out = inout_accessor<0>;
+            using in = in_accessor<1, extent<-1, 1, -1, 1>>;
+            using param_list = make_param_list<out, in>;
+            using vectorizable = std::true_type;
+
+            template <typename Evaluation>
+            GT_FUNCTION static void apply(Evaluation eval) {
+                record_lanes(eval(in()));
+                eval(out()) = 4 * eval(in()) - (eval(in(1, 0)) + eval(in(0, 1)) + eval(in(-1, 0)) + eval(in(0, -1)));
+            }
+        };
+
+        struct flx {
+            using out = inout_accessor<0>;
+            using in = in_accessor<1, extent<0, 1, 0, 0>>;
+            using lap = in_accessor<2, extent<0, 1, 0, 0>>;
+            using param_list = make_param_list<out, in, lap>;
+            using vectorizable = std::true_type;
+
+            template <typename Evaluation>
+            GT_FUNCTION static void apply(Evaluation eval) {
+                auto res = eval(lap(1, 0)) - eval(lap(0, 0));
+                eval(out()) = res * (eval(in(1, 0)) - eval(in(0, 0))) > 0 ? 0 : res;
+            }
+        };
+
+        struct clip {
+            using out = inout_accessor<0>;
+            using in = in_accessor<1, extent<-1, 0, 0, 0>>;
+            using param_list = make_param_list<out, in>;
+
+            template <typename Evaluation>
+            GT_FUNCTION static void apply(Evaluation eval) {
+                if (eval(in(-1, 0)) > 0)
+                    eval(out()) = eval(in(-1, 0));
+                else
+                    eval(out()) = 0;
+            }
+        };
+
+        static_assert(is_vectorizable_functor<lap>::value, "");
+        static_assert(is_vectorizable_functor<flx>::value, "");
+        static_assert(!is_vectorizable_functor<clip>::value, "");
+
+        using storage_info_t = storage_traits<backend_t>::storage_info_t<0, 3, halo<2, 2, 0>>;
+        using data_store_t = storage_traits<backend_t>::data_store_t<float_type, storage_info_t>;
+
+        using p_in = arg<0, data_store_t>;
+        using p_out = arg<1, data_store_t>;
+        using p_lap = tmp_arg<2, data_store_t>;
+        using p_flx = tmp_arg<3, data_store_t>;
+
+        class simd_mc : public ::testing::Test {
+          protected:
+            static constexpr int d1 = 37, d2 = 13, d3 = 3;
+
+            storage_info_t m_storage_info{d1 + 4, d2 + 4, d3};
+            data_store_t m_in{m_storage_info, &simd_mc::in_ref};
+            data_store_t m_out{m_storage_info, -1.};
+
+            halo_descriptor m_di{2, 2, 2, d1 + 1, d1 + 4};
+            halo_descriptor m_dj{2, 2, 2, d2 + 1, d2 + 4};
+
+            static float_type in_ref(int i, int j, int k) { return (i * i * j + k) % 7 - 3; }
+            static float_type lap_ref(int i, int j, int k) {
+                return 4 * in_ref(i, j, k) -
+                       (in_ref(i + 1, j, k) + in_ref(i, j + 1, k) + in_ref(i - 1, j, k) + in_ref(i, j - 1, k));
+            }
+            static float_type flx_ref(int i, int j, int k) {
+                auto res = lap_ref(i + 1, j, k) - lap_ref(i, j, k);
+                return res * (in_ref(i + 1, j, k) - in_ref(i, j, k)) > 0 ? 0 : res;
+            }
+            static float_type clip_ref(int i, int j, int k) {
+                return flx_ref(i - 1, j, k) > 0 ? flx_ref(i - 1, j, k) : 0;
+            }
+
+            template <class Expected>
+            void verify(Expected expected) {
+                m_out.sync();
+                auto out = make_host_view(m_out);
+                for (int i = 2; i < d1 + 2; ++i)
+                    for (int j = 2; j < d2 + 2; ++j)
+                        for (int k = 0; k < d3; ++k)
+                            EXPECT_EQ(expected(i, j, k), out(i, j, k)) << i << ", " << j << ", " << k;
+            }
+        };
+
+        TEST_F(simd_mc, laplacian) {
+            g_lanes = 0;
+            make_computation<backend_t>(make_grid(m_di, m_dj, d3),
+                p_in() = m_in,
+                p_out() = m_out,
+                make_multistage(execute::forward(), make_stage<lap>(p_out(), p_in())))
+                .run();
+            verify(&simd_mc::lap_ref);
+#ifdef GT_BACKEND_MC
+            EXPECT_EQ(simd_lanes_mc<float_type>::value, g_lanes);
+#else
+            EXPECT_EQ(1, g_lanes);
+#endif
+        }
+
+        TEST_F(simd_mc, mixed_stages) {
+            make_computation<backend_t>(make_grid(m_di, m_dj, d3),
+                p_in() = m_in,
+                p_out() = m_out,
+                make_multistage(execute::parallel(),
+                    make_stage<lap>(p_lap(), p_in()),
+                    make_stage<flx>(p_flx(), p_in(), p_lap()),
+                    make_stage<clip>(p_out(), p_flx())))
+                .run();
+            verify(&simd_mc::clip_ref);
+        }
+    } // namespace
+} // namespace gridtools
@@ -0,0 +1,135 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <gtest/gtest.h>
+
+#include <gridtools/stencil_composition/stencil_composition.hpp>
+#include <gridtools/storage/storage_facility.hpp>
+#include <gridtools/tools/backend_select.hpp>
+
+namespace gridtools {
+    namespace {
+        struct lap_i {
+            using in = accessor<0, intent::in, extent<-1, 1, 0, 0>>;
+            using out = accessor<1, intent::inout>;
+            using param_list = make_param_list<in, out>;
+
+            template <typename Evaluation>
+            GT_FUNCTION static void apply(Evaluation &eval) {
+                eval(out()) = eval(in(-1, 0, 0)) + eval(in(1, 0, 0)) - 2 * eval(in());
+            }
+        };
+
+        struct lap_j {
+            using in = accessor<0, intent::in, extent<0, 0, -1, 1>>;
+            using out = accessor<1, intent::inout>;
+            using param_list = make_param_list<in, out>;
+
+            template <typename Evaluation>
+            GT_FUNCTION static void apply(Evaluation &eval) {
+                eval(out()) = eval(in(0, -1, 0)) + eval(in(0, 1, 0)) - 2 * eval(in());
+            }
+        };
+
+        using storage_info_t = storage_traits<backend_t>::storage_info_t<0, 3, halo<1, 1, 0>>;
+        using data_store_t = storage_traits<backend_t>::data_store_t<double, storage_info_t>;
+
+        using p_in = arg<0, data_store_t>;
+        using p_out = arg<1, data_store_t>;
+        using p_tmp = tmp_arg<2, data_store_t>;
+
+        class tiling_fixture : public ::testing::Test {
+          protected:
+            static constexpr uint_t d1 = 37, d2 = 23, d3 = 5;
+
+            storage_info_t m_storage_info{d1 + 2, d2 + 2, d3};
+            data_store_t m_in{m_storage_info, [](int i, int j, int) { return i * i * j * j * j; }};
+            data_store_t m_out{m_storage_info, 0.};
+
+            halo_descriptor m_di{1, 1, 1, d1, d1 + 2};
+            halo_descriptor m_dj{1, 1, 1, d2, d2 + 2};
+
+            computation<p_in, p_out> make_comp() {
+                return make_computation<backend_t>(make_grid(m_di, m_dj, d3),
+                    make_multistage(execute::forward(),
+                        make_stage<lap_i>(p_in(), p_tmp()),
+                        make_stage<lap_j>(p_tmp(), p_out())));
+            }
+
+            void run_and_verify(computation<p_in, p_out> &comp) {
+                comp.run(p_in() = m_in, p_out() = m_out);
+                m_out.sync();
+                auto out = make_host_view(m_out);
+                for (int i = 1; i <= d1; ++i)
+                    for (int j = 1; j <= d2; ++j)
+                        for (int k = 0; k < d3; ++k)
+                            EXPECT_EQ(12 * j, out(i, j, k));
+            }
+        };
+
+        TEST(tiling_tuner, selects_fastest) {
+            tiling_tuner testee({{1, 1}, {2, 2}, {3, 3}}, 2);
+            EXPECT_FALSE(testee.done());
+            double times[] = {3, 4, 1, 5, 2, 2};
+            int expected_i[] = {1, 1, 2, 2, 3, 3};
+            for (int run = 0; run != 6; ++run) {
+                EXPECT_EQ(expected_i[run], testee.current().i_block_size);
+                testee.record(times[run]);
+            }
+            EXPECT_TRUE(testee.done());
+            EXPECT_EQ((tiling{2, 2}), testee.best());
+            EXPECT_EQ((tiling{3, 3}), testee.enclosing());
+        }
+
+        TEST(tiling_tuner, empty) {
+            tiling_tuner testee({}, 3);
+            EXPECT_TRUE(testee.done());
+        }
+
+        TEST_F(tiling_fixture, default_tiling) {
+            auto comp = make_comp();
+            EXPECT_FALSE(comp.is_tiling_autotuner_active());
+            EXPECT_GT(comp.get_tiling().i_block_size, 0);
+            EXPECT_GT(comp.get_tiling().j_block_size, 0);
+            run_and_verify(comp);
+        }
+
+        TEST_F(tiling_fixture, autotuner) {
+            auto comp = make_comp();
+            comp.enable_tiling_autotuner();
+            for (int run = 0; comp.is_tiling_autotuner_active(); ++run) {
+                ASSERT_LT(run, 1000);
+                run_and_verify(comp);
+            }
+            run_and_verify(comp);
+
+            // the locked-in tiling can be reloaded in a fresh computation
+            auto tuned = comp.get_tiling();
+            auto other = make_comp();
+            other.set_tiling(tuned);
+            EXPECT_EQ(tuned, other.get_tiling());
+            run_and_verify(other);
+        }
+
+        TEST_F(tiling_fixture, set_tiling) {
+            auto comp = make_comp();
+            auto initial = comp.get_tiling();
+            comp.set_tiling({5, 3});
+#ifdef GT_BACKEND_MC
+            EXPECT_EQ((tiling{5, 3}), comp.get_tiling());
+#else
+            EXPECT_EQ(initial, comp.get_tiling());
+#endif
+            run_and_verify(comp);
+            comp.set_tiling({d1 + 10, 1});
+            run_and_verify(comp);
+        }
+    } // namespace
+} // namespace gridtools
@@ -0,0 +1,125 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <gridtools/stencil_composition/async_run.hpp>
+
+#include <future>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <gridtools/stencil_composition/computation.hpp>
+#include <gridtools/stencil_composition/stencil_composition.hpp>
+#include <gridtools/storage/storage_facility.hpp>
+#include <gridtools/tools/backend_select.hpp>
+
+namespace gridtools {
+    namespace {
+        struct copy_functor {
+            using in = in_accessor<0>;
+            using out = inout_accessor<1>;
+            using param_list = make_param_list<in, out>;
+
+            template <typename Evaluation>
+            GT_FUNCTION static void apply(Evaluation eval) {
+                eval(out()) = eval(in());
+            }
+        };
+
+        struct increment_functor {
+            using field = inout_accessor<0>;
+            using param_list = make_param_list<field>;
+
+            template <typename Evaluation>
+            GT_FUNCTION static void apply(Evaluation eval) {
+                eval(field()) = eval(field()) + 1;
+            }
+        };
+
+        using storage_info_t = storage_traits<backend_t>::storage_info_t<0, 3>;
+        using data_store_t = storage_traits<backend_t>::data_store_t<float_type, storage_info_t>;
+
+        using p_in = arg<0, data_store_t>;
+        using p_out = arg<1, data_store_t>;
+
+        constexpr int d1 = 33, d2 = 34, d3 = 35;
+
+        struct async_run : ::testing::Test {
+            storage_info_t m_info{d1, d2, d3};
+            data_store_t m_a{m_info, 0.};
+            data_store_t m_b{m_info, -1.};
+            data_store_t m_c{m_info, -1.};
+
+            computation<p_in, p_out> m_copy = make_computation<backend_t>(make_grid(d1, d2, d3),
+                make_multistage(execute::parallel(), make_stage<copy_functor>(p_in(), p_out())));
+            computation<p_out> m_increment = make_computation<backend_t>(
+                make_grid(d1, d2, d3), make_multistage(execute::parallel(), make_stage<increment_functor>(p_out())));
+
+            void verify(data_store_t &field, float_type expected) {
+                field.sync();
+                auto view = make_host_view(field);
+                for (int i = 0; i < d1; ++i)
+                    for (int j = 0; j < d2; ++j)
+                        for (int k = 0; k < d3; ++k)
+                            ASSERT_EQ(expected, view(i, j, k)) << i << ", " << j << ", " << k;
+            }
+        };
+
+        TEST_F(async_run, field_accesses) {
+            std::vector<field_access> accesses;
+            add_field_accesses(m_a, true, accesses);
+            add_field_accesses(std::vector<data_store_t>{m_b, m_c}, false, accesses);
+            add_field_accesses(42, false, accesses);
+            ASSERT_EQ(3, accesses.size());
+            EXPECT_EQ(m_a.get_storage_ptr().get(), accesses[0].m_key);
+            EXPECT_TRUE(accesses[0].m_written);
+            EXPECT_EQ(m_c.get_storage_ptr().get(), accesses[2].m_key);
+            EXPECT_FALSE(accesses[2].m_written);
+        }
+
+        TEST_F(async_run, same_computation) {
+            std::vector<std::shared_future<void>> runs;
+            for (int i = 0; i != 5; ++i)
+                runs.push_back(m_increment.run_async(p_out() = m_a));
+            runs.front().wait();
+            runs.back().get();
+            verify(m_a, 5);
+        }
+
+        TEST_F(async_run, read_after_write) {
+            m_increment.run_async(p_out() = m_a);
+            m_copy.run_async(p_in() = m_a, p_out() = m_b);
+            m_increment.run_async(p_out() = m_b);
+            m_copy.run_async(p_in() = m_b, p_out() = m_c).get();
+            verify(m_c, 2);
+        }
+
+        TEST_F(async_run, write_after_read) {
+            m_increment.run(p_out() = m_a);
+            auto copied = m_copy.run_async(p_in() = m_a, p_out() = m_b);
+            // waits for the copy to finish before writing m_a
+            m_increment.run(p_out() = m_a);
+            copied.get();
+            verify(m_b, 1);
+            verify(m_a, 2);
+        }
+
+        TEST_F(async_run, move_assignment) {
+            for (int i = 0; i != 3; ++i)
+                m_increment.run_async(p_out() = m_a);
+            // waits for the pending runs of both computations before replacing the computation
+            m_increment = make_computation<backend_t>(
+                make_grid(d1, d2, d3), make_multistage(execute::parallel(), make_stage<increment_functor>(p_out())));
+            verify(m_a, 3);
+            m_increment.run_async(p_out() = m_a).get();
+            verify(m_a, 4);
+        }
+    } // namespace
+} // namespace gridtools
@@ -48,6 +48,7 @@ namespace gridtools {
             }
             size_t get_count() const { return m_count; }
             double get_time() const { return 0.; /* unused */ }
+            std::string print_stage_meters() const { return {}; }
 
             template <typename Arg>
             static rt_extent get_arg_extent(Arg) {
@@ -81,6 +82,24 @@ namespace gridtools {
             // testee.run(a{} = data());
         }
 
+        TEST(computation, run_async) {
+            // my_computation has no run_async, it is run synchronously
+            computation<> testee = my_computation{};
+            testee.run_async().wait();
+            EXPECT_EQ(testee.get_count(), 1);
+        }
+
+        TEST(computation, split_run) {
+            // my_computation has no split run, the boundary run does all the work
+            computation<> testee = my_computation{};
+            testee.run_interior();
+            EXPECT_EQ(testee.get_count(), 0);
+            testee.run_boundary();
+            testee.run_interior_async().wait();
+            testee.run_boundary();
+            EXPECT_EQ(testee.get_count(), 2);
+        }
+
         TEST(computation, move) {
             auto make = []() { return computation<>(my_computation{}); };
             auto testee = make();
@@ -113,6 +132,15 @@ namespace gridtools {
             testee.run(b{} = data("bar"), a{} = data("foo"));
         }
 
+        TEST(computation, tiling) {
+            // my_computation has no runtime tiling, it keeps the backend default
+            computation<> testee = my_computation{};
+            testee.set_tiling({4, 2});
+            EXPECT_EQ((tiling{0, 0}), testee.get_tiling());
+            testee.enable_tiling_autotuner();
+            EXPECT_FALSE(testee.is_tiling_autotuner_active());
+        }
+
         TEST(computation, convertible_args) {
             computation<a, b> tmp = my_computation{};
             tmp.run(a{} = data(), b{} = data());
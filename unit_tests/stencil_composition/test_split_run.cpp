@@ -0,0 +1,130 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <gtest/gtest.h>
+
+#include <gridtools/stencil_composition/computation.hpp>
+#include <gridtools/stencil_composition/stencil_composition.hpp>
+#include <gridtools/storage/storage_facility.hpp>
+#include <gridtools/tools/backend_select.hpp>
+
+namespace gridtools {
+    namespace {
+        struct copy_functor {
+            using in = in_accessor<0>;
+            using out = inout_accessor<1>;
+            using param_list = make_param_list<in, out>;
+
+            template <typename Evaluation>
+            GT_FUNCTION static void apply(Evaluation eval) {
+                eval(out()) = eval(in());
+            }
+        };
+
+        struct sum_functor {
+            using in = in_accessor<0, extent<-1, 1, -1, 1>>;
+            using out = inout_accessor<1>;
+            using param_list = make_param_list<in, out>;
+
+            template <typename Evaluation>
+            GT_FUNCTION static void apply(Evaluation eval) {
+                eval(out()) = eval(in(-1, 0, 0)) + eval(in(1, 0, 0)) + eval(in(0, -1, 0)) + eval(in(0, 1, 0));
+            }
+        };
+
+        using storage_info_t = storage_traits<backend_t>::storage_info_t<0, 3, halo<1, 1, 0>>;
+        using data_store_t = storage_traits<backend_t>::data_store_t<float_type, storage_info_t>;
+
+        using p_in = arg<0, data_store_t>;
+        using p_out = arg<1, data_store_t>;
+        using p_tmp = tmp_arg<2, data_store_t>;
+
+        constexpr int d1 = 13, d2 = 12, d3 = 5;
+        constexpr float_type garbage = 1e10;
+
+        bool in_halo(int i, int j) { return i == 0 || j == 0 || i == d1 - 1 || j == d2 - 1; }
+
+        // the interior does not depend on the halo of the input
+        bool in_interior(int i, int j) { return i > 1 && j > 1 && i < d1 - 2 && j < d2 - 2; }
+
+        struct split_run : ::testing::Test {
+            storage_info_t m_info{d1, d2, d3};
+            data_store_t m_in{m_info, [](int i, int j, int k) { return in_halo(i, j) ? garbage : i + 2 * j + 3 * k; }};
+            data_store_t m_out{m_info, -1.};
+
+            halo_descriptor m_di{1, 1, 1, d1 - 2, d1};
+            halo_descriptor m_dj{1, 1, 1, d2 - 2, d2};
+
+            computation<p_in, p_out> m_comp = make_computation<backend_t>(make_grid(m_di, m_dj, d3),
+                make_multistage(execute::parallel(),
+                    make_stage<copy_functor>(p_in(), p_tmp()),
+                    make_stage<sum_functor>(p_tmp(), p_out())));
+
+            // what a halo exchange would do
+            void fill_halo() {
+                m_in.sync();
+                auto view = make_host_view(m_in);
+                for (int i = 0; i < d1; ++i)
+                    for (int j = 0; j < d2; ++j)
+                        for (int k = 0; k < d3; ++k)
+                            if (in_halo(i, j))
+                                view(i, j, k) = i + 2 * j + 3 * k;
+                m_in.sync();
+            }
+
+            template <class Pred>
+            void verify(Pred pred) {
+                m_out.sync();
+                auto view = make_host_view(m_out);
+                for (int i = 0; i < d1; ++i)
+                    for (int j = 0; j < d2; ++j)
+                        for (int k = 0; k < d3; ++k) {
+                            float_type expected = !in_halo(i, j) && pred(i, j) ? 4 * i + 8 * j + 12 * k : -1;
+                            ASSERT_EQ(expected, view(i, j, k)) << i << ", " << j << ", " << k;
+                        }
+                m_out.sync();
+            }
+        };
+
+        TEST_F(split_run, interior_then_boundary) {
+            m_comp.run_interior(p_in() = m_in, p_out() = m_out);
+            verify(in_interior);
+            fill_halo();
+            m_comp.run_boundary(p_in() = m_in, p_out() = m_out);
+            verify([](int, int) { return true; });
+            // the two phases are metered separately
+            EXPECT_EQ(2, m_comp.get_count());
+        }
+
+        TEST_F(split_run, async_interior) {
+            auto interior = m_comp.run_interior_async(p_in() = m_in, p_out() = m_out);
+            // the halo exchange overlaps with the interior run
+            fill_halo();
+            interior.wait();
+            verify(in_interior);
+            m_comp.run_boundary(p_in() = m_in, p_out() = m_out);
+            verify([](int, int) { return true; });
+        }
+
+        TEST_F(split_run, small_domain) {
+            halo_descriptor di{1, 1, 1, 2, 4};
+            auto comp = make_computation<backend_t>(make_grid(di, m_dj, d3),
+                make_multistage(execute::parallel(),
+                    make_stage<copy_functor>(p_in(), p_tmp()),
+                    make_stage<sum_functor>(p_tmp(), p_out())));
+            // the interior is empty
+            comp.run_interior(p_in() = m_in, p_out() = m_out);
+            verify([](int, int) { return false; });
+            fill_halo();
+            comp.run_boundary(p_in() = m_in, p_out() = m_out);
+            verify([](int i, int) { return i < 3; });
+        }
+    } // namespace
+} // namespace gridtools
@@ -0,0 +1,192 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#define GT_ENABLE_STAGE_METERS
+
+#include <gridtools/stencil_composition/stage_meters.hpp>
+
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <gridtools/stencil_composition/computation.hpp>
+#include <gridtools/stencil_composition/stencil_composition.hpp>
+#include <gridtools/storage/storage_facility.hpp>
+#include <gridtools/tools/backend_select.hpp>
+
+namespace gridtools {
+    namespace {
+        struct copy_functor {
+            using in = in_accessor<0>;
+            using out = inout_accessor<1>;
+            using param_list = make_param_list<in, out>;
+
+            template <typename Evaluation>
+            GT_FUNCTION static void apply(Evaluation eval) {
+                eval(out()) = eval(in());
+            }
+        };
+
+        struct scale_functor {
+            using in = in_accessor<0>;
+            using out = inout_accessor<1>;
+            using param_list = make_param_list<in, out>;
+
+            template <typename Evaluation>
+            GT_FUNCTION static void apply(Evaluation eval) {
+                eval(out()) = 2 * eval(in());
+            }
+        };
+
+        using storage_info_t = storage_traits<backend_t>::storage_info_t<0, 3>;
+        using data_store_t = storage_traits<backend_t>::data_store_t<float_type, storage_info_t>;
+
+        using p_in = arg<0, data_store_t>;
+        using p_out = arg<1, data_store_t>;
+        using p_tmp = tmp_arg<2, data_store_t>;
+
+        struct shift_functor {
+            using in = in_accessor<0, extent<-1, 1, 0, 0>>;
+            using out = inout_accessor<1>;
+            using param_list = make_param_list<in, out>;
+
+            template <typename Evaluation>
+            GT_FUNCTION static void apply(Evaluation eval) {
+                eval(out()) = eval(in(-1, 0, 0)) + eval(in(1, 0, 0));
+            }
+        };
+
+        std::vector<std::string> lines(std::string const &src) {
+            std::vector<std::string> res;
+            std::istringstream in(src);
+            for (std::string line; std::getline(in, line);)
+                res.push_back(line);
+            return res;
+        }
+
+        TEST(stage_meters, per_multistage) {
+            storage_info_t info(11, 12, 13);
+            data_store_t in(info, [](int i, int j, int k) { return i + 2 * j + 3 * k; });
+            data_store_t out(info, -1.);
+
+            computation<> testee = make_computation<backend_t>(make_grid(11, 12, 13),
+                p_in() = in,
+                p_out() = out,
+                make_multistage(execute::forward(), make_stage<copy_functor>(p_in(), p_tmp())),
+                make_multistage(execute::forward(), make_stage<scale_functor>(p_tmp(), p_out())));
+            testee.run();
+            testee.run();
+
+            auto meters = lines(testee.print_stage_meters());
+            ASSERT_EQ(2, meters.size());
+            EXPECT_NE(std::string::npos, meters[0].find("copy_functor"));
+            EXPECT_NE(std::string::npos, meters[1].find("scale_functor"));
+            for (auto const &meter : meters) {
+                EXPECT_NE(std::string::npos, meter.find("(2x called)")) << meter;
+                // the meters use a real timer
+                std::istringstream time(meter.substr(meter.find("\t[s]\t") + 5));
+                double seconds = 0;
+                time >> seconds;
+                EXPECT_GT(seconds, 0) << meter;
+                // two runs, one read and one written field of 11 x 12 x 13 points
+                std::ostringstream bytes;
+                bytes << "\t[GB]\t" << 1e-9 * 2 * 3 * sizeof(float_type) * 11 * 12 * 13;
+                EXPECT_NE(std::string::npos, meter.find(bytes.str())) << meter;
+            }
+
+            testee.reset_meter();
+            EXPECT_NE(std::string::npos, testee.print_stage_meters().find("(0x called)"));
+
+            out.sync();
+            auto view = make_host_view(out);
+            for (int i = 0; i < 11; ++i)
+                for (int j = 0; j < 12; ++j)
+                    for (int k = 0; k < 13; ++k)
+                        EXPECT_EQ(2 * (i + 2 * j + 3 * k), view(i, j, k));
+        }
+
+        TEST(stage_meters, per_component) {
+            storage_info_t info(11, 12, 13);
+            data_store_t in(info, 1.);
+            data_store_t out(info, -1.);
+
+            computation<> testee = make_computation<backend_t>(make_grid(11, 12, 13),
+                p_in() = in,
+                p_out() = out,
+                make_multistage(execute::forward(),
+                    make_stage<copy_functor>(p_in(), p_tmp()),
+                    make_stage<scale_functor>(p_tmp(), p_out())));
+            testee.run();
+
+            // the backends that do not fuse the stages of a multistage break it down by component
+            bool split = std::is_same<backend_t, backend::mc>::value || std::is_same<backend_t, backend::x86>::value;
+            auto meters = lines(testee.print_stage_meters());
+            ASSERT_EQ(split ? 3 : 1, meters.size());
+            EXPECT_EQ(0, meters[0].find("multistage 0 ("));
+            EXPECT_NE(std::string::npos, meters[0].find("copy_functor"));
+            EXPECT_NE(std::string::npos, meters[0].find("scale_functor"));
+            if (split) {
+                EXPECT_EQ(0, meters[1].find("\tcomponent 0 (")) << meters[1];
+                EXPECT_NE(std::string::npos, meters[1].find("copy_functor")) << meters[1];
+                EXPECT_EQ(0, meters[2].find("\tcomponent 1 (")) << meters[2];
+                EXPECT_NE(std::string::npos, meters[2].find("scale_functor")) << meters[2];
+            }
+            for (auto const &meter : meters)
+                EXPECT_NE(std::string::npos, meter.find("(1x called)")) << meter;
+        }
+
+        TEST(stage_meters, block_loop) {
+            storage_info_t info(11, 12, 13);
+            data_store_t in(info, 1.);
+            data_store_t out(info, -1.);
+
+            computation<> testee = make_computation<backend_t>(make_grid(11, 12, 13),
+                p_in() = in,
+                p_out() = out,
+                make_multistage(execute::parallel(), make_stage<copy_functor>(p_in(), p_out())));
+            testee.run();
+
+            // the k-parallel loop of the mc backend is timed as a whole
+            auto meters = lines(testee.print_stage_meters());
+            if (std::is_same<backend_t, backend::mc>::value) {
+                ASSERT_EQ(2, meters.size());
+                EXPECT_NE(std::string::npos, meters[0].find("(0x called)")) << meters[0];
+                EXPECT_EQ(0, meters[1].find("block loop")) << meters[1];
+                EXPECT_NE(std::string::npos, meters[1].find("(1x called)")) << meters[1];
+            } else {
+                ASSERT_EQ(1, meters.size());
+                EXPECT_NE(std::string::npos, meters[0].find("(1x called)")) << meters[0];
+            }
+        }
+
+        TEST(stage_meters, count_per_component) {
+            storage_info_t info(3, 4, 5);
+            data_store_t in(info, 1.);
+            data_store_t out(info, -1.);
+
+            // the interior of the compute domain is empty: a single point in i, whose neighbors are in the halo
+            halo_descriptor di{1, 1, 1, 1, 3};
+            computation<> testee = make_computation<backend_t>(make_grid(di, 4, 5),
+                p_in() = in,
+                p_out() = out,
+                make_multistage(execute::forward(), make_stage<shift_functor>(p_in(), p_out())));
+            testee.run();
+            testee.run_interior();
+
+            // the component is counted for the run that executed it only
+            auto meters = lines(testee.print_stage_meters());
+            ASSERT_EQ(1, meters.size());
+            EXPECT_NE(std::string::npos, meters[0].find("(1x called)")) << meters[0];
+        }
+    } // namespace
+} // namespace gridtools
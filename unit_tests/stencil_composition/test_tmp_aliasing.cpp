@@ -0,0 +1,115 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <gridtools/stencil_composition/tmp_aliasing.hpp>
+
+#include <gtest/gtest.h>
+
+#include <gridtools/stencil_composition/stencil_composition.hpp>
+#include <gridtools/stencil_composition/tmp_storage_pool.hpp>
+#include <gridtools/storage/storage_facility.hpp>
+#include <gridtools/tools/backend_select.hpp>
+
+namespace gridtools {
+    namespace {
+        using storage_info_t = storage_traits<backend_t>::storage_info_t<0, 3>;
+        using data_store_t = storage_traits<backend_t>::data_store_t<float_type, storage_info_t>;
+        using other_data_store_t = storage_traits<backend_t>::data_store_t<int, storage_info_t>;
+
+        using p_in = arg<0, data_store_t>;
+        using p_out = arg<1, data_store_t>;
+        using p_tmp1 = tmp_arg<2, data_store_t>;
+        using p_tmp2 = tmp_arg<3, data_store_t>;
+        using p_tmp3 = tmp_arg<4, data_store_t>;
+        using p_tmp4 = tmp_arg<5, other_data_store_t>;
+
+        namespace static_tests {
+            using msses_t = meta::list<meta::list<p_in, p_tmp1>,
+                meta::list<p_tmp1, p_tmp2>,
+                meta::list<p_tmp2, p_tmp3, p_tmp4>,
+                meta::list<p_tmp3, p_tmp4, p_out>>;
+
+            using groups_t = GT_META_CALL(tmp_alias_groups, (msses_t, meta::list<p_tmp1, p_tmp2, p_tmp3, p_tmp4>));
+
+            static_assert(std::is_same<groups_t,
+                              meta::list<meta::list<p_tmp1, p_tmp3>, meta::list<p_tmp2>, meta::list<p_tmp4>>>(),
+                "");
+            static_assert(std::is_same<GT_META_CALL(tmp_alias_representative, (groups_t, p_tmp3)), p_tmp1>(), "");
+            static_assert(std::is_same<GT_META_CALL(tmp_alias_representative, (groups_t, p_tmp2)), p_tmp2>(), "");
+
+            // the live ranges of tmp1 and tmp2 overlap
+            static_assert(std::is_same<GT_META_CALL(tmp_alias_groups,
+                                           (meta::list<meta::list<p_tmp1, p_tmp2>, meta::list<p_tmp1, p_tmp2>>,
+                                               meta::list<p_tmp1, p_tmp2>)),
+                              meta::list<meta::list<p_tmp1>, meta::list<p_tmp2>>>(),
+                "");
+        } // namespace static_tests
+
+        struct copy_functor {
+            using in = in_accessor<0>;
+            using out = inout_accessor<1>;
+            using param_list = make_param_list<in, out>;
+
+            template <typename Evaluation>
+            GT_FUNCTION static void apply(Evaluation eval) {
+                eval(out()) = eval(in());
+            }
+        };
+
+        struct add_functor {
+            using in1 = in_accessor<0>;
+            using in2 = in_accessor<1>;
+            using out = inout_accessor<2>;
+            using param_list = make_param_list<in1, in2, out>;
+
+            template <typename Evaluation>
+            GT_FUNCTION static void apply(Evaluation eval) {
+                eval(out()) = eval(in1()) + eval(in2());
+            }
+        };
+
+        TEST(tmp_aliasing, chain_of_multistages) {
+            auto &pool = tmp_storage_pool<backend_t>::instance();
+            storage_info_t info(11, 12, 13);
+            data_store_t in(info, [](int i, int j, int k) { return i + 2 * j + 3 * k; });
+            data_store_t out(info, -1.);
+            auto grid = make_grid(11, 12, 13);
+
+            pool.release();
+            make_computation<backend_t>(grid,
+                p_in() = in,
+                p_out() = out,
+                make_multistage(execute::forward(), make_stage<copy_functor>(p_in(), p_tmp1())),
+                make_multistage(execute::forward(), make_stage<copy_functor>(p_tmp1(), p_out())))
+                .run();
+            auto one_buffer = pool.allocated_bytes();
+            EXPECT_GT(one_buffer, 0);
+
+            pool.release();
+            make_computation<backend_t>(grid,
+                p_in() = in,
+                p_out() = out,
+                make_multistage(execute::forward(), make_stage<copy_functor>(p_in(), p_tmp1())),
+                make_multistage(execute::forward(), make_stage<add_functor>(p_tmp1(), p_tmp1(), p_tmp2())),
+                make_multistage(execute::forward(), make_stage<add_functor>(p_tmp2(), p_in(), p_tmp3())),
+                make_multistage(execute::forward(), make_stage<copy_functor>(p_tmp3(), p_out())))
+                .run();
+            // tmp1 and tmp3 share a buffer
+            EXPECT_EQ(2 * one_buffer, pool.allocated_bytes());
+
+            out.sync();
+            auto view = make_host_view(out);
+            for (int i = 0; i < 11; ++i)
+                for (int j = 0; j < 12; ++j)
+                    for (int k = 0; k < 13; ++k)
+                        EXPECT_EQ(3 * (i + 2 * j + 3 * k), view(i, j, k));
+        }
+    } // namespace
+} // namespace gridtools
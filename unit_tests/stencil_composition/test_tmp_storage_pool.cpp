@@ -0,0 +1,151 @@
+/*
+ * GridTools
+ *
+ * Copyright (c) 2014-2019, ETH Zurich
+ * All rights reserved.
+ *
+ * Please, refer to the LICENSE file in the root directory.
+ * SPDX-License-Identifier: BSD-3-Clause
+ */
+
+#include <gridtools/stencil_composition/tmp_storage_pool.hpp>
+
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <gridtools/stencil_composition/stencil_composition.hpp>
+#include <gridtools/storage/storage_facility.hpp>
+#include <gridtools/tools/backend_select.hpp>
+
+namespace gridtools {
+    namespace {
+        struct dummy_backend {};
+
+        using testee_t = tmp_storage_pool<dummy_backend>;
+
+        TEST(tmp_storage_pool, reuse) {
+            auto &testee = testee_t::instance();
+            testee.release();
+            void *ptr;
+            {
+                auto buf = testee.check_out(100);
+                ptr = buf.get();
+                EXPECT_EQ(100, buf.size());
+                EXPECT_EQ(100, testee.allocated_bytes());
+            }
+            {
+                // best fit
+                auto small = testee.check_out(60);
+                auto large = testee.check_out(80);
+                EXPECT_EQ(ptr, small.get());
+                EXPECT_EQ(180, testee.allocated_bytes());
+            }
+            {
+                auto buf = testee.check_out(70);
+                EXPECT_EQ(80, buf.size());
+            }
+            testee.release();
+            EXPECT_EQ(0, testee.allocated_bytes());
+        }
+
+        TEST(tmp_storage_pool, grow) {
+            auto &testee = testee_t::instance();
+            testee.release();
+            { auto buf = testee.check_out(100); }
+            {
+                // the idle buffer that is too small is replaced
+                auto buf = testee.check_out(200);
+                EXPECT_EQ(200, testee.allocated_bytes());
+            }
+            testee.release();
+        }
+
+        struct copy_functor {
+            using in = in_accessor<0>;
+            using out = inout_accessor<1>;
+            using param_list = make_param_list<in, out>;
+
+            template <typename Evaluation>
+            GT_FUNCTION static void apply(Evaluation eval) {
+                eval(out()) = eval(in());
+            }
+        };
+
+        using storage_info_t = storage_traits<backend_t>::storage_info_t<0, 3>;
+        using data_store_t = storage_traits<backend_t>::data_store_t<float_type, storage_info_t>;
+
+        using p_in = arg<0, data_store_t>;
+        using p_out = arg<1, data_store_t>;
+        using p_tmp1 = tmp_arg<2, data_store_t>;
+        using p_tmp2 = tmp_arg<3, data_store_t>;
+
+        TEST(tmp_storage_pool, cached_data_stores) {
+            using buffers_t = std::vector<tmp_storage_pool<backend_t>::handle>;
+            auto make = [](storage_info_t const &info, buffers_t &buffers) {
+                return make_pooled_data_store<backend_t, data_store_t>(info, buffers).get_storage_ptr();
+            };
+            auto &pool = tmp_storage_pool<backend_t>::instance();
+            pool.release();
+
+            storage_info_t info(11, 12, 13);
+            std::shared_ptr<data_store_t::storage_t> storage;
+            {
+                buffers_t buffers;
+                storage = make(info, buffers);
+            }
+            {
+                // the data store wrapping the buffer is reused
+                buffers_t buffers;
+                EXPECT_EQ(storage, make(info, buffers));
+            }
+            {
+                // unless the storage info differs
+                buffers_t buffers;
+                storage_info_t other(11, 12, 7);
+                EXPECT_NE(storage, make(other, buffers));
+            }
+            pool.release();
+        }
+
+        TEST(tmp_storage_pool, shared_by_computations) {
+            auto &pool = tmp_storage_pool<backend_t>::instance();
+            pool.release();
+
+            storage_info_t info(11, 12, 13);
+            data_store_t in(info, [](int i, int j, int k) { return i + 2 * j + 3 * k; });
+            data_store_t out(info, -1.);
+            auto grid = make_grid(11, 12, 13);
+
+            auto comp1 = make_computation<backend_t>(grid,
+                p_in() = in,
+                p_out() = out,
+                make_multistage(execute::forward(),
+                    make_stage<copy_functor>(p_in(), p_tmp1()),
+                    make_stage<copy_functor>(p_tmp1(), p_out())));
+            auto comp2 = make_computation<backend_t>(grid,
+                p_in() = in,
+                p_out() = out,
+                make_multistage(execute::forward(),
+                    make_stage<copy_functor>(p_in(), p_tmp1()),
+                    make_stage<copy_functor>(p_tmp1(), p_tmp2()),
+                    make_stage<copy_functor>(p_tmp2(), p_out())));
+            EXPECT_EQ(0, pool.allocated_bytes());
+
+            comp2.run();
+            auto allocated = pool.allocated_bytes();
+            EXPECT_GT(allocated, 0);
+            comp1.run();
+            comp2.run();
+            EXPECT_EQ(allocated, pool.allocated_bytes());
+
+            out.sync();
+            auto view = make_host_view(out);
+            for (int i = 0; i < 11; ++i)
+                for (int j = 0; j < 12; ++j)
+                    for (int k = 0; k < 13; ++k)
+                        EXPECT_EQ(i + 2 * j + 3 * k, view(i, j, k));
+        }
+    } // namespace
+} // namespace gridtools
@@ -10,10 +10,13 @@
 
 #include "gtest/gtest.h"
 
+#include <cstdio>
+
 #include <gridtools/common/gt_assert.hpp>
 #include <gridtools/storage/common/storage_info.hpp>
 #include <gridtools/storage/data_store.hpp>
 #include <gridtools/storage/storage_host/host_storage.hpp>
+#include <gridtools/storage/storage_mc/mc_storage.hpp>
 
 using namespace gridtools;
 
@@ -190,3 +193,69 @@ TEST(DataStoreTest, ExternalPointer) {
     // delete the ptr
     delete[] external_ptr;
 }
+
+template <class Storage>
+void test_file_backed() {
+    std::string path = "test_data_store_file_backed.dat";
+    storage_info_halo_aligned_t si(7, 5, 3);
+    {
+        data_store<Storage, storage_info_halo_aligned_t> ds(si, path, file_mode::create);
+        auto *ptr = ds.get_storage_ptr()->get_cpu_ptr();
+        // same alignment of the inner region as for allocated storages
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(ptr + si.index(2, 1, 0)) % (16 * sizeof(double)), 0);
+        for (uint_t i = 0; i < 7; ++i)
+            for (uint_t j = 0; j < 5; ++j)
+                for (uint_t k = 0; k < 3; ++k) {
+                    EXPECT_EQ(ptr[si.index(i, j, k)], 0);
+                    ptr[si.index(i, j, k)] = i + j + k;
+                }
+        ds.sync_file();
+    }
+    {
+        data_store<Storage, storage_info_halo_aligned_t> ds(si, path, file_mode::open);
+        auto *ptr = ds.get_storage_ptr()->get_cpu_ptr();
+        for (uint_t i = 0; i < 7; ++i)
+            for (uint_t j = 0; j < 5; ++j)
+                for (uint_t k = 0; k < 3; ++k)
+                    EXPECT_EQ(ptr[si.index(i, j, k)], i + j + k);
+    }
+    // the file does not fit a different storage info
+    EXPECT_THROW((data_store<Storage, storage_info_halo_aligned_t>(
+                     storage_info_halo_aligned_t(8, 5, 3), path, file_mode::open)),
+        std::runtime_error);
+    std::remove(path.c_str());
+    EXPECT_THROW((data_store<Storage, storage_info_halo_aligned_t>(si, path, file_mode::open)), std::runtime_error);
+}
+
+TEST(DataStoreTest, FileBacked) {
+    test_file_backed<host_storage<double>>();
+    test_file_backed<mc_storage<double>>();
+}
+
+TEST(DataStoreTest, FileBackedExchange) {
+    std::string path = "test_data_store_file_backed_exchange.dat";
+    storage_info_halo_aligned_t si(7, 5, 3);
+    {
+        data_store<host_storage<double>, storage_info_halo_aligned_t> ds(si, path, file_mode::create);
+        ds.get_storage_ptr()->get_cpu_ptr()[si.index(6, 4, 2)] = 42;
+        ds.sync_file();
+    }
+    {
+        // the file of a host storage fits the mc storage
+        data_store<mc_storage<double>, storage_info_halo_aligned_t> ds(si, path, file_mode::open);
+        EXPECT_EQ(ds.get_storage_ptr()->get_cpu_ptr()[si.index(6, 4, 2)], 42);
+    }
+    std::remove(path.c_str());
+}
+
+TEST(DataStoreTest, FileBackedEmpty) {
+    std::string path = "test_data_store_file_backed_empty.dat";
+    // the halo covers the whole storage
+    data_store<host_storage<double>, storage_info_halo_aligned_t> ds(
+        storage_info_halo_aligned_t(4, 5, 3), path, file_mode::create);
+    EXPECT_FALSE(ds.valid());
+    // no file is created
+    EXPECT_THROW((data_store<host_storage<double>, storage_info_halo_aligned_t>(
+                     storage_info_halo_aligned_t(7, 5, 3), path, file_mode::open)),
+        std::runtime_error);
+}
@@ -12,6 +12,7 @@
 
 #include <gridtools/common/gt_assert.hpp>
 #include <gridtools/storage/storage_host/host_storage.hpp>
+#include <gridtools/storage/storage_mc/mc_storage.hpp>
 
 TEST(StorageHostTest, Simple) {
     // create two storages
@@ -57,3 +58,16 @@ TEST(StorageHostTest, InitializedStorage) {
     EXPECT_EQ(s2.get_cpu_ptr()[0], 5);
     EXPECT_EQ(s2.get_cpu_ptr()[1], 20);
 }
+
+TEST(StorageMcTest, DedicatedMappings) {
+    auto requested = [] { return gridtools::default_hugepage_arena().stats().requested; };
+    auto before = requested();
+    // small storages share the slabs of the arena
+    gridtools::mc_storage<double> small(16);
+    EXPECT_GT(requested(), before);
+    // storages of a huge page or more get their own mapping, first-touched anew
+    before = requested();
+    gridtools::mc_storage<double> large(2 * 1024 * 1024 / sizeof(double), [](int i) { return i; });
+    EXPECT_EQ(requested(), before);
+    EXPECT_EQ(large.get_cpu_ptr()[42], 42);
+}